@@ -4,30 +4,13 @@
 #include <stdint.h>
 #include <ctype.h>
 #include <math.h>
-#include "xil_io.h"
-#include "xparameters.h"
 #include "sleep.h"
 #include <float.h>
-
-/* === 하드웨어 베이스 주소 (플랫폼에 맞게 수정) === */
-#ifndef MOTOR_CTRL_BASE
-#define MOTOR_CTRL_BASE XPAR_PID_CONTROLLER_INTER_0_BASEADDR
-#endif
-
-/* === 레지스터 오프셋 (32-bit) === */
-#define REG_A0          0x00  // a0 (=c0)
-#define REG_C1          0x04  // c1
-#define REG_C2          0x08  // c2
-#define REG_C3          0x0C  // c3
-#define REG_C4          0x10  // c4
-#define REG_C5          0x14  // c5
-#define REG_C6          0x18  // c6
-#define REG_C7          0x1C  // c7a (AW tap1)
-#define REG_C8          0x20  // c7b (AW tap2)
-#define REG_YSAT        0x24  // voltage saturation (e.g., 12.0 V)
-#define REG_RECIP_YSAT  0x28  // 1/YSAT
-#define REG_W_TARGET    0x2C  // target speed [rad/s]
-#define REG_STATUS13    0x30  // measured spdcnt/status (RO) — 하위 16비트 spdcnt
+#include "mc_prof.h"   /* -DMC_PROF 로 계측 활성 */
+#include "mc_stats.h"
+#include "mc_regs.h"   /* 레지스터 맵 + MMIO */
+#include "mc_swpid.h"  /* PS 소프트웨어 제어 경로 */
+#include "mc_pidstate.h" /* FPGA PID 이력 저장/복원 (warm restart) */
 
 /* === 인코더/게이트 설정: 보드와 동일하게 맞추세요 === */
 #define CPR_QUAD   1336          /* 쿼드(4x) 기준 rev당 카운트 */
@@ -36,12 +19,19 @@
 /* === 파생 상수 === */
 #define TWO_PI     (6.28318530717958647692)
 #define Ts_sec     (1.0/(double)(GATE_HZ))
-#define GATE_US    ((unsigned)(Ts_sec*1e6))  /* 게이트 시간(마이크로초) */
+#define GATE_US    ((unsigned)(Ts_sec*1e6))  /* 게이트 시간(마이크로초), gate_seq 대기 한도 기준 */
 
 /* spdcnt → 물리량 환산 (게이트/해상도에 종속, 자동 계산) */
 #define SPDC_TO_RADPS_FACTOR  ((float)(TWO_PI * (double)GATE_HZ / (double)CPR_QUAD))  /* rad/s per count */
 #define SPDC_TO_RPM_FACTOR    ((float)(60.0       * (double)GATE_HZ / (double)CPR_QUAD)) /* RPM per count */
 
+/* === 모니터링 === */
+#define MON_GATES        15000   /* 모니터링 게이트 수                       */
+#define MON_STATS_PERIOD 1000    /* 이 게이트마다 통계 한 줄 (0 = 끝에서만)     */
+#define MON_SETTLE_BAND  0.02f   /* 정착 밴드 (목표 대비)                     */
+#define MON_SETTLE_HOLD  20      /* 정착 판정 연속 게이트                      */
+/* -DMC_TELEMETRY_ECHO : 기존처럼 매 샘플 출력 (UART 대역 주의) */
+
 /* 출력 포화값 */
 #define YSAT_VOLT     (12.0f)
 #define RE_YSAT_VOLT  (1.0f/12.0f)
@@ -140,10 +130,90 @@ static void compute_coeffs(double Kp, double Ki, double Kd,
     *c7a = (float)C7A; *c7b = (float)C7B;
 }
 
+/* FPGA 계수 합성: 게인 쓰기 → 시작 → 활성 뱅크 커밋 대기 → 읽기
+   (Ts 는 FP32 로 전달, 결과는 compute_coeffs 와 수 ulp 차이 가능)
+   반환 0 = 성공, -1 = 입력 오류(Kp/N/Ts ≤ 0), -2 = 시간 초과 */
+#define SYNTH_POLL_MAX  100000
+
+static int synth_coeffs_fpga(double Kp, double Ki, double Kd,
+                             double N, double b, double c, double Kb,
+                             float k[9])
+{
+    const uint16_t commits = SYNTH_COMMITS(mc_rd32(REG_SYNTH));
+    uint32_t st = 0;
+    int i;
+
+    mc_wr32(REG_KP, f2u((float)Kp));  mc_wr32(REG_KI, f2u((float)Ki));
+    mc_wr32(REG_KD, f2u((float)Kd));  mc_wr32(REG_N,  f2u((float)N));
+    mc_wr32(REG_B,  f2u((float)b));   mc_wr32(REG_C,  f2u((float)c));
+    mc_wr32(REG_KB, f2u((float)Kb));  mc_wr32(REG_TS, f2u((float)Ts_sec));
+    mc_wr32(REG_SYNTH, 1);
+
+    for (i = 0; i < SYNTH_POLL_MAX; i++) {
+        st = mc_rd32(REG_SYNTH);
+        if (st & (SYNTH_BUSY | SYNTH_PENDING)) continue;
+        if (st & SYNTH_ERR) return -1;
+        if (SYNTH_COMMITS(st) != commits) break;
+    }
+    if (i == SYNTH_POLL_MAX) return -2;
+
+    for (i = 0; i < 9; i++) k[i] = u2f(mc_rd32(REG_SYNTH_K(i)));
+    return 0;
+}
+
 /* RPM ↔ rad/s */
 static inline float rpm_to_radps(float rpm){ return rpm * (float)(TWO_PI/60.0); }
 
-static inline void wr_f32(uint32_t off, float v){ Xil_Out32(MOTOR_CTRL_BASE + off, f2u(v)); }
+static inline void wr_f32(uint32_t off, float v){ mc_wr32(off, f2u(v)); }
+
+/* 실시간 모니터링: gate_seq 가 바뀔 때마다 한 샘플 (mc_swpid_step 과 같은 폴링)
+   - usleep 으로 맞추면 스케줄러 지터에 샘플이 중복/누락되어 게이트 축이 어긋남
+   - 출력 등으로 게이트를 놓치면 mc_stats_skip 으로 시간만 진행
+   - MC_SWPID_WAIT_GATES 게이트 동안 gate_seq 가 그대로면 중단 (멈춘 게이트/이전 비트스트림)
+   (y 레지스터가 없으므로 포화 비율은 n/a) */
+static void monitor_fpga(float w_target, float ysat)
+{
+    mc_stats_t st;
+    mc_stats_init(&st, w_target, ysat, MON_SETTLE_BAND, MON_SETTLE_HOLD);
+
+    uint16_t seq = STATUS13_SEQ(mc_rd32(REG_STATUS13));
+    for (int i=0;i<MON_GATES;){
+        uint32_t raw;
+        uint16_t now, adv;
+        if (mc_swpid_wait_gate(seq, MC_SWPID_WAIT_GATES * GATE_US, &raw) != MC_SWPID_OK) {
+            printf("gate_seq not advancing (gate %d) → 모니터링 중단\r\n", i);
+            break;
+        }
+        now = STATUS13_SEQ(raw);
+        adv = (uint16_t)(now - seq);
+        seq = now;
+        {
+            MC_PROF_SCOPE(MC_PROF_TELEMETRY);
+            int16_t  sp  = STATUS13_SPDCNT(raw);
+            if (adv > 1) mc_stats_skip(&st, adv - 1u);
+            mc_stats_feed(&st, (float)sp * SPDC_TO_RADPS_FACTOR, NAN);
+#ifdef MC_TELEMETRY_ECHO
+            double   rpm = (double)sp * SPDC_TO_RPM_FACTOR;
+            printf("reg13=0x%08lX  spdcnt=%d  RPM=%.2f\r\n",
+                   (unsigned long)raw, (int)sp, rpm);
+#endif
+        }
+#ifndef MC_TELEMETRY_ECHO
+        if (MON_STATS_PERIOD && (i + adv) / MON_STATS_PERIOD != i / MON_STATS_PERIOD)
+            mc_stats_line(&st, Ts_sec);
+#endif
+        i += adv;
+    }
+    mc_stats_dump(&st, Ts_sec);
+
+    /* 종료 시점 PID 이력 저장 (제어는 계속) + PS 메모리 보관. 비트스트림/앱 재적재 후
+       시작 메뉴의 warm restart 로 이어서 돌리면 리셋 과도 없음 */
+    {
+        mc_pidstate_t ps;
+        if (mc_pidstate_save(&ps, 0) == MC_PIDSTATE_OK) { mc_pidstate_store(&ps); mc_pidstate_dump(&ps); }
+        else printf("PID state save: freeze timeout\r\n");
+    }
+}
 
 int main(void)
 {
@@ -157,6 +227,23 @@ int main(void)
            (double)Ts_sec*1e3, CPR_QUAD,
            (double)SPDC_TO_RADPS_FACTOR, (double)SPDC_TO_RPM_FACTOR);
 
+    /* warm restart: 보관된 PID 상태 (계수/포화/목표/이력) 로 FPGA PID 를 이어서 돌림.
+       실패하면 새로 시작 (이후 REG_CTRL 쓰기가 정지도 풀어 줌) */
+    if (ask_double("Start (0=new, 1=warm restart from saved PID state): ") >= 0.5) {
+        mc_pidstate_t ps;
+        int r = mc_pidstate_load(&ps);
+        if (r == MC_PIDSTATE_OK) r = mc_pidstate_restore(&ps);
+        if (r == MC_PIDSTATE_OK) {
+            printf("PID state restored (crc=0x%08lX), W_target=%f\r\n", (unsigned long)ps.crc, u2f(ps.w_target));
+            monitor_fpga(u2f(ps.w_target), u2f(ps.ysat));
+            mc_prof_dump();
+            return 0;
+        }
+        printf("warm restart 실패 (%s) → 새로 시작\r\n",
+               r == MC_PIDSTATE_BAD_BLOB ? "보관본 없음/손상" :
+               r == MC_PIDSTATE_TIMEOUT  ? "freeze timeout" : "이력 확인 불일치");
+    }
+
     /* 파라미터 입력 */
     Kp  = ask_double("Kp: ");
     Ki  = ask_double("Ki: ");
@@ -166,11 +253,31 @@ int main(void)
     c   = ask_double("c (D setpoint weight): ");
     Kb  = ask_double("Kb (anti-windup 1/s): ");
     rpm_target = ask_double("Target RPM: ");
+    const int sw_path = ask_double("Controller (0=FPGA PID, 1=PS software): ") >= 0.5;
+    int fpga_synth = ask_double("Coefficients (0=PS compute, 1=FPGA synth): ") >= 0.5;
 
     /* 계수 계산 */
     float a0, c1, c2, c3, c4, c5, c6, c7a, c7b;
-    compute_coeffs(Kp, Ki, Kd, N, b, c, Kb,
-                   &a0,&c1,&c2,&c3,&c4,&c5,&c6,&c7a,&c7b);
+    {
+        MC_PROF_SCOPE(MC_PROF_COEFFS);
+        compute_coeffs(Kp, Ki, Kd, N, b, c, Kb,
+                       &a0,&c1,&c2,&c3,&c4,&c5,&c6,&c7a,&c7b);
+    }
+    if (fpga_synth) {
+        float k[9];
+        const int r = synth_coeffs_fpga(Kp, Ki, Kd, N, b, c, Kb, k);
+        if (r == 0) {
+            const float ps[9] = { a0, c1, c2, c3, c4, c5, c6, c7a, c7b };
+            float dmax = 0.0f;
+            for (int i = 0; i < 9; i++) dmax = fmaxf(dmax, fabsf(k[i] - ps[i]));
+            printf("FPGA synth: max |Δ| vs PS compute = %g\r\n", dmax);
+            a0 = k[0]; c1 = k[1]; c2 = k[2]; c3 = k[3]; c4 = k[4];
+            c5 = k[5]; c6 = k[6]; c7a = k[7]; c7b = k[8];
+        } else {
+            printf("FPGA synth 실패 (%s) → PS 계산 계수 사용\r\n", r == -1 ? "Kp/N/Ts ≤ 0" : "timeout");
+            fpga_synth = 0;
+        }
+    }
 
     const float w_target = rpm_to_radps((float)rpm_target);
 
@@ -183,32 +290,56 @@ int main(void)
     usleep(100000);
 
     /* 하드웨어로 전송 */
-    wr_f32(REG_A0,  a0);
-    wr_f32(REG_C1,  c1);
-    wr_f32(REG_C2,  c2);
-    wr_f32(REG_C3,  c3);
-    wr_f32(REG_C4,  c4);
-    wr_f32(REG_C5,  c5);
-    wr_f32(REG_C6,  c6);
-    wr_f32(REG_C7,  c7a);   /* ★ tap1 */
-    wr_f32(REG_C8,  c7b);   /* ★ tap2 */
-
-    wr_f32(REG_YSAT,       YSAT_VOLT);
-    wr_f32(REG_RECIP_YSAT, RE_YSAT_VOLT);
-    wr_f32(REG_W_TARGET,   w_target);
-
-    uint32_t raw_T = Xil_In32(MOTOR_CTRL_BASE + REG_W_TARGET);
+    {
+        MC_PROF_SCOPE(MC_PROF_UPLOAD);
+        wr_f32(REG_A0,  a0);
+        wr_f32(REG_C1,  c1);
+        wr_f32(REG_C2,  c2);
+        wr_f32(REG_C3,  c3);
+        wr_f32(REG_C4,  c4);
+        wr_f32(REG_C5,  c5);
+        wr_f32(REG_C6,  c6);
+        wr_f32(REG_C7,  c7a);   /* ★ tap1 */
+        wr_f32(REG_C8,  c7b);   /* ★ tap2 */
+
+        wr_f32(REG_YSAT,       YSAT_VOLT);
+        wr_f32(REG_RECIP_YSAT, RE_YSAT_VOLT);
+        wr_f32(REG_W_TARGET,   w_target);
+        /* FPGA PID 경로 (PS 경로는 mc_swpid_start 에서). 합성 계수면 활성 뱅크 선택
+           (REG_A0.. 에도 같은 값을 써 두어 어느 쪽이든 동일) */
+        mc_wr32(REG_CTRL, fpga_synth ? CTRL_COEF_SYNTH : 0);
+    }
+
+    uint32_t raw_T = mc_rd32(REG_W_TARGET);
     printf("W_target readback: %f\r\n", u2f(raw_T));
 
     
 
-    /* 실시간 모니터링 (spdcnt → RPM) */
-    for (int i=0;i<15000;i++){
-        uint32_t raw = Xil_In32(MOTOR_CTRL_BASE + REG_STATUS13);
-        int16_t  sp  = (int16_t)(raw & 0xFFFF);
-        double   rpm = (double)sp * SPDC_TO_RPM_FACTOR;
-        printf("reg13=0x%08lX  spdcnt=%d  RPM=%.2f\r\n",
-               (unsigned long)raw, (int)sp, rpm);
+    if (sw_path) {
+        /* PS 경로: 같은 Δ-form 커널을 PS 에서 돌려 REG_Y_SW 로 직접 구동
+           (게이트 대기는 gate_seq 폴링이므로 usleep 불필요) */
+        const float k[9] = { a0, c1, c2, c3, c4, c5, c6, c7a, c7b };
+        mc_stats_t st;
+        mc_stats_init(&st, w_target, YSAT_VOLT, MON_SETTLE_BAND, MON_SETTLE_HOLD);
+        mc_swpid_t sw;
+        mc_swpid_sample_t smp;
+        mc_swpid_start(&sw, k, YSAT_VOLT, w_target, GATE_US);
+        for (int i=0;i<MON_GATES;i++){
+            if (mc_swpid_step(&sw, &smp) != MC_SWPID_OK) {
+                printf("gate_seq not advancing (gate %d) → PS 경로 중단\r\n", i);
+                break;
+            }
+            mc_stats_feed(&st, (float)smp.spdcnt * SPDC_TO_RADPS_FACTOR, smp.y);
+            if (MON_STATS_PERIOD && (i + 1) % MON_STATS_PERIOD == 0) mc_stats_line(&st, Ts_sec);
+        }
+        mc_swpid_stop(&sw);
+        mc_swpid_dump(&sw);
+        mc_stats_dump(&st, Ts_sec);
+        mc_prof_dump();
+        return 0;
     }
+
+    monitor_fpga(w_target, YSAT_VOLT);
+    mc_prof_dump();
     /* return 0; */
 }
@@ -0,0 +1,87 @@
+/********************  mc_delta_pid.h  ********************/
+#ifndef MC_DELTA_PID_H
+#define MC_DELTA_PID_H
+
+#include <stdint.h>
+#include <string.h>
+
+/* === Δ-form PID (2-tap AW) 커널 — C++ DeltaPid2TapAw 와 같은 연산 순서 ===
+ *  - dy = c0·dy1 + c1·w + c2·w1 + c3·w2 + c4·x + c5·x1 + c6·x2
+ *         + c7a·e_sat1 + c7b·e_sat2      (곱 → 누산, 매 단계 FP32 라운딩)
+ *    y_unsat = y_unsat1 + dy,  y = clamp(y_unsat, ±ysat)
+ *  - 곱/합을 따로 라운딩하는 C++ 모델 (RoundVolatile/RoundNative) 과 비트 동일이 목표.
+ *    RTL MAC 은 융합 FMA IP (floating_point_0, a·b+c 한 번 라운딩) 라서 FPGA 경로와는
+ *    마지막 ulp 가 다를 수 있음
+ *  - 컴파일러가 a·b+c 를 FMA 로 합치면 (gnu99 기본값, ARM VFPv4/NEON, x86 -mfma)
+ *    C++ 모델과도 달라지므로 곱은 volatile 임시값에 저장해 FP32 로 확정한 뒤 더한다
+ *    (RoundVolatile::mul 과 같은 방식. 빌드 옵션과 무관하고 호출부에 그대로 인라인됨)
+ *  - x 변환도 RTL 과 같게: x = (float)spdcnt · INT_TO_RADS_FACTOR (0x3F70CAF0)
+ *  - 헤더 전용 (드라이버와 호스트 비교 프로그램이 같은 코드를 씀) */
+
+#define MC_INT2RADS_HEX  0x3F70CAF0u            /* pid_top INT_TO_RADS_FACTOR */
+
+typedef struct {
+    float c[9];                                 /* c0 c1 c2 c3 c4 c5 c6 c7a c7b */
+    float ysat;
+    float dy1;
+    float w1, w2;
+    float x1, x2;
+    float y_unsat_1, y_unsat_2;
+    float y_sat_1,   y_sat_2;
+} mc_delta_pid_t;
+
+static inline float mc_u2f(uint32_t u) { float f; memcpy(&f, &u, 4); return f; }
+
+/* 곱 라운딩 확정 (뒤 덧셈과 FMA 로 합쳐지지 않음) */
+static inline float mc_mul_rn(float a, float b) { volatile float r = a * b; return r; }
+
+static inline void mc_delta_pid_reset(mc_delta_pid_t *p)
+{
+    p->dy1 = 0.0f;
+    p->w1 = p->w2 = 0.0f;
+    p->x1 = p->x2 = 0.0f;
+    p->y_unsat_1 = p->y_unsat_2 = 0.0f;
+    p->y_sat_1   = p->y_sat_2   = 0.0f;
+}
+
+static inline void mc_delta_pid_init(mc_delta_pid_t *p, const float c[9], float ysat)
+{
+    memcpy(p->c, c, sizeof(p->c));
+    p->ysat = ysat;
+    mc_delta_pid_reset(p);
+}
+
+static inline float mc_spdcnt_to_x(int16_t spdcnt)
+{
+    return (float)spdcnt * mc_u2f(MC_INT2RADS_HEX);
+}
+
+static inline float mc_delta_pid_step(mc_delta_pid_t *p, float w, float x)
+{
+    const float *c = p->c;
+    const float e_sat_1 = p->y_sat_1 - p->y_unsat_1;
+    const float e_sat_2 = p->y_sat_2 - p->y_unsat_2;
+    float acc = 0.0f, y_unsat, y_sat;
+
+    acc = acc + mc_mul_rn(c[0], p->dy1);
+    acc = acc + mc_mul_rn(c[1], w);
+    acc = acc + mc_mul_rn(c[2], p->w1);
+    acc = acc + mc_mul_rn(c[3], p->w2);
+    acc = acc + mc_mul_rn(c[4], x);
+    acc = acc + mc_mul_rn(c[5], p->x1);
+    acc = acc + mc_mul_rn(c[6], p->x2);
+    acc = acc + mc_mul_rn(c[7], e_sat_1);
+    acc = acc + mc_mul_rn(c[8], e_sat_2);
+
+    y_unsat = p->y_unsat_1 + acc;
+    y_sat   = (y_unsat < -p->ysat) ? -p->ysat : (p->ysat < y_unsat) ? p->ysat : y_unsat;
+
+    p->dy1 = acc;
+    p->w2 = p->w1;  p->w1 = w;
+    p->x2 = p->x1;  p->x1 = x;
+    p->y_unsat_2 = p->y_unsat_1;  p->y_unsat_1 = y_unsat;
+    p->y_sat_2   = p->y_sat_1;    p->y_sat_1   = y_sat;
+    return y_sat;
+}
+
+#endif /* MC_DELTA_PID_H */
@@ -0,0 +1,148 @@
+/********************  mc_pidstate.c  ********************/
+#include "mc_pidstate.h"
+
+#include <stdio.h>
+#include <stddef.h>
+#include <string.h>
+
+#ifdef MC_HOST
+static mc_pidstate_t store_;
+#define MC_PIDSTATE_STORE  (&store_)
+#else
+#include "xil_cache.h"
+#define MC_PIDSTATE_STORE  ((mc_pidstate_t *)(UINTPTR)MC_PIDSTATE_STORE_ADDR)
+#endif
+
+static const uint32_t COEF_REGS[9] = {
+    REG_A0, REG_C1, REG_C2, REG_C3, REG_C4, REG_C5, REG_C6, REG_C7, REG_C8
+};
+
+static uint32_t crc32_(const void *p, size_t n)
+{
+    const uint8_t *b = (const uint8_t *)p;
+    uint32_t c = 0xFFFFFFFFu;
+    int k;
+    while (n--) {
+        c ^= *b++;
+        for (k = 0; k < 8; k++) c = (c >> 1) ^ (0xEDB88320u & (0u - (c & 1u)));
+    }
+    return ~c;
+}
+
+static uint32_t blob_crc_(const mc_pidstate_t *s)
+{
+    return crc32_(s, offsetof(mc_pidstate_t, crc));
+}
+
+int mc_pid_freeze(void)
+{
+    int i;
+    mc_wr32(REG_CTRL, mc_rd32(REG_CTRL) | CTRL_FREEZE);
+    for (i = 0; i < MC_PIDSTATE_POLL_MAX; i++)
+        if (mc_rd32(REG_PID_STATUS) & PID_STATUS_FROZEN) return MC_PIDSTATE_OK;
+    return MC_PIDSTATE_TIMEOUT;
+}
+
+void mc_pid_resume(void)
+{
+    mc_wr32(REG_CTRL, mc_rd32(REG_CTRL) & ~CTRL_FREEZE);
+}
+
+int mc_pidstate_save(mc_pidstate_t *s, int keep_frozen)
+{
+    uint32_t ctrl;
+    int i;
+    memset(s, 0, sizeof(*s));
+    if (mc_pid_freeze() != MC_PIDSTATE_OK) { mc_pid_resume(); return MC_PIDSTATE_TIMEOUT; }
+
+    /* 합성 계수 사용 중이면 실제로 쓰이는 활성 뱅크를 저장 (REG_A0.. 와 다를 수 있음) */
+    ctrl = mc_rd32(REG_CTRL);
+    s->magic = MC_PIDSTATE_MAGIC;
+    for (i = 0; i < MC_HIST_WORDS; i++) s->hist[i] = mc_rd32(REG_HIST(i));
+    for (i = 0; i < 9; i++)
+        s->coef[i] = mc_rd32((ctrl & CTRL_COEF_SYNTH) ? REG_SYNTH_K(i) : COEF_REGS[i]);
+    s->ysat       = mc_rd32(REG_YSAT);
+    s->recip_ysat = mc_rd32(REG_RECIP_YSAT);
+    s->w_target   = mc_rd32(REG_W_TARGET);
+    s->y_man      = mc_rd32(REG_Y_MAN);
+    s->ctrl       = ctrl & ~(CTRL_SW_MODE | CTRL_FREEZE | CTRL_COEF_SYNTH);    /* FPGA PID 경로로 재개 */
+    s->crc        = blob_crc_(s);
+
+    if (!keep_frozen) mc_pid_resume();
+    return MC_PIDSTATE_OK;
+}
+
+int mc_pidstate_restore(const mc_pidstate_t *s)
+{
+    int i, bad = 0;
+    if (s->magic != MC_PIDSTATE_MAGIC || s->crc != blob_crc_(s)) return MC_PIDSTATE_BAD_BLOB;
+    if (mc_pid_freeze() != MC_PIDSTATE_OK) return MC_PIDSTATE_TIMEOUT;    /* 정지 유지 */
+
+    for (i = 0; i < 9; i++) mc_wr32(COEF_REGS[i], s->coef[i]);
+    mc_wr32(REG_YSAT,       s->ysat);
+    mc_wr32(REG_RECIP_YSAT, s->recip_ysat);
+    mc_wr32(REG_W_TARGET,   s->w_target);
+    mc_wr32(REG_Y_MAN,      s->y_man);
+    for (i = 0; i < MC_HIST_WORDS; i++) mc_wr32(REG_HIST(i), s->hist[i]);
+    for (i = 0; i < MC_HIST_WORDS; i++) bad += mc_rd32(REG_HIST(i)) != s->hist[i];
+    if (bad) return MC_PIDSTATE_VERIFY;                                   /* 정지 유지 */
+
+    /* 새 비트스트림의 활성 뱅크는 0 → 합성 계수 대신 방금 쓴 REG_A0.. 사용.
+       이력은 FPGA PID 것이므로 PS 경로 (SW_MODE) 로는 재개하지 않음 */
+    mc_wr32(REG_CTRL, s->ctrl & ~(CTRL_SW_MODE | CTRL_FREEZE | CTRL_COEF_SYNTH));   /* FREEZE 해제 */
+    return MC_PIDSTATE_OK;
+}
+
+void mc_pidstate_store(const mc_pidstate_t *s)
+{
+    memcpy(MC_PIDSTATE_STORE, s, sizeof(*s));
+#ifndef MC_HOST
+    Xil_DCacheFlushRange((INTPTR)MC_PIDSTATE_STORE_ADDR, sizeof(*s));     /* 앱 재적재 전에 메모리로 */
+#endif
+}
+
+int mc_pidstate_load(mc_pidstate_t *s)
+{
+#ifndef MC_HOST
+    Xil_DCacheInvalidateRange((INTPTR)MC_PIDSTATE_STORE_ADDR, sizeof(*s));
+#endif
+    memcpy(s, MC_PIDSTATE_STORE, sizeof(*s));
+    if (s->magic != MC_PIDSTATE_MAGIC || s->crc != blob_crc_(s)) return MC_PIDSTATE_BAD_BLOB;
+    return MC_PIDSTATE_OK;
+}
+
+void mc_pid_manual(float y)
+{
+    uint32_t u;
+    memcpy(&u, &y, 4);
+    mc_wr32(REG_Y_MAN, u);
+    mc_wr32(REG_CTRL, mc_rd32(REG_CTRL) | CTRL_MANUAL);
+}
+
+int mc_pid_hold(void)
+{
+    if (mc_pid_freeze() != MC_PIDSTATE_OK) { mc_pid_resume(); return MC_PIDSTATE_TIMEOUT; }
+    mc_wr32(REG_Y_MAN, mc_rd32(REG_HIST(7)));                              /* y_sat[n-1] */
+    mc_wr32(REG_CTRL, (mc_rd32(REG_CTRL) | CTRL_MANUAL) & ~CTRL_FREEZE);
+    return MC_PIDSTATE_OK;
+}
+
+void mc_pid_auto(void)
+{
+    mc_wr32(REG_CTRL, mc_rd32(REG_CTRL) & ~CTRL_MANUAL);
+}
+
+void mc_pidstate_dump(const mc_pidstate_t *s)
+{
+    static const char *names[MC_HIST_WORDS] = {
+        "dy[n-1]", "w[n-1]", "w[n-2]", "x[n-1]", "x[n-2]",
+        "y_unsat[n-1]", "y_unsat[n-2]", "y_sat[n-1]", "y_sat[n-2]"
+    };
+    int i;
+    printf("\r\n--- PID state (warm restart blob, crc=0x%08lX) ---\r\n", (unsigned long)s->crc);
+    for (i = 0; i < MC_HIST_WORDS; i++) {
+        float f;
+        memcpy(&f, &s->hist[i], 4);
+        printf("%-13s 0x%08lX  %g\r\n", names[i], (unsigned long)s->hist[i], (double)f);
+    }
+}
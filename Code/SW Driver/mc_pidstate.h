@@ -0,0 +1,69 @@
+/********************  mc_pidstate.h  ********************/
+#ifndef MC_PIDSTATE_H
+#define MC_PIDSTATE_H
+
+#include <stdint.h>
+#include "mc_regs.h"
+
+/* === FPGA PID 상태 저장/복원 (warm restart, 새 비트스트림으로 이전) ===
+ *  - 저장: REG_CTRL.FREEZE → frozen(진행 중 게이트 완료) 대기 → 이력 9워드 +
+ *          계수/포화/목표 레지스터 읽기 → (keep_frozen 이 0 이면) 재개
+ *  - 복원: FREEZE → 계수/포화/목표 쓰기 → 이력 9워드 쓰기 → 읽어서 확인 → 재개
+ *  - 합성 계수 (CTRL_COEF_SYNTH) 사용 중 저장이면 활성 뱅크(REG_SYNTH_K)를 coef 로 저장하고
+ *    복원은 REG_A0.. 경로로 재개 (새 비트스트림의 활성 뱅크는 0, 게인 레지스터는 저장 안 함)
+ *          (리셋 직후 이력 0 으로 시작하는 과도 응답 대신 저장 시점부터 이어감)
+ *  - 워드 순서는 C++ DeltaPidState / snapshot() 과 같음 → 호스트 모델과 교환 가능
+ *  - 정지 중에는 PWM 이 마지막 전압을 유지 (게이트는 계속 흐름)
+ *  - 블롭은 PS 메모리에 두면 PL 재구성(비트스트림 재적재) 동안에도 유지됨 */
+
+/* === 블롭 보관 (mc_pidstate_store / _load) ===
+ *  - MC_PIDSTATE_STORE_ADDR 의 PS 메모리에 복사 (기본: OCM 0xFFFF0000, lscript.ld 에서
+ *    이 4 KB 를 빼 둘 것). 전원을 유지한 채 비트스트림/앱을 다시 올려도 남음
+ *  - 불러올 때 magic/crc 확인 → 전원 투입 직후의 임의 값은 BAD_BLOB
+ *  - -DMC_HOST: 정적 변수 */
+
+/* === 수동/자동 (REG_CTRL.MANUAL, REG_Y_MAN) ===
+ *  - 수동 중에도 Δy 는 계속 계산되고 y 이력은 실제 출력을 추종하므로
+ *    자동 복귀는 그냥 비트를 내리면 무충격 (y = y_man + Δy)
+ *  - hold: 정지 → y_sat[n-1] 읽기 → REG_Y_MAN → (MANUAL, 정지 해제) 한 번에 쓰기
+ *          → 게이트를 건너뛰지 않고 현재 출력 그대로 고정 */
+
+#define MC_PIDSTATE_MAGIC    0x50494453u          /* "PIDS" */
+#define MC_PIDSTATE_POLL_MAX 100000
+
+#ifndef MC_PIDSTATE_STORE_ADDR
+#define MC_PIDSTATE_STORE_ADDR 0xFFFF0000u
+#endif
+
+typedef struct {
+    uint32_t magic;
+    uint32_t hist[MC_HIST_WORDS];                 /* REG_HIST0..8 */
+    uint32_t coef[9];                             /* REG_A0..REG_C8 (합성 중이면 활성 뱅크) */
+    uint32_t ysat, recip_ysat, w_target, y_man;
+    uint32_t ctrl;                                /* MANUAL 만 (SW_MODE, FREEZE, COEF_SYNTH 제외) */
+    uint32_t crc;                                 /* 앞 필드 전체 CRC-32 */
+} mc_pidstate_t;
+
+enum {
+    MC_PIDSTATE_OK       =  0,
+    MC_PIDSTATE_TIMEOUT  = -1,                    /* frozen 이 안 됨 */
+    MC_PIDSTATE_BAD_BLOB = -2,                    /* magic/crc 불일치 */
+    MC_PIDSTATE_VERIFY   = -3                     /* 쓴 값이 읽히지 않음 */
+};
+
+int  mc_pid_freeze(void);                         /* FREEZE 후 frozen 대기 */
+void mc_pid_resume(void);
+
+int  mc_pidstate_save(mc_pidstate_t *s, int keep_frozen);
+int  mc_pidstate_restore(const mc_pidstate_t *s);
+
+void mc_pidstate_store(const mc_pidstate_t *s);  /* PS 메모리에 보관 */
+int  mc_pidstate_load(mc_pidstate_t *s);         /* 보관본 읽기 + 확인 (OK / BAD_BLOB) */
+
+void mc_pidstate_dump(const mc_pidstate_t *s);
+
+void mc_pid_manual(float y);                      /* Y_MAN 쓰고 MANUAL */
+int  mc_pid_hold(void);                           /* 현재 출력으로 MANUAL */
+void mc_pid_auto(void);                           /* MANUAL 해제 (무충격) */
+
+#endif /* MC_PIDSTATE_H */
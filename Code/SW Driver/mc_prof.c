@@ -0,0 +1,85 @@
+/********************  mc_prof.c  ********************/
+#include "mc_prof.h"
+
+#ifdef MC_PROF
+
+#include <stdio.h>
+
+#ifdef MC_HOST
+#include <time.h>
+#define MC_PROF_TICKS_PER_SEC  (1000000000.0)
+#else
+#include "xtime_l.h"
+#define MC_PROF_TICKS_PER_SEC  ((double)COUNTS_PER_SECOND)
+#endif
+
+#define MC_PROF_BUCKETS  32     /* bucket b : [2^b, 2^(b+1)) ticks */
+
+typedef struct {
+    uint32_t count;
+    uint64_t total;
+    uint64_t max;
+    uint32_t hist[MC_PROF_BUCKETS];
+} mc_prof_slot_t;
+
+static mc_prof_slot_t s_slot[MC_PROF_N];
+
+static const char *const s_name[MC_PROF_N] = {
+    "compute_coeffs",
+    "register_upload",
+    "telemetry_drain",
+};
+
+uint64_t mc_prof_now(void)
+{
+#ifdef MC_HOST
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+#else
+    XTime t;
+    XTime_GetTime(&t);
+    return (uint64_t)t;
+#endif
+}
+
+void mc_prof_record(int id, uint64_t ticks)
+{
+    mc_prof_slot_t *s = &s_slot[id];
+    int b = 0;
+    while (b < MC_PROF_BUCKETS - 1 && (ticks >> (b + 1)) != 0) b++;
+    s->count++;
+    s->total += ticks;
+    if (ticks > s->max) s->max = ticks;
+    s->hist[b]++;
+}
+
+/* 히스토그램 분위수 (버킷 기하 중앙값) */
+static double quantile(const mc_prof_slot_t *s, double q)
+{
+    const uint32_t target = (uint32_t)(q * (double)s->count);
+    uint32_t acc = 0;
+    for (int b = 0; b < MC_PROF_BUCKETS; b++) {
+        acc += s->hist[b];
+        if (acc > target) return (double)(1ull << b) * 1.41421356;
+    }
+    return 0.0;
+}
+
+void mc_prof_dump(void)
+{
+    const double us = 1e6 / MC_PROF_TICKS_PER_SEC;
+    printf("\r\n--- profile (us) ---\r\n");
+    printf("%-16s %10s %10s %10s %10s %10s\r\n", "probe", "calls", "mean", "p50", "p99", "max");
+    for (int i = 0; i < MC_PROF_N; i++) {
+        const mc_prof_slot_t *s = &s_slot[i];
+        if (s->count == 0) continue;
+        printf("%-16s %10lu %10.3f %10.3f %10.3f %10.3f\r\n", s_name[i],
+               (unsigned long)s->count,
+               (double)s->total / (double)s->count * us,
+               quantile(s, 0.50) * us, quantile(s, 0.99) * us,
+               (double)s->max * us);
+    }
+}
+
+#endif /* MC_PROF */
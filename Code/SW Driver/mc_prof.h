@@ -0,0 +1,43 @@
+/********************  mc_prof.h  ********************/
+#ifndef MC_PROF_H
+#define MC_PROF_H
+
+#include <stdint.h>
+
+/* === 드라이버 핫패스 계측 (스코프 타이머 + log2 히스토그램) ===
+ *  - -DMC_PROF 일 때만 활성. 아니면 MC_PROF_SCOPE/mc_prof_dump 는 사라짐
+ *  - 시계: 보드 = XTime_GetTime (전역 타이머), -DMC_HOST = clock_gettime
+ *  - bare-metal 단일 스레드 → 전역 배열에 직접 누적 (잠금 없음)
+ *  - 사용: { MC_PROF_SCOPE(MC_PROF_UPLOAD); ... }  (GCC cleanup 속성) */
+
+enum mc_prof_id {
+    MC_PROF_COEFFS = 0,     /* compute_coeffs            */
+    MC_PROF_UPLOAD,         /* 계수/포화/목표 레지스터 쓰기 */
+    MC_PROF_TELEMETRY,      /* REG_STATUS13 읽기 + 출력    */
+    MC_PROF_N
+};
+
+#ifdef MC_PROF
+
+typedef struct { int id; uint64_t t0; } mc_prof_scope_t;
+
+uint64_t mc_prof_now(void);
+void     mc_prof_record(int id, uint64_t ticks);
+void     mc_prof_dump(void);
+
+static inline void mc_prof_scope_end(mc_prof_scope_t *s)
+{
+    mc_prof_record(s->id, mc_prof_now() - s->t0);
+}
+
+#define MC_PROF_SCOPE(id) \
+    mc_prof_scope_t mc_prof_scope_##id __attribute__((cleanup(mc_prof_scope_end))) = { (id), mc_prof_now() }
+
+#else
+
+#define MC_PROF_SCOPE(id) ((void)0)
+#define mc_prof_dump()    ((void)0)
+
+#endif /* MC_PROF */
+
+#endif /* MC_PROF_H */
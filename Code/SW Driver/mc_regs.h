@@ -0,0 +1,91 @@
+/********************  mc_regs.h  ********************/
+#ifndef MC_REGS_H
+#define MC_REGS_H
+
+#include <stdint.h>
+
+/* === 레지스터 맵 + MMIO 접근 ===
+ *  - 보드: Xil_In32/Xil_Out32 (MOTOR_CTRL_BASE + off)
+ *  - -DMC_HOST: mc_host_rd32/mc_host_wr32 를 호출 (호스트 쪽 스탠드인이 구현) */
+
+/* === 레지스터 오프셋 (32-bit) === */
+#define REG_A0          0x00  // a0 (=c0)
+#define REG_C1          0x04  // c1
+#define REG_C2          0x08  // c2
+#define REG_C3          0x0C  // c3
+#define REG_C4          0x10  // c4
+#define REG_C5          0x14  // c5
+#define REG_C6          0x18  // c6
+#define REG_C7          0x1C  // c7a (AW tap1)
+#define REG_C8          0x20  // c7b (AW tap2)
+#define REG_YSAT        0x24  // voltage saturation (e.g., 12.0 V)
+#define REG_RECIP_YSAT  0x28  // 1/YSAT
+#define REG_W_TARGET    0x2C  // target speed [rad/s]
+#define REG_STATUS13    0x30  // (RO) {gate_seq[31:16], spdcnt[15:0]}
+#define REG_Y_SW        0x34  // PS 경로 전압 (FP32). 쓰기 = voltage_valid 스트로브
+#define REG_CTRL        0x38  // bit0 : 1 = PS 경로 (PWM ← REG_Y_SW), bit1 : 1 = 합성 계수 사용
+                              // bit2 : 1 = PID 정지 (새 게이트 무시, 이력 쓰기 허용)
+                              // bit3 : 1 = 수동 (출력 = clamp(REG_Y_MAN), 이력은 출력 추종)
+#define REG_Y_MAN       0x3C  // 수동 출력 전압 (FP32), 게이트마다 샘플
+
+/* 계수 합성 (coeff_synth.v): 물리 게인 (FP32) → c0..c7b */
+#define REG_KP          0x40
+#define REG_KI          0x44
+#define REG_KD          0x48
+#define REG_N           0x4C
+#define REG_B           0x50
+#define REG_C           0x54
+#define REG_KB          0x58
+#define REG_TS          0x5C
+#define REG_SYNTH       0x60  // W: 합성 시작 스트로브, R: {commit_cnt[31:16], err, pending, busy}
+#define REG_SYNTH_K0    0x64  // (RO) 합성 활성 뱅크 c0 .. +0x20 = c7b
+#define REG_SYNTH_K(i)  (REG_SYNTH_K0 + 4u * (uint32_t)(i))
+
+/* PID 이력 읽기/프리로드 (warm restart). 순서는 C++ DeltaPidState 와 동일
+ *   0 dy[n-1]  1 w[n-1]  2 w[n-2]  3 x[n-1]  4 x[n-2]
+ *   5 y_unsat[n-1]  6 y_unsat[n-2]  7 y_sat[n-1]  8 y_sat[n-2] */
+#define REG_PID_STATUS  0x88  // (RO) bit0 busy, bit1 frozen (정지 + IDLE)
+#define REG_HIST0       0x8C  // R/W, 쓰기는 frozen 일 때만 반영 .. +0x20 = y_sat[n-2]
+#define REG_HIST(i)     (REG_HIST0 + 4u * (uint32_t)(i))
+#define MC_HIST_WORDS   9
+
+#define CTRL_SW_MODE    0x1u
+#define CTRL_COEF_SYNTH 0x2u
+#define CTRL_FREEZE     0x4u
+#define CTRL_MANUAL     0x8u
+
+#define SYNTH_BUSY      0x1u
+#define SYNTH_PENDING   0x2u
+#define SYNTH_ERR       0x4u
+#define SYNTH_COMMITS(raw)    ((uint16_t)((raw) >> 16))
+
+#define PID_STATUS_BUSY     0x1u
+#define PID_STATUS_FROZEN   0x2u
+
+#define STATUS13_SPDCNT(raw)  ((int16_t)((raw) & 0xFFFF))
+#define STATUS13_SEQ(raw)     ((uint16_t)((raw) >> 16))
+
+#ifdef MC_HOST
+
+uint32_t mc_host_rd32(uint32_t off);
+void     mc_host_wr32(uint32_t off, uint32_t v);
+
+#define mc_rd32(off)     mc_host_rd32(off)
+#define mc_wr32(off, v)  mc_host_wr32((off), (v))
+
+#else
+
+#include "xil_io.h"
+#include "xparameters.h"
+
+/* === 하드웨어 베이스 주소 (플랫폼에 맞게 수정) === */
+#ifndef MOTOR_CTRL_BASE
+#define MOTOR_CTRL_BASE XPAR_PID_CONTROLLER_INTER_0_BASEADDR
+#endif
+
+#define mc_rd32(off)     Xil_In32(MOTOR_CTRL_BASE + (off))
+#define mc_wr32(off, v)  Xil_Out32(MOTOR_CTRL_BASE + (off), (v))
+
+#endif /* MC_HOST */
+
+#endif /* MC_REGS_H */
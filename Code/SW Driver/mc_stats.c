@@ -0,0 +1,158 @@
+/********************  mc_stats.c  ********************/
+#include "mc_stats.h"
+
+#include <math.h>
+#include <stdio.h>
+
+static const double s_qp[MC_STATS_NQ] = { 0.50, 0.90, 0.99 };
+
+/* ---- |e| 로그 버킷 ---- */
+static double hist_gamma_(void) { return (1.0 + MC_STATS_QALPHA) / (1.0 - MC_STATS_QALPHA); }
+
+static void hist_feed_(mc_stats_t *s, double ae)
+{
+    int i = 0;
+    if (ae > MC_STATS_QMIN) {
+        i = (int)ceil(log(ae / MC_STATS_QMIN) / log(hist_gamma_()));
+        if (i < 1) i = 1;                       /* 경계 라운딩 */
+        if (i > MC_STATS_NB - 1) i = MC_STATS_NB - 1;
+    }
+    s->hist[i]++;
+    s->hist_n++;
+}
+
+/* 순위 floor(p·(n-1)) 표본이 든 버킷의 대표값 2·QMIN·γ^i/(γ+1) */
+static double hist_value_(const mc_stats_t *s, double p)
+{
+    const double g = hist_gamma_();
+    uint32_t k, c = 0;
+    int i;
+    if (s->hist_n == 0) return 0.0;
+    k = (uint32_t)(p * (double)(s->hist_n - 1));
+    for (i = 0; i < MC_STATS_NB - 1; i++) {
+        c += s->hist[i];
+        if (c > k) break;
+    }
+    return i ? 2.0 * MC_STATS_QMIN * pow(g, (double)i) / (g + 1.0) : 0.0;
+}
+
+/* ---- 공개 함수 ---- */
+void mc_stats_init(mc_stats_t *s, float w, float ysat, float band, uint32_t hold)
+{
+    s->ysat  = ysat;
+    s->band  = band;
+    s->hold  = hold ? hold : 1;
+    s->total = 0;
+    mc_stats_set_target(s, w);
+}
+
+void mc_stats_set_target(mc_stats_t *s, float w)
+{
+    int i;
+    s->w     = w;
+    s->gates = 0;
+    s->samples = 0;
+    s->skipped = 0;
+    s->mean  = 0.0;
+    s->m2    = 0.0;
+    s->e_min = INFINITY;
+    s->e_max = -INFINITY;
+    for (i = 0; i < MC_STATS_NB; i++) s->hist[i] = 0;
+    s->hist_n      = 0;
+    s->y_known     = 0;
+    s->sat         = 0;
+    s->run         = 0;
+    s->settle_gate = -1;
+    s->excursions  = 0;
+    s->steady      = 0;
+}
+
+void mc_stats_feed(mc_stats_t *s, float x, float y)
+{
+    const float  e  = s->w - x;
+    const float  ae = fabsf(e);
+    const double d  = (double)e - s->mean;
+
+    s->gates++;
+    s->total++;
+    s->samples++;
+    s->mean += d / (double)s->samples;
+    s->m2   += d * ((double)e - s->mean);
+    if (e < s->e_min) s->e_min = e;
+    if (e > s->e_max) s->e_max = e;
+
+    if (!isnan(y)) {
+        s->y_known++;
+        if (fabsf(y) >= s->ysat) s->sat++;
+    }
+
+    /* 정착 판정 */
+    if (ae <= s->band * fabsf(s->w)) {
+        if (++s->run == s->hold && s->settle_gate < 0)
+            s->settle_gate = (int32_t)(s->gates - s->hold);
+        if (s->settle_gate >= 0) s->steady = 1;
+    } else {
+        if (s->settle_gate >= 0) { s->excursions++; s->settle_gate = -1; }
+        s->run = 0;
+    }
+    if (s->steady) hist_feed_(s, (double)ae);
+}
+
+void mc_stats_skip(mc_stats_t *s, uint32_t n)
+{
+    s->gates   += n;
+    s->total   += n;
+    s->skipped += n;
+    if (n) s->run = 0;
+}
+
+void mc_stats_summary(const mc_stats_t *s, mc_stats_summary_t *o)
+{
+    int i;
+    o->gates      = s->gates;
+    o->total      = s->total;
+    o->skipped    = s->skipped;
+    o->w          = s->w;
+    o->e_mean     = (float)s->mean;
+    o->e_std      = (s->samples > 1) ? (float)sqrt(s->m2 / (double)(s->samples - 1)) : 0.0f;
+    o->e_min      = s->samples ? s->e_min : 0.0f;
+    o->e_max      = s->samples ? s->e_max : 0.0f;
+    for (i = 0; i < MC_STATS_NQ; i++) o->e_abs_q[i] = (float)hist_value_(s, s_qp[i]);
+    o->sat_ratio  = s->y_known ? (float)s->sat / (float)s->y_known : -1.0f;
+    o->settle_gate = s->settle_gate;
+    o->excursions = s->excursions;
+}
+
+void mc_stats_line(const mc_stats_t *s, double gate_s)
+{
+    mc_stats_summary_t m;
+    mc_stats_summary(s, &m);
+    printf("[stats] t=%.2fs e=%.3f±%.3f |e|p99=%.3f settle=", (double)m.total * gate_s,
+           (double)m.e_mean, (double)m.e_std, (double)m.e_abs_q[2]);
+    if (m.settle_gate >= 0) printf("%.3fs", (double)m.settle_gate * gate_s);
+    else                    printf("-");
+    printf(" exc=%lu\r\n", (unsigned long)m.excursions);
+}
+
+void mc_stats_dump(const mc_stats_t *s, double gate_s)
+{
+    mc_stats_summary_t m;
+    mc_stats_summary(s, &m);
+    printf("\r\n--- speed error stats (w=%.3f rad/s, %lu gates since target, %lu total) ---\r\n",
+           (double)m.w, (unsigned long)m.gates, (unsigned long)m.total);
+    printf("e mean=%.4f  std=%.4f  min=%.4f  max=%.4f [rad/s]\r\n",
+           (double)m.e_mean, (double)m.e_std, (double)m.e_min, (double)m.e_max);
+    if (m.skipped) printf("unobserved gates=%lu (not in mean/quantiles)\r\n", (unsigned long)m.skipped);
+    if (s->steady)
+        printf("|e| p50=%.4f  p90=%.4f  p99=%.4f [rad/s] (after first settle)\r\n",
+               (double)m.e_abs_q[0], (double)m.e_abs_q[1], (double)m.e_abs_q[2]);
+    if (m.sat_ratio >= 0.0f) printf("saturation=%.2f%%\r\n", 100.0 * (double)m.sat_ratio);
+    else                     printf("saturation=n/a (y not observed)\r\n");
+    if (m.settle_gate >= 0)
+        printf("settled at %.3f s (band %.1f%%, hold %lu), excursions=%lu\r\n",
+               (double)m.settle_gate * gate_s, 100.0 * (double)s->band,
+               (unsigned long)s->hold, (unsigned long)m.excursions);
+    else
+        printf("not settled (band %.1f%%, hold %lu), excursions=%lu\r\n",
+               100.0 * (double)s->band, (unsigned long)s->hold, (unsigned long)m.excursions);
+}
@@ -0,0 +1,73 @@
+/********************  mc_stats.h  ********************/
+#ifndef MC_STATS_H
+#define MC_STATS_H
+
+#include <stdint.h>
+
+/* === 게이트 단위 스트리밍 통계 (메모리 O(1), 샘플 저장 없음) ===
+ *  - 속도 오차 e = w - x 에 대해
+ *      Welford 평균/분산, 최소/최대 : 전 게이트
+ *      |e| 분위수 (로그 버킷 히스토그램, 고정 크기) : 첫 정착 이후만
+ *        버킷 i 는 (QMIN·γ^(i-1), QMIN·γ^i], γ = (1+α)/(1-α) → 대표값이 그 버킷
+ *        어느 값과도 상대 오차 α 이내. 분위수 = 순위 floor(p·(n-1)) 표본의 버킷 대표값
+ *        → 정확한 분위수 대비 상대 오차 ≤ α (QMIN 이하는 0 버킷, 절대 오차 ≤ QMIN)
+ *        (P² 는 정착 직후 과도 꼬리로 마커가 잡히면 회복하지 못하고, 엔코더 카운트로
+ *         양자화된 |e| 를 실제로 나오지 않는 중간값으로 보간함)
+ *  - 포화 비율: y 를 알 때만 (y = NAN 이면 해당 게이트 제외)
+ *  - 정착: |e| <= band·|w| 가 hold 게이트 연속 → 그 구간 시작 게이트를 정착 시점
+ *          정착 후 밴드 이탈은 excursion 으로 세고 다시 정착을 기다림
+ *  - mc_stats_set_target 으로 목표가 바뀌면 total 외 전부 새로 시작
+ *  - 게이트 축: 한 번 feed = 한 게이트. 관측하지 못한 게이트 (gate_seq 가 2 이상
+ *    진행) 는 mc_stats_skip 으로 시간만 진행 → 정착 시점이 게이트 단위로 유지됨
+ *    (미관측 게이트는 평균/분위수/포화에서 빠지고, 밴드 안 연속 판정은 끊김)
+ *  - 출력은 요청 시에만: mc_stats_line (한 줄), mc_stats_dump (전체),
+ *    mc_stats_summary (구조체로 내보내기) */
+
+#define MC_STATS_NQ      3                   /* |e| 분위수: p50, p90, p99 */
+#define MC_STATS_QALPHA  0.01                /* 분위수 상대 오차 α */
+#define MC_STATS_QMIN    1e-3                /* 이하 |e| 는 0 버킷 [rad/s] */
+#define MC_STATS_NB      692                 /* 0 버킷 + (QMIN, ~1e3] 로그 버킷 691 개 (2.7 KB) */
+
+typedef struct {
+    /* 설정 */
+    float    w;                              /* 목표 [rad/s] */
+    float    ysat;
+    float    band;                           /* 정착 밴드 (|w| 대비 비율) */
+    uint32_t hold;                           /* 정착 판정 연속 게이트 */
+
+    /* 누적 */
+    uint32_t gates;                          /* 목표 설정 후 게이트 (미관측 포함) */
+    uint32_t total;                          /* 전체 게이트 */
+    uint32_t samples;                        /* 목표 설정 후 관측 게이트 */
+    uint32_t skipped;                        /* 목표 설정 후 미관측 게이트 */
+    double   mean, m2;                       /* Welford (e) */
+    float    e_min, e_max;
+    uint32_t hist[MC_STATS_NB];              /* |e| 로그 버킷 (정착 이후) */
+    uint32_t hist_n;
+    uint32_t y_known, sat;
+
+    uint32_t run;                            /* 현재 밴드 안 연속 게이트 */
+    int32_t  settle_gate;                    /* -1: 미정착 */
+    uint32_t excursions;
+    uint8_t  steady;                         /* 첫 정착 이후 (분위수 누적 중) */
+} mc_stats_t;
+
+typedef struct {
+    uint32_t gates, total, skipped;
+    float    w;
+    float    e_mean, e_std, e_min, e_max;
+    float    e_abs_q[MC_STATS_NQ];           /* p50, p90, p99 (미정착이면 0) */
+    float    sat_ratio;                      /* y 미지 게이트뿐이면 -1 */
+    int32_t  settle_gate;
+    uint32_t excursions;
+} mc_stats_summary_t;
+
+void mc_stats_init(mc_stats_t *s, float w, float ysat, float band, uint32_t hold);
+void mc_stats_set_target(mc_stats_t *s, float w);
+void mc_stats_feed(mc_stats_t *s, float x, float y);
+void mc_stats_skip(mc_stats_t *s, uint32_t n);
+void mc_stats_summary(const mc_stats_t *s, mc_stats_summary_t *out);
+void mc_stats_line(const mc_stats_t *s, double gate_s);
+void mc_stats_dump(const mc_stats_t *s, double gate_s);
+
+#endif /* MC_STATS_H */
@@ -0,0 +1,109 @@
+/********************  mc_swpid.c  ********************/
+#include "mc_swpid.h"
+#include "mc_regs.h"
+
+#include <stdio.h>
+
+#ifdef MC_HOST
+#include <time.h>
+#define MC_SWPID_TPS  (1000000000.0)
+#else
+#include "xtime_l.h"
+#define MC_SWPID_TPS  ((double)COUNTS_PER_SECOND)
+#endif
+
+static inline uint32_t f2u_(float x) { uint32_t u; memcpy(&u, &x, 4); return u; }
+
+uint64_t mc_swpid_now(void)
+{
+#ifdef MC_HOST
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+#else
+    XTime t;
+    XTime_GetTime(&t);
+    return (uint64_t)t;
+#endif
+}
+
+double mc_swpid_ticks_per_sec(void) { return MC_SWPID_TPS; }
+
+int mc_swpid_wait_gate(uint16_t last, uint32_t timeout_us, uint32_t *raw)
+{
+    const uint64_t t0    = mc_swpid_now();
+    const uint64_t limit = (uint64_t)((double)timeout_us * 1e-6 * MC_SWPID_TPS);
+    uint32_t r;
+    for (;;) {
+        r = mc_rd32(REG_STATUS13);
+        if (STATUS13_SEQ(r) != last) { *raw = r; return MC_SWPID_OK; }
+        if (mc_swpid_now() - t0 > limit) return MC_SWPID_TIMEOUT;
+    }
+}
+
+void mc_swpid_start(mc_swpid_t *s, const float c[9], float ysat, float w, uint32_t gate_us)
+{
+    memset(s, 0, sizeof(*s));
+    mc_delta_pid_init(&s->pid, c, ysat);
+    s->w       = w;
+    s->wait_us = MC_SWPID_WAIT_GATES * gate_us;
+    s->lat_min = UINT64_MAX;
+    s->seq     = STATUS13_SEQ(mc_rd32(REG_STATUS13));
+    mc_wr32(REG_CTRL, mc_rd32(REG_CTRL) | CTRL_SW_MODE);
+}
+
+void mc_swpid_stop(mc_swpid_t *s)
+{
+    (void)s;
+    mc_wr32(REG_CTRL, mc_rd32(REG_CTRL) & ~CTRL_SW_MODE);
+}
+
+int mc_swpid_step(mc_swpid_t *s, mc_swpid_sample_t *out)
+{
+    uint32_t raw;
+    uint64_t t0, dt;
+    uint16_t seq;
+    int b = 0;
+
+    /* 새 게이트 대기 (t0 = 새 샘플을 본 읽기 직후) */
+    if (mc_swpid_wait_gate(s->seq, s->wait_us, &raw) != MC_SWPID_OK) return MC_SWPID_TIMEOUT;
+    t0  = mc_swpid_now();
+    seq = STATUS13_SEQ(raw);
+
+    out->seq    = seq;
+    out->spdcnt = STATUS13_SPDCNT(raw);
+    out->x      = mc_spdcnt_to_x(out->spdcnt);
+    out->y      = mc_delta_pid_step(&s->pid, s->w, out->x);
+    mc_wr32(REG_Y_SW, f2u_(out->y));
+
+    dt = mc_swpid_now() - t0;
+    out->ticks = (uint32_t)dt;
+
+    if ((uint16_t)(seq - s->seq) > 1) s->missed += (uint16_t)(seq - s->seq) - 1;
+    s->seq = seq;
+    s->gates++;
+    s->lat_sum += dt;
+    if (dt < s->lat_min) s->lat_min = dt;
+    if (dt > s->lat_max) s->lat_max = dt;
+    while (b < MC_SWPID_BUCKETS - 1 && (dt >> (b + 1)) != 0) b++;
+    s->lat_hist[b]++;
+    return MC_SWPID_OK;
+}
+
+void mc_swpid_dump(const mc_swpid_t *s)
+{
+    const double us = 1e6 / MC_SWPID_TPS;
+    uint32_t acc = 0, p50 = 0, p99 = 0;
+    int b;
+    if (s->gates == 0) return;
+    for (b = 0; b < MC_SWPID_BUCKETS; b++) {
+        acc += s->lat_hist[b];
+        if (!p50 && acc > s->gates / 2)            p50 = 1u << b;
+        if (!p99 && acc > s->gates - s->gates / 100) p99 = 1u << b;
+    }
+    printf("\r\n--- PS Δ-form path: read→compute→write (us) ---\r\n");
+    printf("gates=%lu  missed=%lu  mean=%.3f  min=%.3f  p50<%.3f  p99<%.3f  max=%.3f\r\n",
+           (unsigned long)s->gates, (unsigned long)s->missed,
+           (double)s->lat_sum / (double)s->gates * us, (double)s->lat_min * us,
+           2.0 * p50 * us, 2.0 * p99 * us, (double)s->lat_max * us);
+}
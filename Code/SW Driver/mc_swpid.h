@@ -0,0 +1,59 @@
+/********************  mc_swpid.h  ********************/
+#ifndef MC_SWPID_H
+#define MC_SWPID_H
+
+#include <stdint.h>
+#include "mc_delta_pid.h"
+
+/* === PS 소프트웨어 Δ-form 제어 경로 (FPGA PID 코어 대체 / A-B 비교) ===
+ *  - REG_CTRL.bit0 = 1 이면 PWM 이 REG_Y_SW 를 따른다
+ *  - 게이트마다: REG_STATUS13 폴링 → gate_seq 가 바뀌면
+ *      x = spdcnt·INT2RADS → mc_delta_pid_step → REG_Y_SW 쓰기
+ *  - 읽기(새 샘플 확인)~쓰기 완료 구간을 샘플마다 타이머 틱으로 측정
+ *      보드: XTime (전역 타이머), -DMC_HOST: clock_gettime (ns)
+ *  - gate_seq 가 2 이상 뛰면 놓친 게이트(오버런)로 집계
+ *  - 대기는 MC_SWPID_WAIT_GATES 게이트 주기까지만. 넘으면 MC_SWPID_TIMEOUT
+ *    (gate_seq 가 없는 이전 비트스트림은 [31:16] 이 spdcnt 부호 확장이라 멈춰 있을 수 있음) */
+
+#define MC_SWPID_BUCKETS    32                  /* [2^b, 2^(b+1)) ticks */
+#define MC_SWPID_WAIT_GATES 4                   /* gate_seq 대기 한도 (게이트 주기 배수) */
+
+enum {
+    MC_SWPID_OK      =  0,
+    MC_SWPID_TIMEOUT = -1                       /* gate_seq 가 진행하지 않음 */
+};
+
+typedef struct {
+    uint16_t seq;
+    int16_t  spdcnt;
+    float    x, y;
+    uint32_t ticks;                             /* read → compute → write */
+} mc_swpid_sample_t;
+
+typedef struct {
+    mc_delta_pid_t pid;
+    float    w;
+    uint16_t seq;                               /* 마지막으로 처리한 gate_seq */
+    uint32_t wait_us;                           /* gate_seq 대기 한도 */
+    uint32_t gates, missed;
+    uint64_t lat_sum, lat_min, lat_max;
+    uint32_t lat_hist[MC_SWPID_BUCKETS];
+} mc_swpid_t;
+
+uint64_t mc_swpid_now(void);
+double   mc_swpid_ticks_per_sec(void);
+
+/* gate_seq 가 last 와 달라질 때까지 최대 timeout_us 폴링. OK 면 *raw = REG_STATUS13 */
+int  mc_swpid_wait_gate(uint16_t last, uint32_t timeout_us, uint32_t *raw);
+
+/* 현재 gate_seq 를 기준으로 시작 (이미 래치된 샘플은 건너뜀), PS 경로 활성
+   gate_us: 게이트 주기 (대기 한도 = MC_SWPID_WAIT_GATES · gate_us) */
+void mc_swpid_start(mc_swpid_t *s, const float c[9], float ysat, float w, uint32_t gate_us);
+void mc_swpid_stop(mc_swpid_t *s);              /* FPGA PID 경로로 복귀 */
+
+/* 다음 게이트까지 대기 후 한 샘플 처리. TIMEOUT 이면 REG_Y_SW 는 그대로 */
+int  mc_swpid_step(mc_swpid_t *s, mc_swpid_sample_t *out);
+
+void mc_swpid_dump(const mc_swpid_t *s);
+
+#endif /* MC_SWPID_H */
@@ -0,0 +1,373 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "spsc_queue.hpp"
+
+// ============================================================
+//  비동기 트레이스/결과 기록기 (생산자 스레드 1개 → 파일 1개)
+//  - 고정 크기, 페이지 정렬 버퍼에 append → 가득 차면 백엔드에 넘기고
+//    빈 버퍼를 받아 계속 채움. 디스크 완료는 기다리지 않는다
+//  - 백엔드
+//      URING  : io_uring (raw syscall, liburing 없음). 생산자가 SQE 를 넣고
+//               io_uring_enter 로 제출, 완료는 CQ 링을 메모리에서 직접 수거.
+//               SQE 마다 IOSQE_ASYNC — 없으면 버퍼드 쓰기가 io_uring_enter 안에서
+//               인라인으로 돌아 생산자가 페이지 캐시 복사를 기다림 (1 MB 당 ~0.4 ms)
+//      THREAD : 전용 기록 스레드가 pwrite (SpscQueue 로 주고받음)
+//      AUTO   : THREAD. 넘김 최악값이 THREAD ≈ 0 인데 io_uring 은 IOSQE_ASYNC 여도
+//               io_uring_enter 시스템 호출 + io-wq 깨움이 생산자 쪽에 남음
+//               (trace_writer_bench). io_uring 은 URING 으로 명시할 때만
+//  - O_DIRECT (선택): 버퍼/오프셋이 4 KB 정렬이므로 그대로 사용. 마지막 버퍼는
+//    4 KB 로 채워 쓰고 close 에서 실제 길이로 ftruncate.
+//    파일 시스템이 거부하면(tmpfs 등) 일반 쓰기로 전환
+//  - 빈 버퍼가 없으면 max_buffers 까지 늘리고, 그 이상이면 완료를 기다림
+//    (stall_s 로 보고 — 0 이 아니면 버퍼 수/크기를 키울 것)
+// ============================================================
+
+class AsyncWriter {
+public:
+    enum class Backend { AUTO, URING, THREAD };
+
+    struct Options {
+        size_t  buf_bytes   = 1 << 20;   // 4 KB 배수
+        size_t  n_buffers   = 8;         // 처음 할당
+        size_t  max_buffers = 64;        // 상한 (기록 중 버퍼 수)
+        bool    direct      = false;     // O_DIRECT
+        Backend backend     = Backend::AUTO;   // = THREAD
+    };
+
+    struct Stats {
+        const char* backend   = "none";
+        bool        direct    = false;
+        uint64_t    bytes     = 0;
+        uint64_t    submits   = 0;       // 넘긴 버퍼 수
+        size_t      buffers   = 0;       // 할당된 버퍼 수 (최대)
+        double      stall_s   = 0.0;     // 생산자가 빈 버퍼를 기다린 시간
+        double      handoff_max_s = 0.0; // 버퍼 한 개 넘기는 데 걸린 최대 시간
+        int         error     = 0;       // 첫 번째 errno
+    };
+
+    AsyncWriter() = default;
+    AsyncWriter(const AsyncWriter&) = delete;
+    AsyncWriter& operator=(const AsyncWriter&) = delete;
+    ~AsyncWriter() { close(); }
+
+    bool open(const std::string& path) { return open(path, Options()); }
+
+    bool open(const std::string& path, const Options& opt, std::string* err = nullptr) {
+        close();
+        opt_ = opt;
+        opt_.buf_bytes   = std::max<size_t>(ALIGN, (opt_.buf_bytes + ALIGN - 1) / ALIGN * ALIGN);
+        opt_.n_buffers   = std::max<size_t>(2, opt_.n_buffers);
+        opt_.max_buffers = std::max(opt_.max_buffers, opt_.n_buffers);
+        st_ = Stats{};
+
+        int flags = O_WRONLY | O_CREAT | O_TRUNC;
+        if (opt_.direct) {
+            fd_ = ::open(path.c_str(), flags | O_DIRECT, 0644);
+            st_.direct = fd_ >= 0;
+        }
+        if (fd_ < 0) fd_ = ::open(path.c_str(), flags, 0644);
+        if (fd_ < 0) return fail(err, path + ": open 실패");
+
+        if (opt_.backend == Backend::URING && ring_.setup((unsigned)opt_.max_buffers)) {
+            uring_ = true;
+            st_.backend = "io_uring";
+        } else if (opt_.backend == Backend::URING) {
+            ::close(fd_);
+            fd_ = -1;
+            return fail(err, "io_uring 사용 불가");
+        } else {
+            jobs_ = std::make_unique<SpscQueue<Job>>(opt_.max_buffers);
+            done_ = std::make_unique<SpscQueue<Buf*>>(opt_.max_buffers);
+            worker_ = std::thread([this] { worker(); });
+            st_.backend = "thread";
+        }
+        for (size_t i = 0; i < opt_.n_buffers; ++i) free_.push_back(alloc());
+        cur_ = take();
+        return true;
+    }
+
+    // 핫 패스: 버퍼에 복사만 (가득 차면 넘김)
+    void append(const void* p, size_t n) {
+        const uint8_t* s = (const uint8_t*)p;
+        while (n) {
+            const size_t k = std::min(n, opt_.buf_bytes - cur_->n);
+            std::memcpy(cur_->data + cur_->n, s, k);
+            cur_->n += k;  s += k;  n -= k;
+            if (cur_->n == opt_.buf_bytes) { submit(cur_); cur_ = take(); }
+        }
+    }
+
+    template <class T>
+    void put(const T& v) { append(&v, sizeof(T)); }
+
+    // 남은 데이터 제출 → 모두 완료 대기 → (선택) fdatasync
+    bool close(bool sync = false) {
+        if (fd_ < 0) return st_.error == 0;
+        if (cur_ && cur_->n) submit(cur_);
+        else if (cur_) free_.push_back(cur_);
+        cur_ = nullptr;
+        while (inflight_) reap(true);
+
+        if (worker_.joinable()) {
+            jobs_->push(Job{ nullptr, 0, 0 });
+            worker_.join();
+            if (werr_) note(werr_);
+        }
+        ring_.teardown();
+        uring_ = false;
+        if (st_.direct && ::ftruncate(fd_, (off_t)st_.bytes) != 0) note(errno);
+        if (sync && ::fdatasync(fd_) != 0) note(errno);
+        if (::close(fd_) != 0) note(errno);
+        fd_ = -1;
+        for (Buf* b : all_) { std::free(b->data); delete b; }
+        all_.clear();
+        free_.clear();
+        return st_.error == 0;
+    }
+
+    const Stats& stats() const { return st_; }
+
+private:
+    static constexpr size_t ALIGN = 4096;
+
+    struct Buf {
+        uint8_t* data;
+        size_t   n    = 0;     // 채운 바이트
+        size_t   len  = 0;     // 기록 길이 (O_DIRECT 면 4 KB 올림)
+        size_t   done = 0;     // 완료된 바이트 (짧은 쓰기 재제출용)
+        uint64_t off  = 0;
+    };
+
+    struct Job { Buf* b; uint64_t off; size_t len; };
+
+    // ---- io_uring (raw syscall) ----
+    struct Ring {
+        int            fd = -1;
+        unsigned       entries = 0, to_submit = 0;
+        unsigned      *sq_head, *sq_tail, *sq_mask, *sq_array;
+        unsigned      *cq_head, *cq_tail, *cq_mask;
+        io_uring_sqe*  sqes = nullptr;
+        io_uring_cqe*  cqes;
+        void          *sq_ptr = nullptr, *cq_ptr = nullptr;
+        size_t         sq_sz = 0, cq_sz = 0, sqe_sz = 0;
+
+        bool setup(unsigned n) {
+            io_uring_params p{};
+            fd = (int)::syscall(__NR_io_uring_setup, n, &p);
+            if (fd < 0) return false;
+            sq_sz = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+            cq_sz = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+            const bool single = p.features & IORING_FEAT_SINGLE_MMAP;
+            if (single) sq_sz = cq_sz = std::max(sq_sz, cq_sz);
+            sq_ptr = ::mmap(nullptr, sq_sz, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQ_RING);
+            if (sq_ptr == MAP_FAILED) { sq_ptr = nullptr; teardown(); return false; }
+            cq_ptr = single ? sq_ptr
+                            : ::mmap(nullptr, cq_sz, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+            if (cq_ptr == MAP_FAILED) { cq_ptr = nullptr; teardown(); return false; }
+            sqe_sz = p.sq_entries * sizeof(io_uring_sqe);
+            void* s = ::mmap(nullptr, sqe_sz, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+            if (s == MAP_FAILED) { teardown(); return false; }
+            sqes = (io_uring_sqe*)s;
+
+            uint8_t* sq = (uint8_t*)sq_ptr;
+            uint8_t* cq = (uint8_t*)cq_ptr;
+            sq_head  = (unsigned*)(sq + p.sq_off.head);
+            sq_tail  = (unsigned*)(sq + p.sq_off.tail);
+            sq_mask  = (unsigned*)(sq + p.sq_off.ring_mask);
+            sq_array = (unsigned*)(sq + p.sq_off.array);
+            cq_head  = (unsigned*)(cq + p.cq_off.head);
+            cq_tail  = (unsigned*)(cq + p.cq_off.tail);
+            cq_mask  = (unsigned*)(cq + p.cq_off.ring_mask);
+            cqes     = (io_uring_cqe*)(cq + p.cq_off.cqes);
+            entries  = p.sq_entries;
+            if (!supports(IORING_OP_WRITE)) { teardown(); return false; }
+            return true;
+        }
+
+        bool supports(uint8_t op) const {
+            alignas(io_uring_probe) uint8_t mem[sizeof(io_uring_probe) + 256 * sizeof(io_uring_probe_op)] = {};
+            io_uring_probe* pr = (io_uring_probe*)mem;
+            if (::syscall(__NR_io_uring_register, fd, IORING_REGISTER_PROBE, pr, 256) < 0) return false;
+            return op <= pr->last_op && (pr->ops[op].flags & IO_URING_OP_SUPPORTED);
+        }
+
+        void teardown() {
+            if (sqes)   ::munmap(sqes, sqe_sz);
+            if (cq_ptr && cq_ptr != sq_ptr) ::munmap(cq_ptr, cq_sz);
+            if (sq_ptr) ::munmap(sq_ptr, sq_sz);
+            if (fd >= 0) ::close(fd);
+            sqes = nullptr;  sq_ptr = cq_ptr = nullptr;  fd = -1;
+        }
+
+        // 링에 자리가 있다는 전제 (in-flight ≤ max_buffers ≤ entries)
+        void write(int file, const void* p, unsigned len, uint64_t off, uint64_t tag) {
+            const unsigned t = *sq_tail;
+            const unsigned i = t & *sq_mask;
+            io_uring_sqe& e = sqes[i];
+            std::memset(&e, 0, sizeof(e));
+            e.opcode    = IORING_OP_WRITE;
+            e.flags     = IOSQE_ASYNC;      // 인라인 시도 없이 io-wq 로 (5.6+, PROBE 와 같은 버전)
+            e.fd        = file;
+            e.addr      = (uint64_t)(uintptr_t)p;
+            e.len       = len;
+            e.off       = off;
+            e.user_data = tag;
+            sq_array[i] = i;
+            __atomic_store_n(sq_tail, t + 1, __ATOMIC_RELEASE);
+            ++to_submit;
+        }
+
+        // 제출 (+ wait 개 완료까지 대기)
+        int enter(unsigned wait) {
+            const long r = ::syscall(__NR_io_uring_enter, fd, to_submit, wait, wait ? IORING_ENTER_GETEVENTS : 0, nullptr, 0);
+            if (r >= 0) to_submit -= (unsigned)r;
+            return r < 0 ? -errno : 0;
+        }
+
+        bool pop(io_uring_cqe& c) {
+            const unsigned h = *cq_head;
+            if (h == __atomic_load_n(cq_tail, __ATOMIC_ACQUIRE)) return false;
+            c = cqes[h & *cq_mask];
+            __atomic_store_n(cq_head, h + 1, __ATOMIC_RELEASE);
+            return true;
+        }
+    };
+
+    Buf* alloc() {
+        Buf* b = new Buf;
+        b->data = (uint8_t*)std::aligned_alloc(ALIGN, opt_.buf_bytes);
+        all_.push_back(b);
+        st_.buffers = all_.size();
+        return b;
+    }
+
+    // 빈 버퍼: 완료 수거 → 여유분 → 새로 할당 → (상한이면) 대기
+    Buf* take() {
+        reap(false);
+        if (free_.empty() && all_.size() < opt_.max_buffers) free_.push_back(alloc());
+        if (free_.empty()) {
+            const auto t0 = std::chrono::steady_clock::now();
+            while (free_.empty()) reap(true);
+            st_.stall_s += std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        }
+        Buf* b = free_.back();
+        free_.pop_back();
+        b->n = 0;
+        return b;
+    }
+
+    void submit(Buf* b) {
+        const auto t0 = std::chrono::steady_clock::now();
+        b->len  = st_.direct ? (b->n + ALIGN - 1) / ALIGN * ALIGN : b->n;
+        b->done = 0;
+        b->off  = off_;
+        if (b->len > b->n) std::memset(b->data + b->n, 0, b->len - b->n);
+        off_       += b->n;
+        st_.bytes  += b->n;
+        ++st_.submits;
+        ++inflight_;
+        if (uring_) {
+            ring_.write(fd_, b->data, (unsigned)b->len, b->off, (uint64_t)(uintptr_t)b);
+            if (const int e = ring_.enter(0)) note(-e);
+        } else {
+            jobs_->push(Job{ b, b->off, b->len });
+        }
+        st_.handoff_max_s = std::max(st_.handoff_max_s,
+                                     std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count());
+    }
+
+    // 완료 수거. wait 이면 최소 1개 완료까지 대기
+    void reap(bool wait) {
+        if (!inflight_) return;
+        if (uring_) {
+            if (wait) if (const int e = ring_.enter(1)) { if (e != -EINTR) note(-e); }
+            io_uring_cqe c;
+            while (ring_.pop(c)) {
+                Buf* b = (Buf*)(uintptr_t)c.user_data;
+                if (c.res < 0) { note(-c.res); release(b); continue; }
+                b->done += (size_t)c.res;
+                if (c.res == 0 || b->done >= b->len) {
+                    if (c.res == 0) note(EIO);
+                    release(b);
+                } else {
+                    // 짧은 쓰기: 나머지 재제출
+                    ring_.write(fd_, b->data + b->done, (unsigned)(b->len - b->done), b->off + b->done, c.user_data);
+                    ring_.enter(0);
+                }
+            }
+        } else {
+            Buf* b[16];
+            size_t n = wait ? done_->pop_wait(b, 16) : done_->pop_n(b, 16);
+            for (size_t i = 0; i < n; ++i) release(b[i]);
+        }
+    }
+
+    void release(Buf* b) {
+        free_.push_back(b);
+        --inflight_;
+    }
+
+    void worker() {
+        Job j[16];
+        for (;;) {
+            size_t n = 0;
+            for (int spin = 0; !(n = jobs_->pop_n(j, 16)); ++spin) {
+                if (spin < 128) SpscQueue<Job>::backoff(spin);
+                else std::this_thread::sleep_for(std::chrono::microseconds(200));
+            }
+            for (size_t i = 0; i < n; ++i) {
+                if (!j[i].b) return;
+                size_t done = 0;
+                while (done < j[i].len) {
+                    const ssize_t w = ::pwrite(fd_, j[i].b->data + done, j[i].len - done, (off_t)(j[i].off + done));
+                    if (w <= 0) { if (w < 0 && errno == EINTR) continue; werr_ = w < 0 ? errno : EIO; break; }
+                    done += (size_t)w;
+                }
+                done_->push(j[i].b);
+            }
+        }
+    }
+
+    void note(int e) {
+        if (!st_.error) st_.error = e;
+    }
+
+    static bool fail(std::string* err, const std::string& msg) {
+        if (err) *err = msg;
+        return false;
+    }
+
+    Options                           opt_;
+    Stats                             st_;
+    int                               fd_ = -1;
+    uint64_t                          off_ = 0;
+    size_t                            inflight_ = 0;
+    Buf*                              cur_ = nullptr;
+    std::vector<Buf*>                 all_, free_;
+
+    bool                              uring_ = false;
+    Ring                              ring_;
+
+    std::unique_ptr<SpscQueue<Job>>   jobs_;
+    std::unique_ptr<SpscQueue<Buf*>>  done_;
+    std::thread                       worker_;
+    std::atomic<int>                  werr_{ 0 };
+};
@@ -0,0 +1,230 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include "scenario.hpp"
+
+// ============================================================
+//  수동/자동 전환 (REG_CTRL.MANUAL, REG_Y_MAN) 무충격 검사
+//  - 빌드: g++ -O2 -std=c++20 -fno-fast-math -ffp-contract=off bumpless_check.cpp
+//  - 사용: ./a.out [lanes=4000]
+//  1) 모델: 수동 스텝 == "보통 스텝 후 y_unsat[n-1], y_sat[n-1] 을 clamp(y_man) 으로
+//     덮어쓰기" (restore 로 만든 독립 기준), 무작위 모드 전환 포함 비트 동일.
+//     step_n (수동/자동 각각) == 반복 step()
+//  2) 레인 묶음 시나리오: 정착 → 수동 (현재 출력 ± 오프셋, 일부는 목표/부하 변경)
+//     → 자동 복귀. 추종(RTL) 대 기존 동작(출력만 덮어씀, 이력은 제어기 자신의 값)
+//     복귀 첫 게이트 |Δy|, 복귀 후 20 게이트 max|Δy|, 재정착 게이트 분포
+// ============================================================
+
+using Rnd = RoundNative;
+
+// 기존 동작: 출력만 덮어쓰고 Δ-form 이력은 제어기가 낸 값 그대로 (stale)
+template <class R>
+class NaiveOverride {
+public:
+    explicit NaiveOverride(float y_sat_limit, const DeltaCoeffs& k = COEFFS_HEX) : pid_(y_sat_limit, k) {}
+
+    float step(float w, float x) {
+        const float y = pid_.step(w, x);
+        return man_ ? std::clamp(y_man_, -pid_.y_sat_limit(), pid_.y_sat_limit()) : y;
+    }
+
+    void set_manual(bool on) { man_ = on; }
+    void set_y_man(float y)  { y_man_ = y; }
+    void set_coeffs(const DeltaCoeffs& k) { pid_.set_coeffs(k); }
+
+private:
+    DeltaPid2TapAw<R> pid_;
+    bool  man_   = false;
+    float y_man_ = 0.0f;
+};
+
+template <template <class> class Ctrl>
+using Loop = ClosedLoop<EncoderFloor, Ctrl, Rnd, LoadPlant>;
+
+// ---- 1) 모델 ----
+static bool check_model(long steps) {
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> uw(-120.0f, 120.0f), uy(-16.0f, 16.0f);
+    long bad = 0, bad_n = 0, man_steps = 0;
+
+    DeltaPid2TapAw<Rnd> a(YSAT), ref(YSAT);
+    bool man = false;
+    float ym = 0.0f, w = 50.0f;
+    for (long n = 0; n < steps; ++n) {
+        if (rng() % 97 == 0) man = !man;
+        if (rng() % 13 == 0) ym = uy(rng);
+        if (rng() % 211 == 0) w = uw(rng);
+        const float x = Rnd::mul((float)((int)(rng() % 200) - 100), INT2RADS);
+        a.set_manual(man);
+        a.set_y_man(ym);
+        const float ya = a.step(w, x);
+        float yr = ref.step(w, x);
+        if (man) {
+            DeltaPidState s = ref.snapshot();
+            yr = std::clamp(ym + 0.0f, -YSAT, YSAT);
+            s.y_unsat_1 = s.y_sat_1 = yr;
+            ref.restore(s);
+            ++man_steps;
+        }
+        if (f32_to_hex(ya) != f32_to_hex(yr)) ++bad;
+        const DeltaPidState sa = a.snapshot(), sr = ref.snapshot();
+        if (std::memcmp(&sa, &sr, sizeof(sa)) != 0) ++bad;
+    }
+
+    // step_n == 반복 step() (모드별)
+    for (int m = 0; m < 2; ++m) {
+        DeltaPid2TapAw<Rnd> p(YSAT), q(YSAT);
+        p.restore(a.snapshot());  q.restore(a.snapshot());
+        p.set_manual(m);  q.set_manual(m);
+        p.set_y_man(3.25f);  q.set_y_man(3.25f);
+        std::vector<float> xs(4096), yp(4096), yq(4096);
+        for (float& v : xs) v = Rnd::mul((float)((int)(rng() % 200) - 100), INT2RADS);
+        for (size_t i = 0; i < xs.size(); ++i) yp[i] = p.step(w, xs[i]);
+        q.step_n(w, xs, yq);
+        for (size_t i = 0; i < xs.size(); ++i) bad_n += f32_to_hex(yp[i]) != f32_to_hex(yq[i]);
+        const DeltaPidState sp = p.snapshot(), sq = q.snapshot();
+        bad_n += std::memcmp(&sp, &sq, sizeof(sp)) != 0;
+    }
+
+    std::cout << "model: " << steps << " steps (" << man_steps << " manual), vs restore-based tracking "
+              << bad << " mismatches, step_n vs step " << bad_n << ((bad || bad_n) ? "  FAIL" : "  OK") << "\n";
+    return bad == 0 && bad_n == 0;
+}
+
+// ---- 2) 레인 시나리오 ----
+struct LaneSpec {
+    float w0, w1, offset, d;
+    long  man_gates;
+};
+
+struct LaneResult {
+    float bump = NAN;          // 복귀 첫 게이트 |y - y_man|
+    float ripple = 0.0f;       // 복귀 후 20 게이트 max|Δy|
+    float step_ref = 0.0f;     // 수동 진입 전 정상상태 max|Δy| (같은 길이)
+    bool  sat_first = false;   // 복귀 첫 게이트가 포화
+    bool  exact = false;       // 복귀 첫 게이트 y == y_man + Δy (추종 쪽만)
+    long  resettle = -1;
+};
+
+template <class Lane>
+static Scenario manual_auto(Lane& L, const LaneSpec& sp, LaneResult& r) {
+    L.set_w(sp.w0);
+    co_await until_settled();
+    float prev = L.y;
+    for (int i = 0; i < 20; ++i) {
+        co_await gates(1);
+        r.step_ref = std::max(r.step_ref, std::fabs(L.y - prev));
+        prev = L.y;
+    }
+
+    // 수동: 현재 출력 + 오프셋 (0 이면 hold)
+    const float y_man = L.y + sp.offset;
+    L.controller().set_y_man(y_man);
+    L.controller().set_manual(true);
+    co_await gates(sp.man_gates / 2);
+    L.set_w(sp.w1);                                  // 수동 중 목표 변경 (w1 == w0 이면 무변화)
+    L.plant().d = sp.d;                              // 수동 중 부하 변화
+    co_await gates(sp.man_gates - sp.man_gates / 2);
+
+    const float y_hold = L.y;
+    L.controller().set_manual(false);
+    co_await gates(1);
+    r.bump = std::fabs(L.y - y_hold);
+    r.sat_first = std::fabs(L.y) >= YSAT;
+    if constexpr (requires { L.controller().snapshot(); })
+        r.exact = f32_to_hex(L.y) == f32_to_hex(Rnd::add(y_hold, L.controller().snapshot().dy1));
+    prev = L.y;
+    const long g = L.gate;
+    for (int i = 0; i < 20; ++i) {
+        co_await gates(1);
+        r.ripple = std::max(r.ripple, std::fabs(L.y - prev));
+        prev = L.y;
+    }
+    if (co_await until_settled(0.02f, 20, 6000)) r.resettle = L.gate - g;
+}
+
+static std::vector<LaneSpec> make_specs(size_t N) {
+    std::vector<LaneSpec> v(N);
+    for (size_t i = 0; i < N; ++i) {
+        LaneSpec& s = v[i];
+        s.w0        = 30.0f + 70.0f * (float)(i % 13) / 12.0f;
+        s.w1        = (i % 3 == 0) ? s.w0 * (0.6f + 0.1f * (float)(i % 7)) : s.w0;
+        s.offset    = (i % 4 == 0) ? 0.0f : -4.0f + 8.0f * (float)(i % 17) / 16.0f;
+        s.d         = (i % 5 == 0) ? 20.0f + 5.0f * (float)(i % 9) : 0.0f;
+        s.man_gates = 200 + 50 * (long)(i % 9);
+    }
+    return v;
+}
+
+template <template <class> class Ctrl>
+static std::vector<LaneResult> run_bank(const std::vector<LaneSpec>& specs, size_t& unfinished) {
+    const float Ts = 0.005f;
+    const size_t N = specs.size();
+    std::vector<LaneResult> res(N);
+    ScenarioBank<Loop<Ctrl>> bank(N);
+    for (size_t i = 0; i < N; ++i) {
+        const Loop<Ctrl> proto(EncoderFloor<Rnd>(Ts), Ctrl<Rnd>(YSAT),
+                               LoadPlant<Rnd>(40.0f + (float)(i % 31), 4.0f + 0.05f * (float)(i % 41), Ts));
+        bank.spawn(proto, [&, i](auto& L) { return manual_auto(L, specs[i], res[i]); });
+    }
+    unfinished = bank.run(40000);
+    return res;
+}
+
+template <class F>
+static std::vector<float> pick(const std::vector<LaneResult>& r, F f) {
+    std::vector<float> v;
+    for (const LaneResult& x : r) { const float a = f(x); if (!std::isnan(a) && a >= 0.0f) v.push_back(a); }
+    std::sort(v.begin(), v.end());
+    return v;
+}
+
+static void dist_row(const char* name, const std::vector<float>& v) {
+    auto q = [&](double p) { return v.empty() ? NAN : v[(size_t)(p * (double)(v.size() - 1))]; };
+    std::cout << "  " << std::left << std::setw(22) << name << std::right << std::setw(10) << q(0.5)
+              << std::setw(10) << q(0.9) << std::setw(10) << q(1.0) << std::setw(7) << v.size() << "\n";
+}
+
+int main(int argc, char** argv) {
+    const size_t N = (argc > 1) ? (size_t)std::atol(argv[1]) : 4000;
+
+    bool ok = check_model(2'000'000);
+
+    const std::vector<LaneSpec> specs = make_specs(N);
+    size_t left_t = 0, left_n = 0;
+    const std::vector<LaneResult> trk = run_bank<DeltaPid2TapAw>(specs, left_t);
+    const std::vector<LaneResult> nav = run_bank<NaiveOverride>(specs, left_n);
+
+    std::cout << "\nlanes=" << N << "  unfinished: tracking " << left_t << ", naive " << left_n << "\n"
+              << std::fixed << std::setprecision(3)
+              << "                              p50       p90       max      n\n";
+    std::cout << "auto steady max|dy| [V]\n";
+    dist_row("(reference)", pick(trk, [](const LaneResult& r) { return r.step_ref; }));
+    std::cout << "return bump |y - y_man| [V]\n";
+    dist_row("tracking (RTL)", pick(trk, [](const LaneResult& r) { return r.bump; }));
+    dist_row("naive (stale hist)", pick(nav, [](const LaneResult& r) { return r.bump; }));
+    std::cout << "20 gates after return max|dy| [V]\n";
+    dist_row("tracking (RTL)", pick(trk, [](const LaneResult& r) { return r.ripple; }));
+    dist_row("naive (stale hist)", pick(nav, [](const LaneResult& r) { return r.ripple; }));
+    std::cout << "re-settle [gates] (timeout 제외)\n";
+    dist_row("tracking (RTL)", pick(trk, [](const LaneResult& r) { return (float)r.resettle; }));
+    dist_row("naive (stale hist)", pick(nav, [](const LaneResult& r) { return (float)r.resettle; }));
+
+    // 추종 쪽 복귀 첫 게이트는 y_man + Δy 그대로 (포화되지 않은 레인)
+    long over = 0, sat = 0;
+    for (const LaneResult& r : trk) {
+        if (r.sat_first) { ++sat; continue; }
+        over += !r.exact;
+    }
+    const bool bounded = over == 0;
+    std::cout << "tracking first auto y == y_man + dy: " << N - sat - over << "/" << N - sat
+              << " (saturated " << sat << ")" << (bounded ? "  OK" : "  FAIL") << "\n";
+    ok &= bounded && left_t == 0;
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ============================================================
+//  Calendar queue (R. Brown, 1988)
+//  - 버킷 = 시간폭 width 의 "하루", nb 개 버킷 = "1년"
+//  - 각 버킷은 내림차순 정렬 → pop_back 이 최소
+//  - 이벤트 수가 버킷 수의 2배/절반을 넘으면 버킷 수와 폭을 재추정
+//  - 동일 시각은 (prio, seq) 로 결정적 순서
+// ============================================================
+
+struct DesEvent {
+    uint64_t t;      // 클록 사이클
+    uint8_t  prio;   // 같은 사이클 내 처리 순서 (작을수록 먼저)
+    uint64_t seq;    // 삽입 순서
+    uint16_t kind;
+    uint32_t gen;    // 무효화용 세대 번호
+    int64_t  arg;
+};
+
+class CalendarQueue {
+public:
+    explicit CalendarQueue(size_t nb = 64, uint64_t width = 1024) { rebuild(nb, width); }
+
+    size_t size()  const { return n_; }
+    bool   empty() const { return n_ == 0; }
+
+    void push(DesEvent e) {
+        e.seq = seq_++;
+        insert(e);
+        ++n_;
+        if (n_ > 2 * nb_) resize(nb_ * 2);
+    }
+
+    DesEvent pop() {
+        for (;;) {
+            for (size_t i = 0; i < nb_; ++i) {
+                std::vector<DesEvent>& b = bkt_[cur_];
+                if (!b.empty() && b.back().t < cur_top_) {
+                    DesEvent e = b.back();
+                    b.pop_back();
+                    --n_;
+                    last_t_ = e.t;
+                    if (nb_ > 64 && n_ < nb_ / 2) resize(nb_ / 2);
+                    return e;
+                }
+                cur_ = (cur_ + 1) & (nb_ - 1);
+                cur_top_ += width_;
+            }
+            // 1년 내 없음 → 전체 최소로 점프
+            size_t best = nb_;
+            for (size_t i = 0; i < nb_; ++i)
+                if (!bkt_[i].empty() && (best == nb_ || before(bkt_[i].back(), bkt_[best].back()))) best = i;
+            const uint64_t t = bkt_[best].back().t;
+            cur_     = best;
+            cur_top_ = (t / width_ + 1) * width_;
+        }
+    }
+
+private:
+    static bool before(const DesEvent& a, const DesEvent& b) {
+        if (a.t != b.t)       return a.t < b.t;
+        if (a.prio != b.prio) return a.prio < b.prio;
+        return a.seq < b.seq;
+    }
+
+    void insert(const DesEvent& e) {
+        std::vector<DesEvent>& b = bkt_[(e.t / width_) & (nb_ - 1)];
+        // 내림차순 유지: e 보다 "나중" 인 것들 뒤에 삽입
+        auto it = std::upper_bound(b.begin(), b.end(), e,
+                                   [](const DesEvent& x, const DesEvent& y) { return before(y, x); });
+        b.insert(it, e);
+    }
+
+    void rebuild(size_t nb, uint64_t width) {
+        nb_    = nb;
+        width_ = std::max<uint64_t>(1, width);
+        bkt_.assign(nb_, {});
+        cur_     = (last_t_ / width_) & (nb_ - 1);
+        cur_top_ = (last_t_ / width_ + 1) * width_;
+    }
+
+    // 가장 이른 이벤트들의 평균 간격으로 폭 재추정
+    void resize(size_t nb) {
+        std::vector<DesEvent> all;
+        all.reserve(n_);
+        for (auto& b : bkt_) all.insert(all.end(), b.begin(), b.end());
+        std::sort(all.begin(), all.end(), before);
+
+        uint64_t width = width_;
+        const size_t m = std::min<size_t>(all.size(), 32);
+        if (m >= 2) {
+            const uint64_t span = all[m - 1].t - all[0].t;
+            if (span > 0) width = std::max<uint64_t>(1, 3 * span / (m - 1));
+        }
+        rebuild(nb, width);
+        for (const DesEvent& e : all) insert(e);
+    }
+
+    std::vector<std::vector<DesEvent>> bkt_;
+    size_t   nb_      = 0;
+    uint64_t width_   = 1;
+    size_t   cur_     = 0;
+    uint64_t cur_top_ = 0;
+    uint64_t last_t_  = 0;
+    uint64_t seq_     = 0;
+    size_t   n_       = 0;
+};
@@ -0,0 +1,138 @@
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "capture_pipeline.hpp"
+#include "closed_loop.hpp"
+
+// ============================================================
+//  하드웨어 캡처 분석 (단계 파이프라인) + 합성 캡처 생성
+//  - 빌드: g++ -O2 -std=c++20 -fno-fast-math -ffp-contract=off -pthread capture_analyze.cpp
+//  - 사용: ./a.out gen <out.cap> <frames> [fault_every]
+//            DeltaClosedLoop<RoundNative> 로 캡처 합성. fault_every > 0 이면
+//            그 간격마다 y 1ulp 변조 / 프레임 바이트 손상(CRC) / 프레임 누락을 돌아가며 주입
+//          ./a.out <in.cap> [--serial|--pipe] [--tol ulp] [--block frames] [--pin]
+//            기본은 둘 다 실행해 결과가 같은지 확인하고 단계별 처리량 비교
+//  - 직렬 wall ≈ 단계 busy 합, 파이프라인 wall 하한 ≈ 가장 느린 단계 busy
+//    (단계 수 이상의 코어가 있을 때. 코어가 적으면 직렬과 비슷하거나 느림)
+// ============================================================
+
+static int generate(const std::string& path, long frames, long fault_every) {
+    CaptureHeader h;
+    CaptureWriter out;
+    if (!out.open(path, h)) { std::cerr << path << ": open 실패\n"; return 1; }
+
+    DeltaClosedLoop<RoundNative> loop(EncoderFloor<RoundNative>(h.Ts),
+                                      DeltaPid2TapAw<RoundNative>(h.ysat, h.k),
+                                      FirstOrderPlant<RoundNative>(50.0f, 5.0f, h.Ts));
+    // 4000 게이트마다 목표 변경 (0.2~1.0 × W_TGT, 부호 반전 포함)
+    uint32_t lcg = 12345;
+    float w = W_TGT;
+    long faults[3] = {};
+    for (long n = 0; n < frames; ++n) {
+        if (n % 4000 == 0 && n) {
+            lcg = lcg * 1664525u + 1013904223u;
+            w = W_TGT * (0.2f + 0.8f * (float)(lcg >> 8) / 16777216.0f) * ((lcg & 1) ? -1.0f : 1.0f);
+        }
+        const GateSample s = loop.step(w);
+        const int kind = (fault_every > 0 && n % fault_every == fault_every - 1) ? (int)((n / fault_every) % 3) : -1;
+        if (kind == 2) { ++faults[2]; continue; }                  // 누락
+        uint8_t* p = out.frame();
+        capture_encode_frame(p, (uint32_t)n, s.w, s.spdcnt,
+                             kind == 0 ? f32_from_hex(f32_to_hex(s.y) ^ 1u) : s.y);
+        if (kind == 1) p[5] ^= 0x10;                               // CRC 불일치
+        if (kind >= 0) ++faults[kind];
+    }
+    if (!out.close()) { std::cerr << path << ": 쓰기 실패\n"; return 1; }
+    std::cout << path << ": " << frames << " frames  ("
+              << (double)(CaptureHeader::BYTES + (frames - faults[2]) * CAPTURE_FRAME_BYTES) / 1e6 << " MB)"
+              << "  faults: y-ulp=" << faults[0] << " crc=" << faults[1] << " drop=" << faults[2] << "\n";
+    return 0;
+}
+
+static void print(const char* tag, const CaptureReport& r) {
+    const CaptureMetrics& m = r.metrics;
+    const double mb = (double)r.bytes / 1e6;
+    std::cout << "[" << tag << "] wall " << std::fixed << std::setprecision(3) << r.wall_s << " s  "
+              << std::setprecision(1) << mb / r.wall_s << " MB/s  "
+              << (double)m.frames / r.wall_s / 1e6 << " Mframe/s\n";
+    std::cout << "    stage        busy[s]   Mframe/s  batches\n";
+    double sum = 0.0;
+    for (int i = 0; i < CaptureReport::N_STAGES; ++i) {
+        const StageStats& s = r.stage[i];
+        sum += s.busy_s;
+        std::cout << "    " << std::left << std::setw(11) << s.name << std::right
+                  << std::setprecision(3) << std::setw(9) << s.busy_s
+                  << std::setprecision(1) << std::setw(11) << (double)m.frames / std::max(s.busy_s, 1e-9) / 1e6
+                  << std::setw(9) << s.batches << (i == r.bottleneck() ? "  <- bottleneck" : "") << "\n";
+    }
+    std::cout << std::setprecision(3) << "    Σbusy " << sum << " s   slowest stage " << r.stage[r.bottleneck()].busy_s
+              << " s   (ideal speedup " << std::setprecision(2) << sum / r.stage[r.bottleneck()].busy_s << "x)\n";
+}
+
+static void summary(const CaptureMetrics& m) {
+    std::cout << std::defaultfloat << std::setprecision(6);
+    std::cout << "frames=" << m.frames << "  compared=" << m.compared << "  exact=" << m.exact
+              << "  mismatch=" << m.mismatch << "  warmup=" << m.warmup << "\n";
+    std::cout << "gaps=" << m.gaps << "  bad_crc=" << m.bad_crc << "  torn_bytes=" << m.torn_bytes
+              << "  first_mismatch_seq=" << m.first_mismatch << "\n";
+    std::cout << "max_ulp=" << m.max_ulp << "  max|dy|=" << m.max_abs << "  IAE=" << m.iae
+              << "  effort=" << m.effort << "  sat_ratio=" << (double)m.sat / (double)std::max<uint64_t>(1, m.frames) << "\n";
+    std::cout << "ulp histogram:";
+    for (int b = 0; b < CaptureMetrics::ULP_BUCKETS; ++b) {
+        if (!m.ulp_hist[b]) continue;
+        if (b == 0)                                      std::cout << "  0:";
+        else if (b == CaptureMetricsAcc::ULP_NAN)        std::cout << "  NaN:";
+        else                                             std::cout << "  <2^" << b << ":";
+        std::cout << m.ulp_hist[b];
+    }
+    std::cout << "\n";
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " gen <out.cap> <frames> [fault_every]\n"
+                  << "       " << argv[0] << " <in.cap> [--serial|--pipe] [--tol ulp] [--block frames] [--pin]\n";
+        return 2;
+    }
+    if (!std::strcmp(argv[1], "gen")) {
+        if (argc < 4) { std::cerr << "gen <out.cap> <frames> [fault_every]\n"; return 2; }
+        return generate(argv[2], std::atol(argv[3]), argc > 4 ? std::atol(argv[4]) : 0);
+    }
+
+    CapturePipeline::Options opt;
+    bool serial = true, pipe = true;
+    for (int i = 2; i < argc; ++i) {
+        if      (!std::strcmp(argv[i], "--serial"))              pipe = false;
+        else if (!std::strcmp(argv[i], "--pipe"))                serial = false;
+        else if (!std::strcmp(argv[i], "--pin"))                 opt.pin = true;
+        else if (!std::strcmp(argv[i], "--tol") && i + 1 < argc)   opt.tol_ulp = (uint32_t)std::atol(argv[++i]);
+        else if (!std::strcmp(argv[i], "--block") && i + 1 < argc) opt.block_frames = (size_t)std::atol(argv[++i]);
+        else { std::cerr << "unknown option " << argv[i] << "\n"; return 2; }
+    }
+
+    const CapturePipeline pl(opt);
+    std::cout << "cores=" << std::thread::hardware_concurrency() << "  block=" << opt.block_frames
+              << " frames (" << opt.block_frames * CAPTURE_FRAME_BYTES / 1024 << " KB)\n";
+    CaptureReport rs, rp;
+    if (serial) {
+        rs = pl.run_serial(argv[1]);
+        if (!rs.ok) { std::cerr << rs.err << "\n"; return 1; }
+        print("serial", rs);
+    }
+    if (pipe) {
+        rp = pl.run_pipelined(argv[1]);
+        if (!rp.ok) { std::cerr << rp.err << "\n"; return 1; }
+        print("pipelined", rp);
+    }
+    summary(pipe ? rp.metrics : rs.metrics);
+    if (serial && pipe) {
+        const bool same = rs.metrics == rp.metrics;
+        std::cout << "serial vs pipelined: " << (same ? "SAME" : "DIFF") << "   wall ratio "
+                  << std::setprecision(3) << rs.wall_s / rp.wall_s << "x\n";
+        if (!same) return 1;
+    }
+    return rp.metrics.mismatch || rs.metrics.mismatch ? 3 : 0;
+}
@@ -0,0 +1,505 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+
+#include "pid_model.hpp"
+#include "spsc_queue.hpp"
+#include "sweep_log.hpp"   // crc32_ieee
+
+// ============================================================
+//  하드웨어 텔레메트리 캡처 분석 파이프라인
+//  - 캡처 파일 = 헤더 1개 + 고정 길이 프레임 열 (리틀 엔디언)
+//      헤더   : "PIDCAPT1" | ver u32 | Ts f32 | ysat f32 | coeffs f32[9] | crc u32
+//      프레임 : seq u32 | w f32 | spdcnt i32 | y f32 | crc u32 (seq~y)
+//      (게이트마다 한 프레임: 하드웨어가 본 w, spdcnt 와 내보낸 y)
+//  - 단계: reader → decoder → replay → comparator → metrics
+//      reader     : 블록 단위 read() (블록 = 프레임 길이의 배수)
+//      decoder    : CRC 확인, 깨진 프레임 버림, seq 건너뜀 → GAP 표시
+//      replay     : x = spdcnt·INT2RADS, DeltaPid2TapAw<RoundNative> 재생
+//                   GAP 뒤 두 프레임은 워밍업 — 하드웨어 y 로 이력 복원
+//      comparator : y_model 대 y_hw ulp 거리
+//      metrics    : 분류/히스토그램/IAE/effort/포화 누적
+//  - 단계 사이는 SpscQueue<포인터> (배치 단위 전달), 버퍼는 풀에서 순환
+//      raw  : reader → decoder → (반납) reader
+//      batch: decoder → replay → comparator → metrics → (반납) decoder
+//  - run_serial / run_pipelined 는 같은 단계 객체를 쓰므로 결과 비트 동일
+//  - 처리량 상한 = 가장 느린 단계 (코어가 단계 수 이상일 때). 단계별
+//    busy 시간을 따로 재서 병목을 보고한다
+// ============================================================
+
+struct CaptureHeader {
+    uint32_t    version = VERSION;
+    float       Ts      = 0.005f;
+    float       ysat    = YSAT;
+    DeltaCoeffs k       = COEFFS_HEX;
+
+    static constexpr uint32_t VERSION = 1;
+    static constexpr size_t   BYTES   = 8 + 4 + 4 + 4 + 36 + 4;
+
+    void encode(uint8_t* b) const {
+        std::memcpy(b, "PIDCAPT1", 8);
+        std::memcpy(b + 8,  &version, 4);
+        std::memcpy(b + 12, &Ts, 4);
+        std::memcpy(b + 16, &ysat, 4);
+        std::memcpy(b + 20, &k, 36);
+        const uint32_t c = crc32_ieee(b, 56);
+        std::memcpy(b + 56, &c, 4);
+    }
+
+    bool decode(const uint8_t* b) {
+        uint32_t c;
+        std::memcpy(&c, b + 56, 4);
+        if (std::memcmp(b, "PIDCAPT1", 8) != 0 || c != crc32_ieee(b, 56)) return false;
+        std::memcpy(&version, b + 8, 4);
+        std::memcpy(&Ts, b + 12, 4);
+        std::memcpy(&ysat, b + 16, 4);
+        std::memcpy(&k, b + 20, 36);
+        return version == VERSION;
+    }
+};
+
+static constexpr size_t CAPTURE_FRAME_BYTES = 20;
+
+static inline void capture_encode_frame(uint8_t* p, uint32_t seq, float w, int32_t spdcnt, float y) {
+    std::memcpy(p, &seq, 4);
+    std::memcpy(p + 4, &w, 4);
+    std::memcpy(p + 8, &spdcnt, 4);
+    std::memcpy(p + 12, &y, 4);
+    const uint32_t c = crc32_ieee(p, 16);
+    std::memcpy(p + 16, &c, 4);
+}
+
+// 생성/변환용 버퍼드 기록기
+class CaptureWriter {
+public:
+    CaptureWriter() = default;
+    CaptureWriter(const CaptureWriter&) = delete;
+    CaptureWriter& operator=(const CaptureWriter&) = delete;
+    ~CaptureWriter() { close(); }
+
+    bool open(const std::string& path, const CaptureHeader& h) {
+        close();
+        fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd_ < 0) return false;
+        buf_.resize(1 << 20);
+        h.encode(buf_.data());
+        n_ = CaptureHeader::BYTES;
+        return true;
+    }
+
+    // 프레임 자리 (seq~crc 는 호출부가 capture_encode_frame 으로 채움)
+    uint8_t* frame() {
+        if (n_ + CAPTURE_FRAME_BYTES > buf_.size()) flush();
+        uint8_t* p = buf_.data() + n_;
+        n_ += CAPTURE_FRAME_BYTES;
+        return p;
+    }
+
+    void append(uint32_t seq, float w, int32_t spdcnt, float y) { capture_encode_frame(frame(), seq, w, spdcnt, y); }
+
+    bool close() {
+        if (fd_ < 0) return true;
+        flush();
+        const bool ok = ok_ && ::close(fd_) == 0;
+        fd_ = -1;
+        return ok;
+    }
+
+private:
+    void flush() {
+        size_t off = 0;
+        while (off < n_) {
+            const ssize_t w = ::write(fd_, buf_.data() + off, n_ - off);
+            if (w <= 0) { ok_ = false; break; }
+            off += (size_t)w;
+        }
+        n_ = 0;
+    }
+
+    int                  fd_ = -1;
+    bool                 ok_ = true;
+    std::vector<uint8_t> buf_;
+    size_t               n_ = 0;
+};
+
+// ------------------------------------------------------------
+//  단계 사이를 흐르는 버퍼
+// ------------------------------------------------------------
+struct RawBlock {
+    std::vector<uint8_t> b;
+    size_t               n    = 0;
+    bool                 last = false;
+};
+
+struct CaptureFrame {
+    enum : uint8_t { GAP = 1, WARMUP = 2, MISMATCH = 4 };
+
+    uint32_t seq;
+    int32_t  spdcnt;
+    float    w, x, y_hw, y_model;
+    uint32_t ulp;
+    uint8_t  flags;
+};
+
+struct FrameBatch {
+    std::vector<CaptureFrame> f;
+    size_t                    n       = 0;
+    uint32_t                  bad_crc = 0;   // 이 블록에서 버린 프레임
+    uint32_t                  torn    = 0;   // 파일 끝 불완전 프레임 바이트
+    bool                      last    = false;
+};
+
+// FP32 순서 보존 정수 거리 (NaN 은 최대)
+static inline uint32_t ulp_distance(float a, float b) {
+    if (std::isnan(a) || std::isnan(b)) return UINT32_MAX;
+    auto ord = [](float f) {
+        const int32_t i = (int32_t)f32_to_hex(f);
+        return (int64_t)(i < 0 ? INT32_MIN - i : i);
+    };
+    const int64_t d = std::llabs(ord(a) - ord(b));
+    return (uint32_t)std::min<int64_t>(d, UINT32_MAX);
+}
+
+// ------------------------------------------------------------
+//  단계 객체 (스레드와 무관한 순수 처리)
+// ------------------------------------------------------------
+class CaptureDecoder {
+public:
+    void process(const RawBlock& r, FrameBatch& out) {
+        const size_t nf = r.n / CAPTURE_FRAME_BYTES;
+        out.f.resize(std::max(out.f.size(), nf));
+        out.n = 0;
+        out.bad_crc = 0;
+        out.torn = (uint32_t)(r.n - nf * CAPTURE_FRAME_BYTES);
+        out.last = r.last;
+        const uint8_t* p = r.b.data();
+        for (size_t i = 0; i < nf; ++i, p += CAPTURE_FRAME_BYTES) {
+            uint32_t c;
+            std::memcpy(&c, p + 16, 4);
+            if (c != crc32_ieee(p, 16)) { ++out.bad_crc; continue; }
+            CaptureFrame& f = out.f[out.n++];
+            std::memcpy(&f.seq, p, 4);
+            std::memcpy(&f.w, p + 4, 4);
+            std::memcpy(&f.spdcnt, p + 8, 4);
+            std::memcpy(&f.y_hw, p + 12, 4);
+            f.flags = (f.seq != next_) ? CaptureFrame::GAP : 0;
+            next_ = f.seq + 1;
+        }
+    }
+
+private:
+    uint32_t next_ = 0;    // 캡처는 리셋 직후 seq 0 부터
+};
+
+class CaptureReplay {
+public:
+    explicit CaptureReplay(const CaptureHeader& h) : ctrl_(h.ysat, h.k) {}
+
+    void process(FrameBatch& b) {
+        for (size_t i = 0; i < b.n; ++i) {
+            CaptureFrame& f = b.f[i];
+            f.x = RoundNative::mul((float)f.spdcnt, INT2RADS);
+            if (f.flags & CaptureFrame::GAP) warm_ = 2;
+            if (warm_ == 0) { f.y_model = ctrl_.step(f.w, f.x); continue; }
+
+            // 워밍업: 직전 두 프레임으로 이력 복원 (비포화 가정, y_unsat = y_sat)
+            f.flags  |= CaptureFrame::WARMUP;
+            f.y_model = f.y_hw;
+            p2_ = p1_;
+            p1_ = f;
+            if (--warm_ == 0) {
+                ctrl_.restore(DeltaPidState{ RoundNative::add(p1_.y_hw, -p2_.y_hw),
+                                             p1_.w, p2_.w, p1_.x, p2_.x,
+                                             p1_.y_hw, p2_.y_hw, p1_.y_hw, p2_.y_hw });
+            }
+        }
+    }
+
+private:
+    DeltaPid2TapAw<RoundNative> ctrl_;
+    int                         warm_ = 0;
+    CaptureFrame                p1_{}, p2_{};
+};
+
+class CaptureComparator {
+public:
+    explicit CaptureComparator(uint32_t tol_ulp) : tol_(tol_ulp) {}
+
+    void process(FrameBatch& b) const {
+        for (size_t i = 0; i < b.n; ++i) {
+            CaptureFrame& f = b.f[i];
+            f.ulp = ulp_distance(f.y_model, f.y_hw);
+            if (f.ulp > tol_) f.flags |= CaptureFrame::MISMATCH;
+        }
+    }
+
+private:
+    uint32_t tol_;
+};
+
+struct CaptureMetrics {
+    static constexpr int ULP_BUCKETS = 34;   // 0, [1,2), [2,4) ... [2^31,2^32), NaN
+
+    uint64_t frames = 0, compared = 0, exact = 0, mismatch = 0, warmup = 0;
+    uint64_t gaps = 0, bad_crc = 0, torn_bytes = 0, sat = 0;
+    uint64_t ulp_hist[ULP_BUCKETS] = {};
+    uint32_t max_ulp = 0;
+    int64_t  first_mismatch = -1;   // seq
+    double   max_abs = 0.0, iae = 0.0, effort = 0.0;
+
+    bool operator==(const CaptureMetrics& o) const {
+        return frames == o.frames && compared == o.compared && exact == o.exact && mismatch == o.mismatch
+            && warmup == o.warmup && gaps == o.gaps && bad_crc == o.bad_crc && torn_bytes == o.torn_bytes
+            && sat == o.sat && std::memcmp(ulp_hist, o.ulp_hist, sizeof(ulp_hist)) == 0
+            && max_ulp == o.max_ulp && first_mismatch == o.first_mismatch
+            && max_abs == o.max_abs && iae == o.iae && effort == o.effort;
+    }
+};
+
+class CaptureMetricsAcc {
+public:
+    explicit CaptureMetricsAcc(const CaptureHeader& h) : Ts_(h.Ts), ysat_(h.ysat) {}
+
+    void process(const FrameBatch& b) {
+        m_.bad_crc    += b.bad_crc;
+        m_.torn_bytes += b.torn;
+        for (size_t i = 0; i < b.n; ++i) {
+            const CaptureFrame& f = b.f[i];
+            ++m_.frames;
+            m_.iae    += std::fabs((double)f.w - (double)f.x) * Ts_;
+            m_.effort += std::fabs((double)f.y_hw - (double)y_prev_);
+            y_prev_ = f.y_hw;
+            if (std::fabs(f.y_hw) >= ysat_) ++m_.sat;
+            if (f.flags & CaptureFrame::GAP) ++m_.gaps;
+            if (f.flags & CaptureFrame::WARMUP) { ++m_.warmup; continue; }
+
+            ++m_.compared;
+            const int bucket = (f.ulp == UINT32_MAX) ? ULP_NAN : (f.ulp ? 32 - __builtin_clz(f.ulp) : 0);
+            ++m_.ulp_hist[bucket];
+            if (f.ulp == 0) ++m_.exact;
+            m_.max_ulp = std::max(m_.max_ulp, f.ulp);
+            if (f.ulp != UINT32_MAX) m_.max_abs = std::max(m_.max_abs, std::fabs((double)f.y_model - (double)f.y_hw));
+            if (f.flags & CaptureFrame::MISMATCH) {
+                ++m_.mismatch;
+                if (m_.first_mismatch < 0) m_.first_mismatch = f.seq;
+            }
+        }
+    }
+
+    const CaptureMetrics& result() const { return m_; }
+
+    static constexpr int ULP_NAN = CaptureMetrics::ULP_BUCKETS - 1;
+
+private:
+    double         Ts_, ysat_;
+    float          y_prev_ = 0.0f;
+    CaptureMetrics m_;
+};
+
+// ------------------------------------------------------------
+//  실행기
+// ------------------------------------------------------------
+struct StageStats {
+    const char* name;
+    double      busy_s = 0.0;    // process() 안에서 보낸 시간
+    uint64_t    batches = 0;
+};
+
+struct CaptureReport {
+    static constexpr int N_STAGES = 5;
+
+    CaptureHeader  header;
+    CaptureMetrics metrics;
+    StageStats     stage[N_STAGES] = { { "reader" }, { "decoder" }, { "replay" }, { "comparator" }, { "metrics" } };
+    uint64_t       bytes  = 0;
+    double         wall_s = 0.0;
+    bool           ok     = false;
+    std::string    err;
+
+    // 단계가 각자 코어를 가질 때의 이론 하한 (가장 느린 단계)
+    int bottleneck() const {
+        int b = 0;
+        for (int i = 1; i < N_STAGES; ++i) if (stage[i].busy_s > stage[b].busy_s) b = i;
+        return b;
+    }
+};
+
+class CapturePipeline {
+public:
+    struct Options {
+        size_t   block_frames = 16384;   // 블록/배치당 프레임 (블록 = ×20 B)
+        size_t   n_blocks     = 8;       // raw 블록 풀
+        size_t   n_batches    = 8;       // 프레임 배치 풀
+        uint32_t tol_ulp      = 0;       // 이보다 크면 MISMATCH
+        bool     pin          = false;   // 단계 i → 코어 i (코어가 충분할 때만)
+    };
+
+    explicit CapturePipeline(const Options& opt) : opt_(opt) {}
+
+    CaptureReport run_serial(const std::string& path) const {
+        CaptureReport rep;
+        const int fd = open_capture(path, rep);
+        if (fd < 0) return rep;
+        Stages st(rep.header, opt_);
+        RawBlock   raw;
+        FrameBatch batch;
+        raw.b.resize(opt_.block_frames * CAPTURE_FRAME_BYTES);
+        const auto t0 = std::chrono::steady_clock::now();
+        do {
+            timed(rep.stage[0], [&] { read_block(fd, raw, rep); });
+            timed(rep.stage[1], [&] { st.dec.process(raw, batch); });
+            timed(rep.stage[2], [&] { st.rep.process(batch); });
+            timed(rep.stage[3], [&] { st.cmp.process(batch); });
+            timed(rep.stage[4], [&] { st.met.process(batch); });
+        } while (!raw.last);
+        rep.wall_s  = seconds_since(t0);
+        rep.metrics = st.met.result();
+        ::close(fd);
+        return finish(rep);
+    }
+
+    CaptureReport run_pipelined(const std::string& path) const {
+        CaptureReport rep;
+        const int fd = open_capture(path, rep);
+        if (fd < 0) return rep;
+        Stages st(rep.header, opt_);
+
+        std::vector<RawBlock>   raws(opt_.n_blocks);
+        std::vector<FrameBatch> batches(opt_.n_batches);
+        const size_t qn = std::max(opt_.n_blocks, opt_.n_batches);
+        SpscQueue<RawBlock*>   raw_free(qn), raw_full(qn);
+        SpscQueue<FrameBatch*> batch_free(qn), q_dec(qn), q_rep(qn), q_cmp(qn);
+        for (RawBlock& r : raws) { r.b.resize(opt_.block_frames * CAPTURE_FRAME_BYTES); raw_free.push(&r); }
+        for (FrameBatch& b : batches) batch_free.push(&b);
+
+        const auto t0 = std::chrono::steady_clock::now();
+        std::thread th[CaptureReport::N_STAGES];
+
+        th[0] = std::thread([&] {
+            pin(0);
+            for (;;) {
+                RawBlock* r = raw_free.pop();
+                timed(rep.stage[0], [&] { read_block(fd, *r, rep); });
+                raw_full.push(r);
+                if (r->last) break;
+            }
+        });
+        th[1] = std::thread([&] {
+            pin(1);
+            RawBlock* in[8];
+            for (bool last = false; !last; ) {
+                const size_t n = raw_full.pop_wait(in, 8);
+                for (size_t i = 0; i < n; ++i) {
+                    FrameBatch* b = batch_free.pop();
+                    timed(rep.stage[1], [&] { st.dec.process(*in[i], *b); });
+                    last = in[i]->last;
+                    raw_free.push(in[i]);
+                    q_dec.push(b);
+                }
+            }
+        });
+        th[2] = std::thread([&] { pin(2); relay(q_dec, q_rep, rep.stage[2], [&](FrameBatch& b) { st.rep.process(b); }); });
+        th[3] = std::thread([&] { pin(3); relay(q_rep, q_cmp, rep.stage[3], [&](FrameBatch& b) { st.cmp.process(b); }); });
+        th[4] = std::thread([&] { pin(4); relay(q_cmp, batch_free, rep.stage[4], [&](FrameBatch& b) { st.met.process(b); }); });
+        for (auto& t : th) t.join();
+
+        rep.wall_s  = seconds_since(t0);
+        rep.metrics = st.met.result();
+        ::close(fd);
+        return finish(rep);
+    }
+
+private:
+    struct Stages {
+        CaptureDecoder    dec;
+        CaptureReplay     rep;
+        CaptureComparator cmp;
+        CaptureMetricsAcc met;
+        Stages(const CaptureHeader& h, const Options& o) : rep(h), cmp(o.tol_ulp), met(h) {}
+    };
+
+    // 배치 포인터를 한 번에 여러 개 받아 처리 후 다음 큐로
+    template <class F>
+    static void relay(SpscQueue<FrameBatch*>& in, SpscQueue<FrameBatch*>& out, StageStats& s, F&& f) {
+        FrameBatch* b[8];
+        for (bool last = false; !last; ) {
+            const size_t n = in.pop_wait(b, 8);
+            for (size_t i = 0; i < n; ++i) {
+                timed(s, [&] { f(*b[i]); });
+                last = last || b[i]->last;
+            }
+            for (size_t i = 0, spin = 0; i < n; ) {
+                const size_t k = out.push_n(b + i, n - i);
+                i += k;
+                if (!k) SpscQueue<FrameBatch*>::backoff((int)spin++);
+            }
+        }
+    }
+
+    template <class F>
+    static void timed(StageStats& s, F&& f) {
+        const auto t0 = std::chrono::steady_clock::now();
+        f();
+        s.busy_s += seconds_since(t0);
+        ++s.batches;
+    }
+
+    static double seconds_since(std::chrono::steady_clock::time_point t0) {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    }
+
+    void pin(int stage) const {
+        const unsigned hw = std::thread::hardware_concurrency();
+        if (!opt_.pin || hw < (unsigned)CaptureReport::N_STAGES) return;
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(stage, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+    }
+
+    static int open_capture(const std::string& path, CaptureReport& rep) {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) { rep.err = path + ": open 실패"; return -1; }
+        uint8_t h[CaptureHeader::BYTES];
+        if (::read(fd, h, sizeof(h)) != (ssize_t)sizeof(h) || !rep.header.decode(h)) {
+            rep.err = path + ": 캡처 헤더 손상 또는 캡처 파일 아님";
+            ::close(fd);
+            return -1;
+        }
+        rep.bytes = CaptureHeader::BYTES;
+        ::posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+        return fd;
+    }
+
+    // 블록이 가득 차거나 EOF 까지 read() (짧은 읽기 흡수)
+    static void read_block(int fd, RawBlock& r, CaptureReport& rep) {
+        r.n = 0;
+        while (r.n < r.b.size()) {
+            const ssize_t k = ::read(fd, r.b.data() + r.n, r.b.size() - r.n);
+            if (k <= 0) break;
+            r.n += (size_t)k;
+        }
+        r.last = r.n < r.b.size();
+        rep.bytes += r.n;
+    }
+
+    static CaptureReport& finish(CaptureReport& rep) {
+        rep.ok = true;
+        return rep;
+    }
+
+    Options opt_;
+};
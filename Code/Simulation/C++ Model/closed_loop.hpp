@@ -0,0 +1,173 @@
+#pragma once
+
+#include <algorithm>
+#include <random>
+
+#include "hot_probe.hpp"
+#include "pid_model.hpp"
+
+// ============================================================
+//  ClosedLoop<EncoderPolicy, ControllerPolicy, RoundingPolicy, PlantPolicy>
+//  - 엔코더 → 컨트롤러 → 식물 한 게이트를 정적 합성 (가상 호출 없음)
+//  - 각 Policy는 RoundingPolicy 로 인스턴스화되어 같은 라운딩 규칙을 공유
+//  - 요구 인터페이스
+//      Encoder    : sample(float x_true, int& spdcnt, float& x_meas)
+//      Controller : step(float w, float x_meas) -> float y
+//      Plant      : speed() -> float,  update(float y)
+//                   (지연 모델 사용 시 integrate(float y, float dt), Ts)
+// ============================================================
+
+// 게이트 1회 결과 (x_true 는 식물 갱신 전 값 = 엔코더가 본 속도)
+struct GateSample {
+    float w;
+    float x_true;
+    int   spdcnt;
+    float x_meas;
+    float y;
+    float tau;      // 계산 지연 [s] (y 가 식물에 걸리기까지)
+};
+
+// 게이트 고장 주입 (stimulus.hpp 의 StimFault). 기본값 = 고장 없음
+struct GateFault {
+    bool enc_loss = false;   // 엔코더 펄스 유실: 제어기는 spdcnt = 0 (x = 0) 을 봄
+    bool pwm_off  = false;   // 드라이버 비활성: 식물에 0 V (제어기는 계속 계산)
+};
+
+// ============================================================
+//  계산 지연 모델: next() → 이번 샘플의 지연 [s]
+//  - 하드웨어는 gate_pulse 후 pid_controller_axi FSM + pwm_generator
+//    파이프라인이 끝나야 새 전압이 걸린다. 그 전까지 식물은 이전 전압.
+//  - 사이클 모델 지연은 pid_cycle_model.hpp 의 cycle_model_latency()
+// ============================================================
+struct ZeroLatency {
+    float next() { return 0.0f; }
+};
+
+struct ConstantLatency {
+    float tau;
+    float next() { return tau; }
+};
+
+// base + 분포 샘플 (음수는 0 으로)
+template <class Dist = std::normal_distribution<float>>
+struct JitterLatency {
+    float        base;
+    Dist         dist;
+    std::mt19937 rng;
+
+    JitterLatency(float base_, Dist d, uint32_t seed = 1)
+        : base(base_), dist(d), rng(seed) {}
+
+    float next() { return std::max(0.0f, base + dist(rng)); }
+};
+
+template <template <class> class EncoderPolicy,
+          template <class> class ControllerPolicy,
+          class RoundingPolicy,
+          template <class> class PlantPolicy>
+class ClosedLoop {
+public:
+    using Encoder    = EncoderPolicy<RoundingPolicy>;
+    using Controller = ControllerPolicy<RoundingPolicy>;
+    using Plant      = PlantPolicy<RoundingPolicy>;
+    using Rounding   = RoundingPolicy;
+
+    ClosedLoop(const Encoder& enc, const Controller& ctrl, const Plant& plant)
+        : enc_(enc), ctrl_(ctrl), plant_(plant) {}
+
+    // 한 게이트: 샘플 → 제어 → 식물 적분
+    GateSample step(float w) { return gate<false, false>(w, 0.0f, {}); }
+
+    // 계산 지연 tau 반영: [0, tau) 이전 전압, [tau, Ts) 새 전압
+    //  - tau 는 [0, Ts] 로 제한 (FSM 이 busy 면 다음 data_valid 를 놓치므로
+    //    하드웨어에서도 한 게이트를 넘는 지연은 의미가 없다)
+    //  - tau == 0 이면 step(w) 와 비트 동일
+    GateSample step(float w, float tau) { return gate<true, false>(w, tau, {}); }
+
+    // 고장 주입 게이트. GateFault{} 면 step(w) 와 비트 동일
+    //  - y_applied() 는 식물에 실제로 걸린 전압 (pwm_off 면 0)
+    GateSample step(float w, const GateFault& f) { return gate<false, true>(w, 0.0f, f); }
+
+    // 실행 길이 예고: 컨트롤러에 prepare(steps) 가 있으면 전달 (JitDeltaPid2TapAw 선택 등)
+    void prepare(long n_gates) {
+        if constexpr (requires { ctrl_.prepare(n_gates); }) ctrl_.prepare(n_gates);
+    }
+
+    // n_gates 반복. setpoint(n) -> w, sink(n, const GateSample&)
+    // (람다를 그대로 받으므로 호출부에서 전부 인라인된다)
+    template <class Setpoint, class Sink>
+    void run(long n_gates, Setpoint&& setpoint, Sink&& sink) {
+        prepare(n_gates);
+        for (long n = 0; n < n_gates; ++n) {
+            const GateSample s = step(setpoint(n));
+            sink(n, s);
+        }
+    }
+
+    // 고정 목표값
+    template <class Sink>
+    void run(long n_gates, float w, Sink&& sink) {
+        run(n_gates, [w](long) { return w; }, sink);
+    }
+
+    // 지연 모델 사용 (Latency::next() 를 게이트마다 호출)
+    template <class Setpoint, class Latency, class Sink>
+    void run_delayed(long n_gates, Setpoint&& setpoint, Latency& latency, Sink&& sink) {
+        prepare(n_gates);
+        for (long n = 0; n < n_gates; ++n) {
+            const GateSample s = step(setpoint(n), latency.next());
+            sink(n, s);
+        }
+    }
+
+    // 식물에 현재 걸려 있는 전압 (지연 모델의 "이전 전압", 고장 게이트면 0 V 일 수 있음)
+    float y_applied() const { return y_applied_; }
+
+    Encoder&    encoder()    { return enc_; }
+    Controller& controller() { return ctrl_; }
+    Plant&      plant()      { return plant_; }
+
+    const Encoder&    encoder()    const { return enc_; }
+    const Controller& controller() const { return ctrl_; }
+    const Plant&      plant()      const { return plant_; }
+
+private:
+    // step 공용 경로 (Delayed/Faulted 가 false 면 해당 코드는 없어짐)
+    template <bool Delayed, bool Faulted>
+    GateSample gate(float w, float tau, const GateFault& f) {
+        GateSample s;
+        s.w      = w;
+        s.x_true = plant_.speed();
+        s.tau    = 0.0f;
+        if constexpr (Delayed) s.tau = std::clamp(tau, 0.0f, plant_.Ts);
+        { PID_PROBE("loop.encoder");    enc_.sample(s.x_true, s.spdcnt, s.x_meas); }
+        if constexpr (Faulted) if (f.enc_loss) { s.spdcnt = 0; s.x_meas = 0.0f; }
+        { PID_PROBE("loop.controller"); s.y = ctrl_.step(w, s.x_meas); }
+        float y_plant = s.y;
+        if constexpr (Faulted) if (f.pwm_off) y_plant = 0.0f;
+        {
+            PID_PROBE("loop.plant");
+            if constexpr (Delayed) {
+                if (s.tau > 0.0f) {
+                    plant_.integrate(y_applied_, s.tau);
+                    plant_.integrate(y_plant, Rounding::add(plant_.Ts, -s.tau));
+                } else {
+                    plant_.update(y_plant);
+                }
+            } else {
+                plant_.update(y_plant);
+            }
+        }
+        y_applied_ = y_plant;
+        return s;
+    }
+
+    Encoder    enc_;
+    Controller ctrl_;
+    Plant      plant_;
+    float      y_applied_ = 0.0f;
+};
+
+// 가장 많이 쓰는 조합 (PID_MY_DIGIT 과 동일)
+template <class Rnd = RoundVolatile>
+using DeltaClosedLoop = ClosedLoop<EncoderFloor, DeltaPid2TapAw, Rnd, FirstOrderPlant>;
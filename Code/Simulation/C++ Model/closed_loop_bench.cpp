@@ -0,0 +1,152 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <cmath>
+
+#include "closed_loop.hpp"
+#include "jit_kernel.hpp"
+
+// ============================================================
+//  ClosedLoop 조합별 처리량 vs 손으로 펼친 루프
+//  - 빌드: g++ -O2 -std=c++20 -fno-fast-math -ffp-contract=off closed_loop_bench.cpp
+//  - RoundNative 조합은 손 루프와 같은 ns/gate, 같은 y 체크섬이어야 한다.
+// ============================================================
+
+static const float Ts  = 0.005f;
+static const float Ku  = 50.0f;
+static const float lam = 5.0f;
+
+// 손으로 펼친 기준 루프 (RoundNative 와 동일 연산 순서)
+static double hand_loop(long gates, float& y_last) {
+    float dy1 = 0, w1 = 0, w2 = 0, x1 = 0, x2 = 0;
+    float yu1 = 0, yu2 = 0, ys1 = 0, ys2 = 0;
+    float theta = 0, x_true = 0;
+    long  C_prev = 0;
+    const float rad_per_cnt = INT2RADS * Ts;
+    double sum = 0.0;
+
+    for (long n = 0; n < gates; ++n) {
+        theta = std::fmaf(x_true, Ts, theta);
+        const long C_now = (long)std::floor(theta / rad_per_cnt);
+        const int  spdcnt = (int)(C_now - C_prev);
+        C_prev = C_now;
+        const float x = (float)spdcnt * INT2RADS;
+        const float w = W_TGT;
+
+        float acc = 0.0f;
+        acc = acc + C0 * dy1;
+        acc = acc + C1 * w;   acc = acc + C2 * w1;  acc = acc + C3 * w2;
+        acc = acc + C4 * x;   acc = acc + C5 * x1;  acc = acc + C6 * x2;
+        acc = acc + C7A * (ys1 + -yu1);
+        acc = acc + C7B * (ys2 + -yu2);
+        const float yu = yu1 + acc;
+        const float ys = std::clamp(yu, -YSAT, +YSAT);
+
+        dy1 = acc;
+        w2 = w1; w1 = w;
+        x2 = x1; x1 = x;
+        yu2 = yu1; yu1 = yu;
+        ys2 = ys1; ys1 = ys;
+
+        x_true = x_true + Ts * (Ku * ys + -(lam * x_true));
+        sum += ys;
+        y_last = ys;
+    }
+    return sum;
+}
+
+template <class Loop>
+static double run_loop(Loop& loop, long gates, float& y_last) {
+    double sum = 0.0;
+    loop.run(gates, W_TGT, [&](long, const GateSample& s) { sum += s.y; y_last = s.y; });
+    return sum;
+}
+
+template <class F>
+static void report(const char* name, long gates, F&& f) {
+    float y_last = 0.0f;
+    const auto t0 = std::chrono::steady_clock::now();
+    const double sum = f(y_last);
+    const auto t1 = std::chrono::steady_clock::now();
+    const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count() / (double)gates;
+    std::cout << std::setw(32) << std::left << name << std::right
+              << " | " << std::setw(8) << std::setprecision(3) << ns << " ns/gate"
+              << " | y_last=0x" << std::hex << f32_to_hex(y_last) << std::dec
+              << " | sum=" << std::setprecision(9) << sum << "\n";
+}
+
+int main(int argc, char** argv) {
+    const long GATES = (argc > 1) ? std::atol(argv[1]) : 10'000'000L;
+    std::cout << std::fixed;
+
+    const float Kp = 0.11f, Ki = 0.08f, TD = 0.010f, N = 120.0f;
+
+    report("hand loop (native)", GATES, [&](float& yl) { return hand_loop(GATES, yl); });
+
+    report("ClosedLoop<Delta, Native>", GATES, [&](float& yl) {
+        DeltaClosedLoop<RoundNative> loop(EncoderFloor<RoundNative>(Ts),
+                                          DeltaPid2TapAw<RoundNative>(YSAT),
+                                          FirstOrderPlant<RoundNative>(Ku, lam, Ts));
+        return run_loop(loop, GATES, yl);
+    });
+
+    report("ClosedLoop<Delta, Volatile>", GATES, [&](float& yl) {
+        DeltaClosedLoop<RoundVolatile> loop(EncoderFloor<>(Ts), DeltaPid2TapAw<>(YSAT),
+                                            FirstOrderPlant<>(Ku, lam, Ts));
+        return run_loop(loop, GATES, yl);
+    });
+
+    report("ClosedLoop<DeltaJit, Native>", GATES, [&](float& yl) {
+        ClosedLoop<EncoderFloor, JitDeltaPid2TapAw, RoundNative, FirstOrderPlant> loop(
+            EncoderFloor<RoundNative>(Ts),
+            JitDeltaPid2TapAw<RoundNative>(YSAT, COEFFS_HEX),
+            FirstOrderPlant<RoundNative>(Ku, lam, Ts));
+        const double sum = run_loop(loop, GATES, yl);                // run() 이 prepare(GATES) 로 선택
+        if (!loop.controller().specialized()) std::cout << "  (JIT 미사용: 일반 커널)\n";
+        return sum;
+    });
+
+    // PI 전용 계수 (Td=0 → c0, c3, c6, c7b 가 0 이고 JIT 에서 제거됨)
+    const DeltaCoeffs PI_COEFFS = { 0.0f, 0.1108f, -0.11f, 0.0f, -0.1108f, 0.11f, 0.0f, 0.04f, 0.0f };
+
+    report("ClosedLoop<Delta(PI), Native>", GATES, [&](float& yl) {
+        DeltaClosedLoop<RoundNative> loop(EncoderFloor<RoundNative>(Ts),
+                                          DeltaPid2TapAw<RoundNative>(YSAT, PI_COEFFS),
+                                          FirstOrderPlant<RoundNative>(Ku, lam, Ts));
+        return run_loop(loop, GATES, yl);
+    });
+
+    report("ClosedLoop<DeltaJit(PI), Native>", GATES, [&](float& yl) {
+        ClosedLoop<EncoderFloor, JitDeltaPid2TapAw, RoundNative, FirstOrderPlant> loop(
+            EncoderFloor<RoundNative>(Ts),
+            JitDeltaPid2TapAw<RoundNative>(YSAT, PI_COEFFS),
+            FirstOrderPlant<RoundNative>(Ku, lam, Ts));
+        const double sum = run_loop(loop, GATES, yl);
+        if (!loop.controller().specialized()) std::cout << "  (JIT 미사용: 일반 커널)\n";
+        return sum;
+    });
+
+    report("ClosedLoop<General, Native>", GATES, [&](float& yl) {
+        ClosedLoop<EncoderFloor, GeneralPidControllerF32, RoundNative, FirstOrderPlant> loop(
+            EncoderFloor<RoundNative>(Ts),
+            GeneralPidControllerF32<RoundNative>(Kp, Ki, Kp * TD, 1.0f / N, 1.0f, 0.0f, 12.0f,
+                                                 Ts, -YSAT, YSAT),
+            FirstOrderPlant<RoundNative>(Ku, lam, Ts));
+        return run_loop(loop, GATES, yl);
+    });
+
+    // JIT 선택 기준 (코드 모양별 측정값, DeltaJitCache)
+    auto calib = [](const char* name, const DeltaCoeffs& k) {
+        const DeltaJitCache::Calib c = DeltaJitCache::instance().calib(k, YSAT);
+        std::cout << "JIT " << std::setw(4) << std::left << name << std::right << ": build "
+                  << std::setprecision(1) << c.build_ns / 1e3 << " us, gain " << std::setprecision(3)
+                  << c.gain_ns << " ns/step, break-even ";
+        if (c.break_even == LONG_MAX) std::cout << "never\n";
+        else                          std::cout << c.break_even << " steps\n";
+    };
+    calib("PID", COEFFS_HEX);
+    calib("PI", PI_COEFFS);
+
+    return 0;
+}
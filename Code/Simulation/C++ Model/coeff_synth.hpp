@@ -0,0 +1,155 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+#include "pid_coeffs.hpp"
+#include "pid_cycle_model.hpp"
+
+// ============================================================
+//  FPGA 계수 합성 블록 (Verilog/coeff_synth.v) 비트 호환 레퍼런스
+//  - 입력: Kp, Ki, Kd, N, b, c, Kb, Ts (FP32) → 출력: c0..c7b (FP32)
+//  - RTL 은 FMA IP(floating_point_0: a*b±c) + 나눗셈 IP(floating_point_5)
+//    + 비교 IP(floating_point_1) 를 마이크로코드 ROM 순서대로 한 번에 하나씩 돌린다.
+//    아래 COEFF_SYNTH_ROM 이 그 ROM 과 같은 표 (coeff_synth_check 가 .v 와 대조)
+//  - FMA IP 는 융합 연산: a*b±c 를 한 번만 라운딩 (std::fmaf).
+//    곱/덧셈을 따로 라운딩하면 무작위 게인의 약 35 % 에서 계수가 달라진다
+//  - compute_coeffs (double) 와는 식을 정리한 형태라 수 ulp 차이가 난다:
+//      aTd = (Kd/N)/Kp, r = 1/(Ts + aTd), Ts/Ti = Ts·Ki/Kp 로 나눗셈 3회
+//  - Kp, N, Ts 가 0 이하(또는 NaN)면 err (섀도 뱅크 갱신 없음)
+// ============================================================
+
+enum CoeffSynthKind : uint8_t {
+    CS_FMA = 0,     // dst = a*b + c
+    CS_FMS = 1,     // dst = a*b - c
+    CS_DIV = 2,     // dst = a / b
+    CS_CHK = 3,     // err |= !(a > 0)
+};
+
+// 레지스터 파일 (RTL rf[0:31] 과 같은 번호)
+enum CoeffSynthReg : uint8_t {
+    CR_ZERO = 0, CR_ONE = 1, CR_TWO = 2,                       // 상수
+    CR_KP = 3, CR_KI, CR_KD, CR_N, CR_B, CR_C, CR_KB, CR_TS,   // 3..10 입력
+    CR_C0 = 11, CR_C1, CR_C2, CR_C3, CR_C4, CR_C5, CR_C6, CR_C7A, CR_C7B,  // 11..19 출력
+    CR_IN = 20,     // 1/N
+    CR_KDN,         // Kd/N
+    CR_ATD,         // a·Td = (Kd/N)/Kp
+    CR_DEN,         // Ts + a·Td
+    CR_R,           // 1/den
+    CR_NR,          // -1/den
+    CR_TSKI,        // Ts·Ki  (= Kp·Ts/Ti)
+    CR_KDC,         // Kd·c
+    CR_U, CR_KPB, CR_V, CR_W,                                  // 임시
+    CR_COUNT = 32
+};
+
+struct CoeffSynthOp {
+    uint8_t kind, dst, a, b, c;
+};
+
+static constexpr std::array<CoeffSynthOp, 38> COEFF_SYNTH_ROM = {{
+    { CS_CHK, 0,       CR_KP,   0,       0       },
+    { CS_CHK, 0,       CR_N,    0,       0       },
+    { CS_CHK, 0,       CR_TS,   0,       0       },
+    // 공통 항
+    { CS_DIV, CR_IN,   CR_ONE,  CR_N,    0       },   // 1/N
+    { CS_FMA, CR_KDN,  CR_KD,   CR_IN,   CR_ZERO },   // Kd/N
+    { CS_DIV, CR_ATD,  CR_KDN,  CR_KP,   0       },   // aTd
+    { CS_FMA, CR_DEN,  CR_ATD,  CR_ONE,  CR_TS   },   // Ts + aTd
+    { CS_DIV, CR_R,    CR_ONE,  CR_DEN,  0       },   // r
+    { CS_FMS, CR_NR,   CR_ZERO, CR_ZERO, CR_R    },   // -r
+    { CS_FMA, CR_TSKI, CR_TS,   CR_KI,   CR_ZERO },
+    { CS_FMA, CR_KDC,  CR_KD,   CR_C,    CR_ZERO },
+    // c0 = aTd·r
+    { CS_FMA, CR_C0,   CR_ATD,  CR_R,    CR_ZERO },
+    // c1 = Kp·b + (Kd·c·r + Ts·Ki)
+    { CS_FMA, CR_U,    CR_KDC,  CR_R,    CR_TSKI },
+    { CS_FMA, CR_C1,   CR_KP,   CR_B,    CR_U    },
+    // c2 = -(Kp·b·(Ts + 2aTd) + aTd·Ts·Ki + 2·Kd·c)·r
+    { CS_FMA, CR_U,    CR_ATD,  CR_TWO,  CR_TS   },
+    { CS_FMA, CR_KPB,  CR_KP,   CR_B,    CR_ZERO },
+    { CS_FMA, CR_V,    CR_KPB,  CR_U,    CR_ZERO },
+    { CS_FMA, CR_V,    CR_ATD,  CR_TSKI, CR_V    },
+    { CS_FMA, CR_V,    CR_KDC,  CR_TWO,  CR_V    },
+    { CS_FMA, CR_C2,   CR_V,    CR_NR,   CR_ZERO },
+    // c3 = Kd·(b/N + c)·r
+    { CS_FMA, CR_U,    CR_B,    CR_IN,   CR_C    },
+    { CS_FMA, CR_U,    CR_KD,   CR_U,    CR_ZERO },
+    { CS_FMA, CR_C3,   CR_U,    CR_R,    CR_ZERO },
+    // c4 = -(Kp + Ts·Ki + Kd·r)
+    { CS_FMA, CR_W,    CR_KD,   CR_R,    CR_KP   },
+    { CS_FMA, CR_W,    CR_ONE,  CR_TSKI, CR_W    },
+    { CS_FMS, CR_C4,   CR_ZERO, CR_ZERO, CR_W    },
+    // c5 = (Kp·Ts + 2·Kd/N + aTd·Ts·Ki + 2·Kd)·r
+    { CS_FMA, CR_W,    CR_KP,   CR_TS,   CR_ZERO },
+    { CS_FMA, CR_W,    CR_KDN,  CR_TWO,  CR_W    },
+    { CS_FMA, CR_W,    CR_ATD,  CR_TSKI, CR_W    },
+    { CS_FMA, CR_W,    CR_KD,   CR_TWO,  CR_W    },
+    { CS_FMA, CR_C5,   CR_W,    CR_R,    CR_ZERO },
+    // c6 = -Kd·(1/N + 1)·r
+    { CS_FMA, CR_W,    CR_IN,   CR_ONE,  CR_ONE  },
+    { CS_FMA, CR_W,    CR_KD,   CR_W,    CR_ZERO },
+    { CS_FMA, CR_C6,   CR_W,    CR_NR,   CR_ZERO },
+    // c7a = Ki·Kb·Ts, c7b = -c7a·c0
+    { CS_FMA, CR_W,    CR_KI,   CR_KB,   CR_ZERO },
+    { CS_FMA, CR_C7A,  CR_W,    CR_TS,   CR_ZERO },
+    { CS_FMA, CR_W,    CR_C7A,  CR_C0,   CR_ZERO },
+    { CS_FMS, CR_C7B,  CR_ZERO, CR_ZERO, CR_W    },
+}};
+
+struct CoeffSynthGains {
+    float Kp, Ki, Kd, N, b, c, Kb, Ts;
+};
+
+static inline CoeffSynthGains to_synth_gains(const PidGains& g, double Ts) {
+    return { (float)g.Kp, (float)g.Ki, (float)g.Kd, (float)g.N,
+             (float)g.b,  (float)g.c,  (float)g.Kb, (float)Ts };
+}
+
+struct CoeffSynthResult {
+    DeltaCoeffs k;
+    bool        err;
+};
+
+class CoeffSynth {
+public:
+    // ROM 을 RTL 과 같은 순서로 한 번 실행
+    static CoeffSynthResult run(const CoeffSynthGains& g) {
+        float rf[CR_COUNT] = {};
+        rf[CR_ONE] = 1.0f;  rf[CR_TWO] = 2.0f;
+        rf[CR_KP] = g.Kp;  rf[CR_KI] = g.Ki;  rf[CR_KD] = g.Kd;  rf[CR_N]  = g.N;
+        rf[CR_B]  = g.b;   rf[CR_C]  = g.c;   rf[CR_KB] = g.Kb;  rf[CR_TS] = g.Ts;
+
+        bool err = false;
+        for (const CoeffSynthOp& op : COEFF_SYNTH_ROM) {
+            switch (op.kind) {
+            case CS_FMA: rf[op.dst] = fma(rf[op.a], rf[op.b],  rf[op.c]); break;
+            case CS_FMS: rf[op.dst] = fma(rf[op.a], rf[op.b], -rf[op.c]); break;
+            case CS_DIV: rf[op.dst] = div(rf[op.a], rf[op.b]); break;
+            case CS_CHK: err = err || !(rf[op.a] > 0.0f); break;
+            }
+            if (err && op.kind != CS_CHK) break;
+        }
+        if (err) return { DeltaCoeffs{}, true };
+        return { DeltaCoeffs{ rf[CR_C0], rf[CR_C1], rf[CR_C2], rf[CR_C3], rf[CR_C4],
+                              rf[CR_C5], rf[CR_C6], rf[CR_C7A], rf[CR_C7B] }, false };
+    }
+
+    // start 를 본 IDLE 사이클 → done(섀도 뱅크 갱신) 사이클까지
+    //  op 마다 ISSUE(1) + WAIT(IP 지연) + NEXT(1)
+    static long cycles(const IpLatency& ip) {
+        long n = 1;                                        // IDLE → ISSUE
+        for (const CoeffSynthOp& op : COEFF_SYNTH_ROM) {
+            const int kind = op.kind;
+            n += 2 + (kind == CS_DIV ? ip.div : kind == CS_CHK ? ip.comp : ip.fma);
+        }
+        return n + 1;                                      // DONE
+    }
+
+private:
+    // FMA IP: 곱을 라운딩하지 않고 더한 뒤 한 번 라운딩 (RNE)
+    static float fma(float a, float b, float c) { volatile float r = std::fmaf(a, b, c); return r; }
+    // 나눗셈 IP: IEEE 정확 라운딩 (RNE)
+    static float div(float a, float b) { volatile float r = a / b; return r; }
+};
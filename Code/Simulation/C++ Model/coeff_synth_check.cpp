@@ -0,0 +1,204 @@
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <regex>
+#include <random>
+#include <string>
+#include <array>
+#include <cmath>
+#include <cstdlib>
+
+#include "coeff_synth.hpp"
+
+// ============================================================
+//  계수 합성 블록 (Verilog/coeff_synth.v) 레퍼런스 검사
+//  - 빌드: g++ -O2 -std=c++20 -fno-fast-math -ffp-contract=off coeff_synth_check.cpp
+//  - 사용: ./a.out [coeff_synth.v 경로] [random_sets]
+//  1) .v 의 ROM 줄을 읽어 COEFF_SYNTH_ROM 과 op 단위로 대조 (같은 순서 = 같은 비트)
+//  2) DEFAULT_GAINS: 합성 결과 HEX 대 compute_coeffs (double) / COEFFS_HEX
+//  3) 무작위 게인: ROM 실행 == 융합 기준식 (ROM 순서를 직선 코드로, fmaf) 비트 동일,
+//     곱/덧셈 따로 라운딩했다면 달라졌을 세트 수, compute_coeffs 대비 계수별 최대 ulp
+//  4) Kp/N/Ts ≤ 0, NaN → err
+//  5) start → 섀도 뱅크 갱신까지 사이클 (IP 지연은 pid_cycle_model.hpp)
+// ============================================================
+
+static const char* KIND_NAMES[4] = { "FMA", "FMS", "DIV", "CHK" };
+static const char* REG_NAMES[CR_COUNT] = {
+    "ZERO", "ONE", "TWO", "KP", "KI", "KD", "N", "B", "C", "KB", "TS",
+    "C0", "C1", "C2", "C3", "C4", "C5", "C6", "C7A", "C7B",
+    "IN", "KDN", "ATD", "DEN", "R", "NR", "TSKI", "KDC", "U", "KPB", "V", "W",
+};
+
+static int index_of(const char* const* names, int n, const std::string& s) {
+    for (int i = 0; i < n; ++i) if (s == names[i]) return i;
+    return -1;
+}
+
+static bool check_rom(const std::string& path) {
+    std::ifstream f(path);
+    if (!f) { std::cout << "rom: cannot open " << path << "  FAIL\n"; return false; }
+    std::stringstream ss;
+    ss << f.rdbuf();
+    const std::string text = ss.str();
+
+    static const std::regex re(R"(6'd(\d+):\s*rom\s*=\s*\{K_(\w+),\s*R_(\w+),\s*R_(\w+),\s*R_(\w+),\s*R_(\w+)\s*\})");
+    int rows = 0, bad = 0;
+    for (auto it = std::sregex_iterator(text.begin(), text.end(), re); it != std::sregex_iterator(); ++it) {
+        const std::smatch& m = *it;
+        const int pc = std::stoi(m[1]);
+        const int f[5] = { index_of(KIND_NAMES, 4, m[2]), index_of(REG_NAMES, CR_COUNT, m[3]),
+                           index_of(REG_NAMES, CR_COUNT, m[4]), index_of(REG_NAMES, CR_COUNT, m[5]),
+                           index_of(REG_NAMES, CR_COUNT, m[6]) };
+        ++rows;
+        if (pc < 0 || pc >= (int)COEFF_SYNTH_ROM.size()) { ++bad; continue; }
+        const CoeffSynthOp& op = COEFF_SYNTH_ROM[pc];
+        if (f[0] != op.kind || f[1] != op.dst || f[2] != op.a || f[3] != op.b || f[4] != op.c) {
+            if (!bad) std::cout << "  first mismatch at pc " << pc << "\n";
+            ++bad;
+        }
+    }
+    const bool ok = bad == 0 && rows == (int)COEFF_SYNTH_ROM.size();
+    std::cout << "rom: " << rows << " rows in .v, " << COEFF_SYNTH_ROM.size() << " in C++, mismatches " << bad
+              << (ok ? "  OK" : "  FAIL") << "\n";
+    return ok;
+}
+
+// 같은 부호면 정수 거리, 다르면 0 을 사이에 두고 합
+static uint32_t ulp_diff(float a, float b) {
+    const int32_t ia = (int32_t)f32_to_hex(a), ib = (int32_t)f32_to_hex(b);
+    const int64_t ma = (ia < 0) ? -(int64_t)(ia & 0x7FFFFFFF) : ia;
+    const int64_t mb = (ib < 0) ? -(int64_t)(ib & 0x7FFFFFFF) : ib;
+    const int64_t d  = ma - mb;
+    return (uint32_t)std::min<int64_t>(d < 0 ? -d : d, UINT32_MAX);
+}
+
+static std::array<float, 9> fields(const DeltaCoeffs& k) {
+    return { k.c0, k.c1, k.c2, k.c3, k.c4, k.c5, k.c6, k.c7a, k.c7b };
+}
+
+// ROM 을 거치지 않는 기준식 (coeff_synth.v 의 op 순서 그대로). mac(a, b, c) = a*b + c
+template <class Mac>
+static DeltaCoeffs synth_reference(const CoeffSynthGains& g, Mac&& mac) {
+    auto dv = [](float a, float b) { volatile float r = a / b; return (float)r; };
+    const float in   = dv(1.0f, g.N);
+    const float kdn  = mac(g.Kd, in, 0.0f);
+    const float atd  = dv(kdn, g.Kp);
+    const float r    = dv(1.0f, mac(atd, 1.0f, g.Ts));
+    const float nr   = mac(0.0f, 0.0f, -r);
+    const float tski = mac(g.Ts, g.Ki, 0.0f);
+    const float kdc  = mac(g.Kd, g.c, 0.0f);
+
+    DeltaCoeffs k;
+    k.c0 = mac(atd, r, 0.0f);
+    k.c1 = mac(g.Kp, g.b, mac(kdc, r, tski));
+    float v = mac(mac(g.Kp, g.b, 0.0f), mac(atd, 2.0f, g.Ts), 0.0f);
+    v = mac(atd, tski, v);
+    v = mac(kdc, 2.0f, v);
+    k.c2 = mac(v, nr, 0.0f);
+    k.c3 = mac(mac(g.Kd, mac(g.b, in, g.c), 0.0f), r, 0.0f);
+    float w = mac(1.0f, tski, mac(g.Kd, r, g.Kp));
+    k.c4 = mac(0.0f, 0.0f, -w);
+    w = mac(g.Kp, g.Ts, 0.0f);
+    w = mac(kdn, 2.0f, w);
+    w = mac(atd, tski, w);
+    w = mac(g.Kd, 2.0f, w);
+    k.c5 = mac(w, r, 0.0f);
+    k.c6 = mac(mac(g.Kd, mac(in, 1.0f, 1.0f), 0.0f), nr, 0.0f);
+    k.c7a = mac(mac(g.Ki, g.Kb, 0.0f), g.Ts, 0.0f);
+    k.c7b = mac(0.0f, 0.0f, -mac(k.c7a, k.c0, 0.0f));
+    return k;
+}
+
+static float mac_fused(float a, float b, float c)   { volatile float r = std::fmaf(a, b, c); return r; }
+static float mac_unfused(float a, float b, float c) { return RoundVolatile::add(RoundVolatile::mul(a, b), c); }
+
+static bool same_bits(const DeltaCoeffs& a, const DeltaCoeffs& b) {
+    const std::array<float, 9> x = fields(a), y = fields(b);
+    for (int i = 0; i < 9; ++i) if (f32_to_hex(x[i]) != f32_to_hex(y[i])) return false;
+    return true;
+}
+
+static void print_default() {
+    const double Ts = 0.005;
+    const CoeffSynthResult s = CoeffSynth::run(to_synth_gains(DEFAULT_GAINS, Ts));
+    const DeltaCoeffs d = compute_coeffs(DEFAULT_GAINS, Ts);
+    const std::array<float, 9> fs = fields(s.k), fd = fields(d), fh = fields(COEFFS_HEX);
+    static const char* names[9] = { "c0", "c1", "c2", "c3", "c4", "c5", "c6", "c7a", "c7b" };
+    std::cout << "DEFAULT_GAINS, Ts = 0.005  (synth / compute_coeffs / COEFFS_HEX, ulp vs compute_coeffs)\n";
+    for (int i = 0; i < 9; ++i) {
+        std::cout << "  " << std::left << std::setw(4) << names[i] << std::right << std::hex << std::uppercase
+                  << std::setfill('0') << " 0x" << std::setw(8) << f32_to_hex(fs[i])
+                  << "  0x" << std::setw(8) << f32_to_hex(fd[i])
+                  << "  0x" << std::setw(8) << f32_to_hex(fh[i])
+                  << std::dec << std::setfill(' ') << "  " << ulp_diff(fs[i], fd[i]) << "\n";
+    }
+}
+
+static bool check_random(long sets) {
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<double> u01(0.0, 1.0);
+    auto logu = [&](double lo, double hi) { return lo * std::pow(hi / lo, u01(rng)); };
+
+    uint32_t worst[9] = {};
+    long mismatch = 0, unfused = 0, errs = 0;
+    for (long n = 0; n < sets; ++n) {
+        PidGains g;
+        g.Kp = logu(1e-3, 10.0);
+        g.Ki = (n % 10 == 0) ? 0.0 : logu(1e-3, 100.0);
+        g.Kd = (n % 7 == 0)  ? 0.0 : logu(1e-5, 1.0);
+        g.N  = logu(2.0, 500.0);
+        g.b  = u01(rng);
+        g.c  = (n % 3 == 0) ? 0.0 : u01(rng);
+        g.Kb = logu(0.1, 100.0);
+        const double Ts = (n % 2) ? 0.005 : logu(1e-4, 0.02);
+
+        // double 기준은 FP32 로 반올림된 입력에서 (합성 블록이 보는 값과 같게)
+        const CoeffSynthGains sg = to_synth_gains(g, Ts);
+        const PidGains gf = { sg.Kp, sg.Ki, sg.Kd, sg.N, sg.b, sg.c, sg.Kb };
+        const DeltaCoeffs d = compute_coeffs(gf, sg.Ts);
+
+        const CoeffSynthResult a = CoeffSynth::run(sg);
+        if (a.err) { ++errs; continue; }
+        mismatch += !same_bits(a.k, synth_reference(sg, mac_fused));
+        unfused  += !same_bits(a.k, synth_reference(sg, mac_unfused));
+        const std::array<float, 9> fa = fields(a.k), fd = fields(d);
+        for (int i = 0; i < 9; ++i) worst[i] = std::max(worst[i], ulp_diff(fa[i], fd[i]));
+    }
+    std::cout << "random: " << sets << " gain sets, max ulp vs compute_coeffs [c0..c7b]:";
+    for (uint32_t w : worst) std::cout << " " << w;
+    std::cout << "\n  ROM vs fused reference mismatches " << mismatch << " (unfused mul→add would differ in "
+              << unfused << "), unexpected err " << errs
+              << ((mismatch || errs) ? "  FAIL" : "  OK") << "\n";
+    return mismatch == 0 && errs == 0;
+}
+
+static bool check_err() {
+    CoeffSynthGains ok = to_synth_gains(DEFAULT_GAINS, 0.005);
+    int bad = 0;
+    if (CoeffSynth::run(ok).err) ++bad;
+    for (float v : { 0.0f, -1.0f, std::nanf("") }) {
+        CoeffSynthGains g = ok;  g.Kp = v;  bad += !CoeffSynth::run(g).err;
+        g = ok;                  g.N  = v;  bad += !CoeffSynth::run(g).err;
+        g = ok;                  g.Ts = v;  bad += !CoeffSynth::run(g).err;
+    }
+    std::cout << "err: Kp/N/Ts in {0, -1, NaN} flagged, valid set accepted" << (bad ? "  FAIL" : "  OK") << "\n";
+    return bad == 0;
+}
+
+int main(int argc, char** argv) {
+    const std::string path = (argc > 1) ? argv[1] : "../../Verilog/coeff_synth.v";
+    const long sets = (argc > 2) ? std::atol(argv[2]) : 200000;
+
+    bool ok = check_rom(path);
+    print_default();
+    ok &= check_random(sets);
+    ok &= check_err();
+
+    const RtlParams rtl;
+    const long cyc = CoeffSynth::cycles(rtl.ip);
+    std::cout << "latency: " << cyc << " cycles = " << std::fixed << std::setprecision(2)
+              << (double)cyc / (double)rtl.clk_hz * 1e6 << " us @ " << rtl.clk_hz / 1'000'000 << " MHz"
+              << " (+ 활성 뱅크 커밋: 다음 PID idle 사이클)\n";
+    return ok ? 0 : 1;
+}
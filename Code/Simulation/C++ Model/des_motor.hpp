@@ -0,0 +1,253 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "calendar_queue.hpp"
+#include "hot_probe.hpp"
+#include "pid_cycle_model.hpp"
+
+// ============================================================
+//  motor_control_top 이산 사건(DES) 시뮬레이터
+//  - 시간 단위 = aclk 사이클 (정수). 상태 변화가 있는 순간만 처리
+//  - 이벤트
+//      ENC_EDGE  : 엔코더 4x 에지 (식물 각도가 카운트 경계를 넘는 시각)
+//      ENC_STEP  : 동기화/필터 지연 후 step 이 acc8 에 반영
+//      GATE      : enc_pulse gate_pulse → spdcnt 래치
+//      PID_DONE  : pid_controller_axi FSM 완료(out_valid), 사이클 모델 지연
+//      PWM_DIR   : pwm_generator dir_out 갱신
+//      PWM_CMP   : compare_value 갱신
+//      PWM_WRAP  : pwm_counter 0 복귀
+//      PWM_LEVEL : pwm_out 레벨 변화
+//  - 식물: dω/dt = Ku·v - lam·ω (이벤트 사이 v 상수 → 지수 해로 정확 적분)
+//    v = pwm_out ? (dir ? +Vbus : -Vbus) : 0
+// ============================================================
+
+struct DesGateRecord {
+    long    k;          // 게이트 번호 (1부터)
+    int16_t spdcnt;
+    float   y;          // PID 출력 [V]
+    long    compare;    // 적용될 compare_value
+    double  omega;      // gate_pulse 시각의 실제 속도 [rad/s]
+};
+
+template <class Controller = DeltaPid2TapAw<>>
+class MotorControlDes {
+public:
+    enum Kind : uint16_t { ENC_EDGE, ENC_STEP, GATE, PID_DONE, PWM_DIR, PWM_CMP, PWM_WRAP, PWM_LEVEL };
+
+    // 같은 사이클: step 반영 → gate 래치 → 나머지
+    static uint8_t prio_of(Kind k) {
+        switch (k) {
+            case ENC_STEP: return 0;
+            case GATE:     return 1;
+            default:       return 2;
+        }
+    }
+
+    MotorControlDes(const RtlParams& rtl, const Controller& ctrl,
+                    float w_target, double Ku, double lam, double vbus = 12.0)
+        : rtl_(rtl), ctrl_(ctrl), w_target_(w_target),
+          Ku_(Ku), lam_(lam), vbus_(vbus),
+          enc_{ rtl.minpw_cyc, rtl.gate_cycles() }
+    {
+        rad_per_cnt_ = (double)INT2RADS / (double)rtl.gate_hz;
+        period_      = rtl.pwm_period();
+        schedule(GATE, enc_.gate_pulse_cycle(1), 0);
+        schedule(PWM_WRAP, 0, 0);
+        repredict_edge();
+    }
+
+    // end_cycle 까지 진행
+    void run_until(uint64_t end_cycle) {
+        while (!q_.empty()) {
+            const DesEvent e = q_.pop();
+            if (e.t > end_cycle) { q_.push(e); break; }
+            ++events_;
+            PID_PROBE("des.dispatch");
+            dispatch(e);
+        }
+        advance(end_cycle);
+    }
+
+    // 게이트 n 개 진행 (마지막 게이트의 PID/PWM 반영까지)
+    void run_gates(long n) {
+        const uint64_t end = (uint64_t)enc_.gate_pulse_cycle(n)
+                           + 2 + PidFsmCycleModel::cycles_to_out_valid(rtl_.ip)
+                           + PwmGeneratorModel::cycles_to_compare(rtl_.ip);
+        run_until(end);
+    }
+
+    const std::vector<DesGateRecord>& gates() const { return log_; }
+    uint64_t events_processed() const { return events_; }
+    double   omega() const { return omega_; }
+    Controller& controller() { return ctrl_; }
+
+private:
+    void schedule(Kind k, uint64_t t, int64_t arg, uint32_t gen = 0) {
+        q_.push(DesEvent{ t, prio_of(k), 0, (uint16_t)k, gen, arg });
+    }
+
+    double voltage() const { return pwm_level_ ? (dir_ ? vbus_ : -vbus_) : 0.0; }
+
+    // t 까지 식물 적분 (v 상수)
+    void advance(uint64_t t) {
+        if (t <= t_plant_) return;
+        const double dt  = (double)(t - t_plant_) / (double)rtl_.clk_hz;
+        const double wss = Ku_ * voltage() / lam_;
+        const double e   = std::exp(-lam_ * dt);
+        theta_  += wss * dt + (omega_ - wss) * (1.0 - e) / lam_;
+        omega_   = wss + (omega_ - wss) * e;
+        t_plant_ = t;
+    }
+
+    double theta_at(double dt) const {
+        const double wss = Ku_ * voltage() / lam_;
+        return theta_ + wss * dt + (omega_ - wss) * (1.0 - std::exp(-lam_ * dt)) / lam_;
+    }
+
+    // 현재 v 에서 다음 카운트 경계 통과 시각 예측 (PWM 한 주기 안에서)
+    // v 가 바뀌거나 WRAP 마다 다시 예측하므로 그 이후는 볼 필요 없음
+    void repredict_edge() {
+        ++gen_enc_;
+        const double lo = (double)count_ * rad_per_cnt_;
+        const double hi = lo + rad_per_cnt_;
+        const double H  = (double)period_ / (double)rtl_.clk_hz;
+        const int    M  = 16;
+
+        double t0 = 0.0;
+        for (int i = 1; i <= M; ++i) {
+            const double t1 = H * i / M;
+            const double th = theta_at(t1);
+            if (th >= hi || th < lo) {
+                const int dir = (th >= hi) ? +1 : -1;
+                const double target = (dir > 0) ? hi : lo;
+                double a = t0, b = t1;               // 이분법
+                for (int it = 0; it < 40; ++it) {
+                    const double m = 0.5 * (a + b);
+                    const double tm = theta_at(m);
+                    const bool crossed = (dir > 0) ? (tm >= target) : (tm < target);
+                    (crossed ? b : a) = m;
+                }
+                const uint64_t cyc = t_plant_ + std::max<uint64_t>(1, (uint64_t)std::ceil(b * (double)rtl_.clk_hz));
+                schedule(ENC_EDGE, cyc, dir, gen_enc_);
+                return;
+            }
+            t0 = t1;
+        }
+    }
+
+    void set_pwm_level(uint64_t t, bool level) {
+        if (level == pwm_level_) return;
+        advance(t);
+        pwm_level_ = level;
+        repredict_edge();
+    }
+
+    void dispatch(const DesEvent& e) {
+        switch ((Kind)e.kind) {
+        case ENC_EDGE:
+            if (e.gen != gen_enc_) return;                 // 무효화된 예측
+            advance(e.t);
+            count_ += e.arg;
+            schedule(ENC_STEP, e.t + enc_.latency(), e.arg);
+            repredict_edge();
+            break;
+
+        case ENC_STEP:
+            enc_.step((int)e.arg);
+            break;
+
+        case GATE: {
+            const long k = ++gate_k_;
+            const int16_t spd = enc_.latch();
+            advance(e.t);
+            pending_ = DesGateRecord{ k, spd, 0.0f, 0, omega_ };
+            // delta_valid(+1) 을 IDLE 에서 보고 FSM 완료까지
+            schedule(PID_DONE, e.t + 1 + PidFsmCycleModel::cycles_to_out_valid(rtl_.ip), spd);
+            schedule(GATE, enc_.gate_pulse_cycle(k + 1), 0);
+            break;
+        }
+
+        case PID_DONE: {
+            const float x = mul_rn((float)(int16_t)e.arg, INT2RADS);
+            const float y = ctrl_.step(w_target_, x);
+            const long  cv = PwmGeneratorModel::compare_value(y, RECIP_YSAT, period_);
+            pending_.y = y;
+            pending_.compare = cv;
+            log_.push_back(pending_);
+            schedule(PWM_DIR, e.t + PwmGeneratorModel::cycles_to_dir(rtl_.ip),
+                     PwmGeneratorModel::dir_from(y) ? 1 : 0);
+            schedule(PWM_CMP, e.t + PwmGeneratorModel::cycles_to_compare(rtl_.ip), cv);
+            break;
+        }
+
+        case PWM_DIR:
+            if ((e.arg != 0) != dir_) {
+                advance(e.t);
+                dir_ = (e.arg != 0);
+                repredict_edge();
+            }
+            break;
+
+        case PWM_CMP: {
+            // compare 가 바뀐 사이클의 카운터 p: pwm_out(t+1) = p < C
+            compare_ = e.arg;
+            ++gen_pwm_;
+            const uint64_t p    = e.t % (uint64_t)period_;
+            const uint64_t wrap = e.t - p;
+            if ((long)p < compare_) {
+                schedule(PWM_LEVEL, e.t + 1, 1, gen_pwm_);
+                schedule(PWM_LEVEL, wrap + compare_ + 1, 0, gen_pwm_);
+            } else {
+                schedule(PWM_LEVEL, e.t + 1, 0, gen_pwm_);
+            }
+            break;
+        }
+
+        case PWM_WRAP:
+            ++gen_pwm_;
+            if (compare_ > 0) {
+                schedule(PWM_LEVEL, e.t + 1, 1, gen_pwm_);
+                schedule(PWM_LEVEL, e.t + 1 + compare_, 0, gen_pwm_);
+            } else {
+                schedule(PWM_LEVEL, e.t + 1, 0, gen_pwm_);
+            }
+            schedule(PWM_WRAP, e.t + period_, 0);
+            advance(e.t);
+            repredict_edge();
+            break;
+
+        case PWM_LEVEL:
+            if (e.gen != gen_pwm_) return;
+            set_pwm_level(e.t, e.arg != 0);
+            break;
+        }
+    }
+
+    RtlParams     rtl_;
+    Controller    ctrl_;
+    float         w_target_;
+    double        Ku_, lam_, vbus_;
+    EncPulseModel enc_;
+    CalendarQueue q_;
+
+    // 식물/엔코더
+    uint64_t t_plant_ = 0;
+    double   omega_ = 0.0, theta_ = 0.0, rad_per_cnt_ = 0.0;
+    long     count_ = 0;
+    uint32_t gen_enc_ = 0;
+
+    // PWM
+    long     period_ = 0;
+    long     compare_ = 0;
+    bool     dir_ = false;      // 리셋 시 dir_out = 0
+    bool     pwm_level_ = false;
+    uint32_t gen_pwm_ = 0;
+
+    long          gate_k_ = 0;
+    DesGateRecord pending_{};
+    std::vector<DesGateRecord> log_;
+    uint64_t      events_ = 0;
+};
@@ -0,0 +1,46 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+
+#include "des_motor.hpp"
+
+// ============================================================
+//  motor_control_top DES 실행 (motor_control_tb.v 와 같은 계수/식물)
+//  - 빌드: g++ -O2 -std=c++20 -fno-fast-math -ffp-contract=off des_motor_sim.cpp
+//  - 사용: ./a.out [gates]
+// ============================================================
+
+int main(int argc, char** argv) {
+    const long GATES = (argc > 1) ? std::atol(argv[1]) : 200;
+
+    RtlParams rtl;   // 100 MHz, PWM 20 kHz, GATE 200 Hz, MINPW 50
+
+    MotorControlDes<> des(rtl, DeltaPid2TapAw<>(YSAT), W_TGT, /*Ku=*/50.0, /*lam=*/5.0);
+
+    std::cout << "# FSM out_valid latency = " << PidFsmCycleModel::cycles_to_out_valid(rtl.ip)
+              << " cyc, PWM compare latency = " << PwmGeneratorModel::cycles_to_compare(rtl.ip)
+              << " cyc, ENC latency = " << (2 + rtl.minpw_cyc) << " cyc\n";
+    std::cout << "Step | measured spdcnt |      y[V]   | compare |  w[rad/s]\n";
+    std::cout << "-------------------------------------------------------------\n";
+
+    const auto t0 = std::chrono::steady_clock::now();
+    des.run_gates(GATES);
+    const auto t1 = std::chrono::steady_clock::now();
+
+    std::cout << std::fixed;
+    for (const DesGateRecord& g : des.gates()) {
+        std::cout << std::setw(4) << g.k << " | "
+                  << std::setw(15) << g.spdcnt << " | "
+                  << std::setw(11) << std::setprecision(9) << g.y << " | "
+                  << std::setw(7) << g.compare << " | "
+                  << std::setw(10) << std::setprecision(6) << g.omega << "\n";
+    }
+
+    const double ms = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    const double sim_cycles = (double)GATES * (double)rtl.gate_cycles();
+    std::cout << "\n# events=" << des.events_processed()
+              << "  wall=" << std::setprecision(3) << ms << " ms"
+              << "  (" << std::setprecision(1) << sim_cycles / (ms * 1e3) << " Mcycle/s simulated)\n";
+    return 0;
+}
@@ -0,0 +1,129 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "drift_bound.hpp"
+#include "pid_coeffs.hpp"
+
+// ============================================================
+//  FP32 드리프트 상한 인증 + 표본 시뮬레이션과 비교
+//  - 빌드: g++ -O3 -std=c++20 -fno-fast-math -ffp-contract=off drift_bound.cpp -o drift_bound
+//  - 사용: ./drift_bound [steps] [w_hi] [x_lo] [x_hi] [samples]
+//  - RTL (융합 FMA) 산술을 두 기준으로 인증
+//      arith : 이상 계수 = COEFFS_HEX 값 그대로 (연산 라운딩만)
+//      gains : 이상 계수 = compute_coeffs_d(DEFAULT_GAINS) (계수 양자화 포함)
+//    + C++ 모델 (DeltaPid2TapAw, 비융합) 산술의 arith 상한
+//  - 표본: 포락선 안 무작위/극단 입력열로 FP32 (RTL 재현 / C++ 모델) vs
+//    long double 이상 재귀의 최대 |Δy_sat| → 각자 상한 아래인지 확인
+// ============================================================
+
+// RTL Δy 경로 재현 (pid_controller.v S_MAC1..S_ADD_Y): 연산마다 융합 FMA 1회
+struct FusedPid {
+    DeltaCoeffs k;
+    float YS;
+    float dy1 = 0, w1 = 0, w2 = 0, x1 = 0, x2 = 0, yu1 = 0, yu2 = 0, ys1 = 0, ys2 = 0;
+
+    float step(float w, float x) {
+        const float e1 = std::fmaf(1.0f, ys1, -yu1), e2 = std::fmaf(1.0f, ys2, -yu2);
+        float acc = std::fmaf(k.c1, w, 0.0f);
+        acc = std::fmaf(k.c0,  dy1, acc);
+        acc = std::fmaf(k.c2,  w1,  acc);
+        acc = std::fmaf(k.c3,  w2,  acc);
+        acc = std::fmaf(k.c4,  x,   acc);
+        acc = std::fmaf(k.c5,  x1,  acc);
+        acc = std::fmaf(k.c6,  x2,  acc);
+        acc = std::fmaf(k.c7a, e1,  acc);
+        acc = std::fmaf(k.c7b, e2,  acc);
+        const float yu = std::fmaf(1.0f, yu1, acc);
+        const float ys = std::clamp(yu, -YS, YS);
+        dy1 = acc;  w2 = w1;  w1 = w;  x2 = x1;  x1 = x;
+        yu2 = yu1;  yu1 = yu;  ys2 = ys1;  ys1 = ys;
+        return ys;
+    }
+};
+
+// long double 이상 제어기 (DeltaPid2TapAw 와 같은 구조, 라운딩만 없음)
+struct IdealPid {
+    std::array<double, 9> c;
+    long double YS;
+    long double dy1 = 0, w1 = 0, w2 = 0, x1 = 0, x2 = 0, yu1 = 0, yu2 = 0, ys1 = 0, ys2 = 0;
+
+    long double step(float w, float x) {
+        const long double e1 = ys1 - yu1, e2 = ys2 - yu2;
+        const long double dy = c[0] * dy1 + c[1] * (long double)w + c[2] * w1 + c[3] * w2
+                             + c[4] * (long double)x + c[5] * x1 + c[6] * x2 + c[7] * e1 + c[8] * e2;
+        const long double yu = yu1 + dy;
+        const long double ys = std::clamp(yu, -YS, YS);
+        dy1 = dy;  w2 = w1;  w1 = w;  x2 = x1;  x1 = x;
+        yu2 = yu1;  yu1 = yu;  ys2 = ys1;  ys1 = ys;
+        return ys;
+    }
+};
+
+int main(int argc, char** argv) {
+    const long  steps   = (argc > 1) ? std::atol(argv[1]) : 2000;
+    const float w_hi    = (argc > 2) ? std::strtof(argv[2], nullptr) : W_TGT;
+    const float x_lo    = (argc > 3) ? std::strtof(argv[3], nullptr) : 0.0f;
+    const float x_hi    = (argc > 4) ? std::strtof(argv[4], nullptr) : 120.0f;
+    const int   samples = (argc > 5) ? std::atoi(argv[5]) : 200;
+
+    const DriftEnvelope env{ 0.0f, w_hi, x_lo, x_hi };
+    const DeltaCoeffs   k = COEFFS_HEX;
+
+    const std::array<double, 9> from_gains = compute_coeffs_d(DEFAULT_GAINS, 0.005);
+
+    std::cout << "envelope: w∈[0," << w_hi << "]  x∈[" << x_lo << "," << x_hi << "]  steps=" << steps << "\n";
+
+    std::vector<DriftStep> arith, gains, unfused;
+    for (int pass = 0; pass < 3; ++pass) {
+        const auto ideal = pass == 1 ? from_gains : DeltaPidDriftBound::exact_of(k);
+        DeltaPidDriftBound bound(k, ideal, YSAT, env, pass == 2 ? DriftMac::Unfused : DriftMac::Fused);
+        const auto t0 = std::chrono::steady_clock::now();
+        (pass == 0 ? arith : pass == 1 ? gains : unfused) = bound.run(steps);
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        std::cout << (pass == 0 ? "arith  " : pass == 1 ? "gains  " : "unfused") << " : " << std::fixed
+                  << std::setprecision(1) << ms << " ms  symbols=" << bound.symbols()
+                  << "  compactions=" << bound.compactions() << "\n";
+    }
+
+    // 표본: 무작위 / 극단 교대 / 계단
+    std::vector<double> seen(steps, 0.0), seen_u(steps, 0.0);
+    std::mt19937 rng(3);
+    std::uniform_real_distribution<float> uw(env.w_lo, env.w_hi), ux(env.x_lo, env.x_hi);
+    std::bernoulli_distribution coin(0.5);
+    for (int s = 0; s < samples; ++s) {
+        FusedPid rtl{ k, YSAT };
+        DeltaPid2TapAw<RoundNative> fp(YSAT, k);
+        IdealPid id{ DeltaPidDriftBound::exact_of(k), (long double)YSAT };
+        const int kind = s % 3;
+        float w = uw(rng), x = ux(rng);
+        for (long n = 0; n < steps; ++n) {
+            if (kind == 0)      { w = uw(rng); x = ux(rng); }
+            else if (kind == 1) { w = coin(rng) ? env.w_hi : env.w_lo; x = coin(rng) ? env.x_hi : env.x_lo; }
+            else if (n % 200 == 0) { w = uw(rng); x = ux(rng); }
+            const long double y = id.step(w, x);
+            seen[n]   = std::max(seen[n],   (double)std::fabs((long double)rtl.step(w, x) - y));
+            seen_u[n] = std::max(seen_u[n], (double)std::fabs((long double)fp.step(w, x) - y));
+        }
+    }
+
+    std::cout << std::scientific << std::setprecision(3)
+              << "     n    bound(arith)    bound(gains)   sampled max  bound(unfused)  sampled(unf)   y_unsat range\n";
+    bool ok = true, ok_u = true;
+    for (long n = 0; n < steps; ++n) {
+        ok   &= seen[n]   <= arith[n].y_err;
+        ok_u &= seen_u[n] <= unfused[n].y_err;
+        const bool show = n + 1 == 1 || n + 1 == 10 || n + 1 == 100 || (n + 1) % 500 == 0 || n + 1 == steps;
+        if (!show) continue;
+        std::cout << std::setw(6) << n + 1 << "  " << std::setw(14) << arith[n].y_err << "  " << std::setw(14)
+                  << gains[n].y_err << "  " << std::setw(12) << seen[n] << "  " << std::setw(14) << unfused[n].y_err
+                  << "  " << std::setw(12) << seen_u[n] << "   [" << std::fixed << std::setprecision(1)
+                  << arith[n].y_lo << ", " << arith[n].y_hi << "]  aw=" << arith[n].aw << std::scientific << std::setprecision(3) << "\n";
+    }
+    std::cout << "sampled ≤ bound(arith) at every step (RTL fused): " << (ok ? "OK" : "FAIL") << "\n"
+              << "sampled ≤ bound(unfused) at every step (C++ model): " << (ok_u ? "OK" : "FAIL") << "\n";
+    return ok && ok_u ? 0 : 1;
+}
@@ -0,0 +1,411 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+#include "pid_model.hpp"
+
+// ============================================================
+//  FP32 Δ-form 라운딩 드리프트 최악값 상한 (아핀 산술)
+//  - 대상 (DriftMac)
+//      Fused  : RTL pid_controller_axi Δy 경로 (기본). floating_point_0 융합 FMA,
+//               누산 순서 c1·w, c0·dy1, c2·w1, … , c7b·e2 (S_MAC1..S_AW_ACC2)
+//      Unfused: C++ 모델 DeltaPid2TapAw (MUL→ADD 각각 라운딩, c0·dy1 부터)
+//    e_sat 뺄셈 (1·ys - yu) 과 y_unsat 덧셈 (1·y + dy) 은 양쪽 모두 라운딩 1회
+//  - 이상 제어기: 실수 연산 + 기준 계수 c (double). 기준을 FP32 계수
+//    그대로 두면 연산 라운딩만, 게인에서 계산한 double 로 두면 계수
+//    양자화까지 포함
+//  - 입력 포락선: 매 스텝 w ∈ [w_lo, w_hi], x ∈ [x_lo, x_hi] (서로 독립,
+//    임의 순서열) — 샘플링이 아니라 포락선 안 모든 입력열에 대한 상한
+//  - 방법: 모든 값은 아핀 형식  v = c + Σ a_i·ε_i + [-r, r]  (ε_i ∈ [-1,1] 공유)
+//    · 이상 값 I(dy, y_unsat, AW 오차)      : 입력 w[n], x[n] 마다 새 기호
+//      → c1·w + c2·w1 + c3·w2 같은 상쇄가 범위에 그대로 반영 (wrapping 없음)
+//      dead-zone(clamp(y)-y) 은 최소범위 선형화 + 새 기호
+//    · 오차 E = FP32 값 - 이상 값 (같은 기호 공간)
+//        E_p = ĉ·E_s + (ĉ-c)·s + ρ       ρ: 그 스텝의 모든 MAC 라운딩
+//        Fused  : acc = fl(ĉ·ŝ + acc)       |ρ_mac| ≤ u·|부분합| + η
+//        Unfused: acc = fl(acc + fl(ĉ·ŝ))   |ρ_mul| ≤ u·|ĉ·ŝ| + η,  |ρ_add| ≤ u·|부분합|
+//        (u = 2^-24, η = 2^-126, 부분합 = 그 항까지 더한 값의 상한)
+//      ρ 는 한 스텝 안에서 E_dy 로만 들어가므로 스텝당 기호 하나로 합침
+//    · dead-zone 은 단조 감소 1-Lipschitz → dz(ŷ) - dz(y) = -θ·E_yu, θ ∈ [0,1]
+//        양쪽 모두 선형 영역이면 θ = 0 (AW 항 정확히 0), 같은 쪽 포화면 θ = 1,
+//        그 밖에는 θ = ½ ± ½ (새 기호)
+//      부호를 유지하므로 AW 궤환의 수축이 상한에도 반영됨
+//    · 출력 clamp 도 1-Lipschitz → |ŷ_sat - y_sat| ≤ |E_yu|
+//    · 아핀 계산 자체의 double 라운딩은 매 연산 상대 SLACK 으로 부풀림
+//  - 살아 있는 형식의 독립 반경 r 은 매 스텝 새 기호로 옮김 (AW 궤환을 |·| 로
+//    지나면 스텝당 배율 > 1 로 발산). 기호 수가 max_symbols 를 넘으면 기여가
+//    작은 쪽을 주성분 평행체 8개 기호로 감쌈 (compact 참고, 상한은 유지)
+//  - 내부 루프는 기호 배열에 대한 연속 axpy + |·| 합 (fused, 4 누산기)
+//  - 2000 스텝 (10 s) 포락선 전체 인증 ≈ 수십 ms (drift_bound.cpp)
+// ============================================================
+
+struct DriftEnvelope {
+    float w_lo, w_hi;     // 목표 속도 [rad/s]
+    float x_lo, x_hi;     // 측정 속도 [rad/s]
+};
+
+// Δy MAC 라운딩 모델
+enum class DriftMac {
+    Fused,      // RTL: 항마다 라운딩 1회
+    Unfused,    // DeltaPid2TapAw: 곱과 누산 각각 라운딩
+};
+
+struct DriftStep {
+    double dy_err;        // |Δŷ - Δy| 상한
+    double y_err;         // |ŷ_unsat - y_unsat| 상한 (= |ŷ_sat - y_sat| 상한)
+    double y_lo, y_hi;    // 이상 y_unsat 범위
+    int    aw;            // AW 항 θ: 0 (둘 다 비포화), 1 (같은 쪽 포화), -1 (불확정)
+};
+
+class DeltaPidDriftBound {
+public:
+    static constexpr int NT = 9;     // 계수/탭 수 (c0..c7b)
+
+    // 기준 계수 = FP32 계수 값 그대로 (연산 라운딩만 인증)
+    static std::array<double, NT> exact_of(const DeltaCoeffs& k) {
+        const float p[NT] = { k.c0, k.c1, k.c2, k.c3, k.c4, k.c5, k.c6, k.c7a, k.c7b };
+        std::array<double, NT> c;
+        for (int i = 0; i < NT; ++i) c[i] = (double)p[i];
+        return c;
+    }
+
+    DeltaPidDriftBound(const DeltaCoeffs& k, const std::array<double, NT>& ideal, float ysat,
+                       const DriftEnvelope& env, DriftMac mac = DriftMac::Fused, int max_symbols = 8192)
+        : ideal_(ideal), ysat_((double)ysat), env_(env), mac_(mac), cap_(std::max(64, max_symbols))
+    {
+        const std::array<double, NT> p = exact_of(k);
+        for (int i = 0; i < NT; ++i) {
+            chat_[i] = p[i];
+            cdif_[i] = chat_[i] - ideal_[i];
+        }
+        for (Form& f : pool_) f.a.assign(cap_, 0.0);
+        for (int i = 0; i < 16; ++i) f_[i] = &pool_[i];
+    }
+
+    const DriftStep& step() {
+        Form &Idy1 = *f_[I_DY1], &Iyu1 = *f_[I_YU1], &Ias1 = *f_[I_AS1], &Ias2 = *f_[I_AS2];
+        Form &Edy1 = *f_[E_DY1], &Eyu1 = *f_[E_YU1], &Eas1 = *f_[E_AS1], &Eas2 = *f_[E_AS2];
+        Form &IP = *f_[I_P], &EP = *f_[E_P];
+
+        if (ns_ + 16 > cap_) compact();
+        // 독립 반경 r 은 궤환을 |·| 로 지나며 매 스텝 커지므로 기호로 옮겨 부호를 유지
+        for (int p = 0; p < 8; ++p) {
+            Form& f = *f_[p];
+            if (f.r > 0.0) { const double r = f.r; f.r = 0.0; add_sym(f, fresh(), 0.0, r); }
+        }
+        const int sw = fresh(), sx = fresh();
+        const double wc = 0.5 * ((double)env_.w_lo + env_.w_hi), wr = 0.5 * ((double)env_.w_hi - env_.w_lo);
+        const double xc = 0.5 * ((double)env_.x_lo + env_.x_hi), xr = 0.5 * ((double)env_.x_hi - env_.x_lo);
+
+        // dy = Σ c_k s_k  (acc = 0 에서 시작, 항 순서는 DriftMac 참고)
+        zero(IP);
+        zero(EP);
+        double rho = 0.0;
+        int    n   = 0;     // 누산한 항 수
+        // prod: 이번 항 |ĉ·ŝ| 상한 (0 이면 정확히 0 인 항 → fused 는 라운딩 없음)
+        auto mac_round = [&](double prod) {
+            if (mac_ == DriftMac::Fused) {
+                if (prod > 0.0) rho += U * (mag(IP) + mag(EP) + rho) + ETA;
+            } else {
+                if (prod > 0.0) rho += U * prod + ETA;
+                if (n > 0) rho += U * (mag(IP) + mag(EP) + rho);
+            }
+            ++n;
+        };
+        auto term_form = [&](int k, const Form& Is, const Form& Es) {
+            const double S = mag(Is), Se = mag(Es);
+            axpy(IP, ideal_[k], Is);
+            if (Es.m != 0.0 || Es.r != 0.0 || Es.c != 0.0) axpy(EP, chat_[k], Es);
+            if (cdif_[k] != 0.0) axpy(EP, cdif_[k], Is);
+            mac_round(std::fabs(chat_[k]) * (S + Se));
+        };
+        auto term_sym = [&](int k, int sym, double c, double r) {
+            double prod = 0.0;
+            if (sym >= 0) {
+                add_sym(IP, sym, ideal_[k] * c, ideal_[k] * r);
+                if (cdif_[k] != 0.0) add_sym(EP, sym, cdif_[k] * c, cdif_[k] * r);
+                prod = std::fabs(chat_[k]) * (std::fabs(c) + r);
+            }
+            mac_round(prod);
+        };
+        if (mac_ == DriftMac::Fused) {
+            term_sym(1, sw, wc, wr);
+            term_form(0, Idy1, Edy1);
+        } else {
+            term_form(0, Idy1, Edy1);
+            term_sym(1, sw, wc, wr);
+        }
+        term_sym(2, w1_, wc, wr);
+        term_sym(3, w2_, wc, wr);
+        term_sym(4, sx,  xc, xr);
+        term_sym(5, x1_, xc, xr);
+        term_sym(6, x2_, xc, xr);
+        term_form(7, Ias1, Eas1);
+        term_form(8, Ias2, Eas2);
+        if (rho > 0.0) add_sym(EP, fresh(), 0.0, up(rho));
+        const double e_dy = mag(EP);
+
+        // y_unsat = fl(y_unsat1 + dy)
+        Form &Iyu = *f_[I_YU], &Eyu = *f_[E_YU];
+        copy(Iyu, Iyu1);  axpy(Iyu, 1.0, IP);
+        copy(Eyu, Eyu1);  axpy(Eyu, 1.0, EP);
+        add_sym(Eyu, fresh(), 0.0, up(U * (mag(Iyu) + mag(Eyu))));
+        double lo, hi;
+        range(Iyu, lo, hi);
+        const double e_yu = mag(Eyu);
+
+        // AW 오차 as = fl(clamp(ŷ_unsat) - ŷ_unsat)
+        Form &Ias = *f_[I_AS], &Eas = *f_[E_AS];
+        int aw;
+        if (lo - e_yu >= -ysat_ && hi + e_yu <= ysat_) {
+            aw = 0;
+            zero(Ias);
+            zero(Eas);
+        } else {
+            dead_zone(Iyu, lo, hi, Ias);
+            zero(Eas);
+            const bool sat = lo - e_yu >= ysat_ || hi + e_yu <= -ysat_;
+            aw = sat ? 1 : -1;
+            axpy(Eas, sat ? -1.0 : -0.5, Eyu);
+            const double extra = (sat ? 0.0 : 0.5 * e_yu) + U * (mag(Ias) + e_yu);
+            add_sym(Eas, fresh(), 0.0, up(extra));
+        }
+
+        // 회전: dy1←P, yu1←yu, as2←as1, as1←as
+        std::swap(f_[I_DY1], f_[I_P]);   std::swap(f_[E_DY1], f_[E_P]);
+        std::swap(f_[I_YU1], f_[I_YU]);  std::swap(f_[E_YU1], f_[E_YU]);
+        std::swap(f_[I_AS2], f_[I_AS1]); std::swap(f_[E_AS2], f_[E_AS1]);
+        std::swap(f_[I_AS1], f_[I_AS]);  std::swap(f_[E_AS1], f_[E_AS]);
+        w2_ = w1_;  w1_ = sw;
+        x2_ = x1_;  x1_ = sx;
+
+        last_ = DriftStep{ e_dy, e_yu, lo, hi, aw };
+        return last_;
+    }
+
+    std::vector<DriftStep> run(long n) {
+        std::vector<DriftStep> out;
+        out.reserve(n);
+        for (long i = 0; i < n; ++i) out.push_back(step());
+        return out;
+    }
+
+    int  symbols() const { return ns_; }
+    long compactions() const { return compactions_; }
+
+private:
+    struct Form {
+        double c = 0.0, r = 0.0;
+        double m = 0.0;                 // Σ|a_i| 캐시 (axpy/zero/copy/add_sym 가 갱신)
+        std::vector<double> a;
+    };
+
+    // 형식 슬롯: 살아 있는 상태 8개 + 스텝 임시 6개 (+여분)
+    enum { I_DY1, I_YU1, I_AS1, I_AS2, E_DY1, E_YU1, E_AS1, E_AS2, I_P, E_P, I_YU, E_YU, I_AS, E_AS };
+
+    static constexpr double U     = 0x1p-24;     // FP32 단위 반올림
+    static constexpr double ETA   = 0x1p-126;    // 언더플로/FTZ
+    static constexpr double SLACK = 0x1p-48;     // double 아핀 계산 여유 (상대)
+
+    static double up(double v) { return v * (1.0 + 0x1p-36); }    // 합산 순서 오차 흡수
+
+    int fresh() {
+        const int s = ns_++;
+        for (Form& f : pool_) f.a[s] = 0.0;
+        return s;
+    }
+
+    void zero(Form& f) const {
+        f.c = f.r = f.m = 0.0;
+        std::fill(f.a.begin(), f.a.begin() + ns_, 0.0);
+    }
+
+    void copy(Form& d, const Form& s) const {
+        d.c = s.c;  d.r = s.r;  d.m = s.m;
+        std::copy(s.a.begin(), s.a.begin() + ns_, d.a.begin());
+    }
+
+    // f += c + r·ε_sym
+    static void add_sym(Form& f, int sym, double c, double r) {
+        const double old = std::fabs(f.a[sym]);
+        f.c += c;
+        f.a[sym] += r;
+        f.m += std::fabs(f.a[sym]) - old;
+        f.r += SLACK * (std::fabs(c) + std::fabs(r));
+    }
+
+    // d += alpha·s, 결과 Σ|a| 를 같은 패스에서 구함
+    void axpy(Form& d, double alpha, const Form& s) const {
+        double*       da = d.a.data();
+        const double* sa = s.a.data();
+        double m0 = 0, m1 = 0, m2 = 0, m3 = 0;
+        int i = 0;
+        for (; i + 4 <= ns_; i += 4) {
+            da[i]     += alpha * sa[i];      m0 += std::fabs(da[i]);
+            da[i + 1] += alpha * sa[i + 1];  m1 += std::fabs(da[i + 1]);
+            da[i + 2] += alpha * sa[i + 2];  m2 += std::fabs(da[i + 2]);
+            da[i + 3] += alpha * sa[i + 3];  m3 += std::fabs(da[i + 3]);
+        }
+        for (; i < ns_; ++i) { da[i] += alpha * sa[i]; m0 += std::fabs(da[i]); }
+        d.c += alpha * s.c;
+        d.m  = (m0 + m1) + (m2 + m3);
+        d.r += std::fabs(alpha) * s.r + SLACK * (std::fabs(d.c) + d.m);
+    }
+
+    static void range(const Form& f, double& lo, double& hi) {
+        const double rad = up(f.m + f.r) + SLACK * std::fabs(f.c);
+        lo = f.c - rad;
+        hi = f.c + rad;
+    }
+
+    static double mag(const Form& f) {
+        double lo, hi;
+        range(f, lo, hi);
+        return std::max(std::fabs(lo), std::fabs(hi));
+    }
+
+    // dz(t) = clamp(t, -S, S) - t 를 [lo, hi] 에서 α·t + β ± δ 로 감쌈
+    void dead_zone(const Form& yu, double lo, double hi, Form& as) {
+        const double S = ysat_;
+        auto dz = [S](double t) { return std::clamp(t, -S, S) - t; };
+        double alpha;
+        if (lo >= S || hi <= -S)        alpha = -1.0;        // 전 구간 포화: 선형
+        else if (lo >= -S && hi <= S)   alpha = 0.0;         // 전 구간 선형 영역
+        else                            alpha = (dz(hi) - dz(lo)) / (hi - lo);   // 할선
+
+        double gmin = INFINITY, gmax = -INFINITY;
+        for (double t : { lo, hi, -S, S }) {
+            if (t < lo || t > hi) continue;
+            const double g = dz(t) - alpha * t;
+            gmin = std::min(gmin, g);
+            gmax = std::max(gmax, g);
+        }
+        const double beta  = 0.5 * (gmin + gmax);
+        const double delta = up(0.5 * (gmax - gmin) + SLACK * (std::fabs(gmin) + std::fabs(gmax)));
+
+        zero(as);
+        axpy(as, alpha, yu);
+        as.c += beta;
+        if (delta > 0.0) add_sym(as, fresh(), 0.0, delta);
+    }
+
+    // 기호 차수 축소 (zonotope reduction) — 스텝 시작 시점, 살아 있는 형식 L=8 개
+    // - 형식별 크기로 정규화한 Σ|a| 가 작은 기호를 골라 접음 (입력 탭 기호는 유지)
+    // - 접을 생성자 G_i (L 차원 열)를 정규화 좌표의 주성분 기저 V 로 감쌈
+    //     Σ G_i·ε_i ∈ Σ_j D·v_j·[-s_j, s_j],  s_j = Σ_i |v_jᵀ·D⁻¹·G_i|
+    //   → 새 기호 L 개. y_unsat 과 AW 항처럼 같이 움직이는 형식의 상관이 유지됨
+    //   (형식별 독립 반경으로 접으면 AW 수축이 사라져 범위가 발산)
+    // - V 의 직교성 오차는 Σ|a|·2^-36 을 독립 반경에 더해 흡수
+    void compact() {
+        constexpr int L = 8;
+        const int nfold = ns_ - (cap_ / 2 - L);
+        if (nfold <= 0) return;
+
+        double sc[L];
+        for (int p = 0; p < L; ++p) sc[p] = f_[p]->m + f_[p]->r + 1e-300;
+        std::vector<double> score(ns_, 0.0);
+        for (int p = 0; p < L; ++p)
+            for (int i = 0; i < ns_; ++i) score[i] += std::fabs(f_[p]->a[i]) / sc[p];
+        for (int t : { w1_, w2_, x1_, x2_ }) if (t >= 0) score[t] = INFINITY;
+        std::vector<int> idx(ns_);
+        for (int i = 0; i < ns_; ++i) idx[i] = i;
+        std::nth_element(idx.begin(), idx.begin() + nfold, idx.end(),
+                         [&](int a, int b) { return score[a] < score[b]; });
+        std::vector<char> fold(ns_, 0);
+        for (int i = 0; i < nfold; ++i) fold[idx[i]] = 1;
+
+        // 정규화 좌표 Gram 행렬 → 야코비 고유분해
+        double C[L][L] = {}, V[L][L] = {};
+        for (int i = 0; i < ns_; ++i) {
+            if (!fold[i]) continue;
+            double g[L];
+            for (int p = 0; p < L; ++p) g[p] = f_[p]->a[i] / sc[p];
+            for (int p = 0; p < L; ++p)
+                for (int q = p; q < L; ++q) C[p][q] += g[p] * g[q];
+        }
+        for (int p = 0; p < L; ++p) {
+            for (int q = 0; q < p; ++q) C[p][q] = C[q][p];
+            V[p][p] = 1.0;
+        }
+        jacobi(C, V);
+
+        double sj[L] = {}, slack[L] = {};
+        for (int i = 0; i < ns_; ++i) {
+            if (!fold[i]) continue;
+            double g[L];
+            for (int p = 0; p < L; ++p) { g[p] = f_[p]->a[i] / sc[p]; slack[p] += std::fabs(f_[p]->a[i]); }
+            for (int j = 0; j < L; ++j) {
+                double d = 0.0;
+                for (int p = 0; p < L; ++p) d += V[p][j] * g[p];
+                sj[j] += std::fabs(d);
+            }
+        }
+
+        std::vector<int> remap(ns_, -1);
+        int j = 0;
+        for (int i = 0; i < ns_; ++i) if (!fold[i]) remap[i] = j++;
+        for (Form& f : pool_) {
+            for (int i = 0; i < ns_; ++i) if (!fold[i]) f.a[remap[i]] = f.a[i];
+            std::fill(f.a.begin() + j, f.a.begin() + j + L, 0.0);
+        }
+        for (int p = 0; p < L; ++p) {
+            Form& f = *f_[p];
+            for (int q = 0; q < L; ++q) f.a[j + q] = up(sc[p] * V[p][q] * sj[q]);
+            f.r = up(f.r + slack[p] * 0x1p-36);
+            f.m = 0.0;
+            for (int i = 0; i < j + L; ++i) f.m += std::fabs(f.a[i]);
+        }
+        for (int* t : { &w1_, &w2_, &x1_, &x2_ }) if (*t >= 0) *t = remap[*t];
+        ns_ = j + L;
+        ++compactions_;
+    }
+
+    // 대칭 행렬 고유분해 (순환 야코비). A 는 대각화되고 V 열이 고유벡터
+    template <int L>
+    static void jacobi(double (&A)[L][L], double (&V)[L][L]) {
+        for (int sweep = 0; sweep < 50; ++sweep) {
+            double off = 0.0;
+            for (int p = 0; p < L; ++p)
+                for (int q = p + 1; q < L; ++q) off += A[p][q] * A[p][q];
+            if (off < 1e-30) break;
+            for (int p = 0; p < L; ++p)
+                for (int q = p + 1; q < L; ++q) {
+                    if (std::fabs(A[p][q]) < 1e-300) continue;
+                    const double th = 0.5 * (A[q][q] - A[p][p]) / A[p][q];
+                    const double t  = (th >= 0 ? 1.0 : -1.0) / (std::fabs(th) + std::sqrt(th * th + 1.0));
+                    const double c  = 1.0 / std::sqrt(t * t + 1.0), s = t * c;
+                    for (int k = 0; k < L; ++k) {
+                        const double akp = A[k][p], akq = A[k][q];
+                        A[k][p] = c * akp - s * akq;
+                        A[k][q] = s * akp + c * akq;
+                    }
+                    for (int k = 0; k < L; ++k) {
+                        const double apk = A[p][k], aqk = A[q][k];
+                        A[p][k] = c * apk - s * aqk;
+                        A[q][k] = s * apk + c * aqk;
+                    }
+                    for (int k = 0; k < L; ++k) {
+                        const double vkp = V[k][p], vkq = V[k][q];
+                        V[k][p] = c * vkp - s * vkq;
+                        V[k][q] = s * vkp + c * vkq;
+                    }
+                }
+        }
+    }
+
+    std::array<double, NT> ideal_, chat_, cdif_;
+    double        ysat_;
+    DriftEnvelope env_;
+    DriftMac      mac_;
+    int           cap_, ns_ = 0;
+    long          compactions_ = 0;
+
+    Form  pool_[16];
+    Form* f_[16];
+    int   w1_ = -1, w2_ = -1, x1_ = -1, x2_ = -1;     // -1: 리셋 값 0 (정확)
+    DriftStep last_{};
+};
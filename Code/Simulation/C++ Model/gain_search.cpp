@@ -0,0 +1,89 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+#include "gain_search.hpp"
+
+// ============================================================
+//  적응형 게인 탐색 vs 전수 격자 (같은 탐색 상자/목적함수)
+//  - 빌드: g++ -O2 -std=c++20 -fno-fast-math -ffp-contract=off -pthread gain_search.cpp
+//  - 사용: ./a.out [budget] [grid_per_axis] [cache_dir]
+//          grid_per_axis = 0 이면 격자 비교 생략
+// ============================================================
+
+static void print_best(const char* tag, const SearchResult& r, long sims, double ms) {
+    std::cout << std::fixed << std::setprecision(5)
+              << tag << " : cost=" << std::setw(10) << r.cost
+              << "  Kp=" << r.p.g.Kp << " Ki=" << r.p.g.Ki << " Td=" << r.p.g.Kd / r.p.g.Kp
+              << " N=" << std::setprecision(1) << r.p.g.N << " Kb=" << r.p.g.Kb
+              << std::setprecision(3) << "  | OS=" << r.m.overshoot << "% settle=" << r.m.settle_s
+              << "s iae=" << r.m.iae << "  sims=" << sims
+              << "  " << std::setprecision(1) << ms << " ms\n";
+}
+
+int main(int argc, char** argv) {
+    const long        budget = (argc > 1) ? std::atol(argv[1]) : 400;
+    const int         grid   = (argc > 2) ? std::atoi(argv[2]) : 7;
+    const std::string cdir   = (argc > 3) ? argv[3] : "";
+
+    SearchBox       box;
+    SearchObjective obj;
+    SweepEval       ev;
+    ev.gates = 1000;
+    const SweepPoint base{ DEFAULT_GAINS, 50.0, 5.0 };
+
+    std::unique_ptr<SimCache> cache;
+    if (!cdir.empty()) cache.reset(new SimCache(cdir, 256ull << 20));
+
+    GainSearch::Options opt;
+    opt.budget = budget;
+    GainSearch gs(box, base, ev, obj, opt, cache.get());
+
+    {
+        const float c = obj.cost(evaluate_point(base, ev));
+        std::cout << "DEFAULT_GAINS cost = " << std::fixed << std::setprecision(5) << c << "\n";
+    }
+
+    auto t0 = std::chrono::steady_clock::now();
+    const std::vector<SearchResult>& res = gs.run();
+    auto t1 = std::chrono::steady_clock::now();
+    print_best("adaptive", res.front(), gs.simulations(), std::chrono::duration<double, std::milli>(t1 - t0).count());
+    std::cout << "  rounds=" << gs.rounds() << "  top-5 cost:";
+    for (size_t i = 0; i < std::min<size_t>(5, res.size()); ++i) std::cout << " " << std::setprecision(4) << res[i].cost;
+    std::cout << "\n";
+
+    if (grid <= 0) return 0;
+
+    // 전수 격자 (셀 중심, 정규화 좌표)
+    t0 = std::chrono::steady_clock::now();
+    SearchResult best{};
+    best.cost = INFINITY;
+    long n = 0;
+    std::vector<SearchResult> pts;
+    for (long idx = 0, tot = (long)std::pow(grid, SearchBox::ND); idx < tot; ++idx) {
+        SearchResult r{};
+        long k = idx;
+        for (int d = 0; d < SearchBox::ND; ++d) { r.u[d] = ((double)(k % grid) + 0.5) / (double)grid; k /= grid; }
+        r.p = gs.point_of(r.u);
+        pts.push_back(r);
+    }
+    std::vector<std::thread> pool;
+    const unsigned nt = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned t = 0; t < nt; ++t)
+        pool.emplace_back([&, t] {
+            for (size_t i = t; i < pts.size(); i += nt) {
+                pts[i].m    = evaluate_point(pts[i].p, ev);
+                pts[i].cost = obj.cost(pts[i].m);
+            }
+        });
+    for (auto& th : pool) th.join();
+    for (const SearchResult& r : pts) { ++n; if (r.cost < best.cost) best = r; }
+    t1 = std::chrono::steady_clock::now();
+    print_best("grid    ", best, n, std::chrono::duration<double, std::milli>(t1 - t0).count());
+    std::cout << "  adaptive/grid runs = 1/" << std::setprecision(1) << (double)n / (double)gs.simulations()
+              << "   cost ratio = " << std::setprecision(4) << res.front().cost / best.cost << "\n";
+    return 0;
+}
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "sweep.hpp"
+
+// ============================================================
+//  적응형 게인 탐색 (전수 격자 대체)
+//  - 탐색 변수 5개 (모두 로그 스케일): Kp, Ki, Td, N, Kb   (Kd = Kp·Td)
+//    b, c 와 식물(Ku, lam), 시나리오는 고정
+//  - 1) 라틴 하이퍼큐브(LHS) 조대 샘플 : 예산의 coarse_frac
+//    2) 상위 elite 개 주변에서 가우시안 샘플 (정규화 좌표, 반경 r)
+//       라운드에서 최고값이 개선되면 r 유지/확대, 아니면 축소 (신뢰 영역)
+//  - 배치 단위 병렬 평가. 각 평가는 독립이고 선택은 (비용, 평가 순번) 으로
+//    정렬하므로 스레드 수와 무관하게 결과 동일
+//  - 비용은 SearchObjective 가중 합 (작을수록 좋음)
+// ============================================================
+
+struct SearchObjective {
+    float w_iae       = 1.0f;
+    float w_overshoot = 2.0f;    // [%] 당
+    float w_effort    = 0.01f;   // [V] 당
+    float w_sat       = 0.0f;
+
+    float cost(const StepMetrics& m) const {
+        if (!std::isfinite(m.iae)) return INFINITY;
+        return w_iae * m.iae + w_overshoot * m.overshoot + w_effort * m.effort + w_sat * m.sat_ratio;
+    }
+};
+
+struct SearchBox {
+    static constexpr int ND = 5;
+    double lo[ND] = { 0.01, 0.005, 1e-4, 5.0,   1.0 };    // Kp Ki Td N Kb
+    double hi[ND] = { 1.0,  2.0,   0.05, 500.0, 100.0 };
+
+    // 정규화 좌표 u ∈ [0,1]^5 → 값 (로그 보간)
+    double value(int d, double u) const { return lo[d] * std::pow(hi[d] / lo[d], u); }
+};
+
+struct SearchResult {
+    double      u[SearchBox::ND];
+    SweepPoint  p;
+    StepMetrics m;
+    float       cost;
+    long        order;   // 평가 순번 (동률 정리용)
+};
+
+class GainSearch {
+public:
+    struct Options {
+        long     budget      = 400;     // 총 시뮬레이션 수
+        double   coarse_frac = 0.25;
+        int      batch       = 32;
+        int      elite       = 4;
+        double   r0          = 0.15;    // 초기 반경 (정규화 좌표)
+        double   r_min       = 0.005;
+        unsigned threads     = 0;
+        uint32_t seed        = 1;
+    };
+
+    GainSearch(const SearchBox& box, const SweepPoint& base, const SweepEval& ev,
+               const SearchObjective& obj, const Options& opt, SimCache* cache = nullptr)
+        : box_(box), base_(base), ev_(ev), obj_(obj), opt_(opt), cache_(cache), rng_(opt.seed)
+    {
+        threads_ = opt_.threads ? opt_.threads : std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    SweepPoint point_of(const double* u) const {
+        SweepPoint p = base_;
+        p.g.Kp = box_.value(0, u[0]);
+        p.g.Ki = box_.value(1, u[1]);
+        p.g.Kd = p.g.Kp * box_.value(2, u[2]);
+        p.g.N  = box_.value(3, u[3]);
+        p.g.Kb = box_.value(4, u[4]);
+        return p;
+    }
+
+    // 예산 소진까지 실행. 반환: 비용 오름차순 전체 평가 결과
+    const std::vector<SearchResult>& run() {
+        const int ND = SearchBox::ND;
+
+        // 1) LHS
+        const long n0 = std::max<long>(opt_.batch, (long)(opt_.coarse_frac * (double)opt_.budget));
+        {
+            std::vector<std::vector<double>> U(n0, std::vector<double>(ND));
+            std::uniform_real_distribution<double> uni(0.0, 1.0);
+            for (int d = 0; d < ND; ++d) {
+                std::vector<long> perm(n0);
+                for (long i = 0; i < n0; ++i) perm[i] = i;
+                std::shuffle(perm.begin(), perm.end(), rng_);
+                for (long i = 0; i < n0; ++i) U[i][d] = ((double)perm[i] + uni(rng_)) / (double)n0;
+            }
+            evaluate(U);
+        }
+
+        // 2) 엘리트 주변 정밀화
+        double r = opt_.r0;
+        float  best = all_.front().cost;
+        std::normal_distribution<double> gauss(0.0, 1.0);
+        while ((long)all_.size() < opt_.budget) {
+            const long n = std::min<long>(opt_.batch, opt_.budget - (long)all_.size());
+            const int  k = std::min<int>(opt_.elite, (int)all_.size());
+            std::vector<std::vector<double>> U(n, std::vector<double>(ND));
+            for (long i = 0; i < n; ++i) {
+                const SearchResult& e = all_[i % k];
+                for (int d = 0; d < ND; ++d)
+                    U[i][d] = std::clamp(e.u[d] + r * gauss(rng_), 0.0, 1.0);
+            }
+            evaluate(U);
+            ++rounds_;
+            if (all_.front().cost < best) { best = all_.front().cost; r = std::min(opt_.r0, r * 1.25); }
+            else                          { r = std::max(opt_.r_min, r * 0.6); }
+        }
+        return all_;
+    }
+
+    const std::vector<SearchResult>& results() const { return all_; }
+    long rounds() const { return rounds_; }
+    long simulations() const { return sims_; }      // 캐시 적중 제외 실제 시뮬레이션 수
+
+private:
+    void evaluate(const std::vector<std::vector<double>>& U) {
+        const size_t n = U.size();
+        std::vector<SearchResult> out(n);
+        for (size_t i = 0; i < n; ++i) {
+            std::copy(U[i].begin(), U[i].end(), out[i].u);
+            out[i].p = point_of(out[i].u);
+        }
+
+        // 캐시는 스레드 안전하지 않으므로 조회/저장은 직렬, 미스만 병렬 계산
+        std::vector<size_t> miss;
+        for (size_t i = 0; i < n; ++i)
+            if (!cache_ || !cache_->get(sim_key(out[i].p, ev_), out[i].m)) miss.push_back(i);
+        parallel_for(miss.size(), [&](size_t j) { out[miss[j]].m = evaluate_point(out[miss[j]].p, ev_); });
+        if (cache_) for (size_t i : miss) cache_->put(sim_key(out[i].p, ev_), out[i].m);
+        sims_ += (long)miss.size();
+        for (size_t i = 0; i < n; ++i) {
+            out[i].cost  = obj_.cost(out[i].m);
+            out[i].order = order_++;
+            all_.push_back(out[i]);
+        }
+        std::sort(all_.begin(), all_.end(), [](const SearchResult& a, const SearchResult& b) {
+            return (a.cost != b.cost) ? a.cost < b.cost : a.order < b.order;
+        });
+    }
+
+    template <class F>
+    void parallel_for(size_t n, F&& f) {
+        std::vector<std::thread> pool;
+        const size_t nt = std::min<size_t>(threads_, n);
+        for (size_t t = 1; t < nt; ++t)
+            pool.emplace_back([&, t] { for (size_t i = t; i < n; i += nt) f(i); });
+        for (size_t i = 0; i < n; i += std::max<size_t>(1, nt)) f(i);
+        for (auto& th : pool) th.join();
+    }
+
+    SearchBox                 box_;
+    SweepPoint                base_;
+    SweepEval                 ev_;
+    SearchObjective           obj_;
+    Options                   opt_;
+    SimCache*                 cache_;
+    std::mt19937              rng_;
+    unsigned                  threads_ = 1;
+    std::vector<SearchResult> all_;
+    long                      order_ = 0, rounds_ = 0, sims_ = 0;
+};
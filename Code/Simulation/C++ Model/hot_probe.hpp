@@ -0,0 +1,209 @@
+#pragma once
+
+// ============================================================
+//  핫패스 계측 (스코프 타이머 + 스레드별 로그2 히스토그램)
+//  - -DPID_PROFILE 일 때만 활성. 아니면 PID_PROBE(...) 는 빈 문장
+//  - 시계: x86-64 는 rdtsc, 그 외 clock_gettime(CLOCK_MONOTONIC)
+//  - 기록: 스레드마다 자기 블록에만 쓴다 (단일 작성자, relaxed 원자 → 잠금 없음)
+//          블록은 스레드 첫 사용 시 한 번만 뮤텍스로 등록, 종료 시까지 유지
+//  - 프로세스 종료 시 전 스레드 합산 후 stderr 로 출력
+//      (PID_PROFILE_OUT 환경변수가 있으면 그 파일로)
+//  - 사용: { PID_PROBE("ctrl.step"); ... }   이름은 문자열 리터럴
+// ============================================================
+
+#ifdef PID_PROFILE
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define PID_PROBE_TSC 1
+#else
+#include <time.h>
+#define PID_PROBE_TSC 0
+#endif
+
+namespace pid_prof {
+
+constexpr int MAX_PROBES = 64;
+constexpr int N_BUCKETS  = 48;      // bucket b : [2^b, 2^(b+1)) ticks
+
+static inline uint64_t now() {
+#if PID_PROBE_TSC
+    return __rdtsc();
+#else
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1'000'000'000ull + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+struct Slot {
+    std::atomic<uint64_t> count{ 0 };
+    std::atomic<uint64_t> total{ 0 };
+    std::atomic<uint64_t> max{ 0 };
+    std::atomic<uint64_t> hist[N_BUCKETS] = {};
+
+    // 단일 작성자: load+store (lock 접두어 없음)
+    static void bump(std::atomic<uint64_t>& a, uint64_t v) {
+        a.store(a.load(std::memory_order_relaxed) + v, std::memory_order_relaxed);
+    }
+
+    void record(uint64_t d) {
+        bump(count, 1);
+        bump(total, d);
+        if (d > max.load(std::memory_order_relaxed)) max.store(d, std::memory_order_relaxed);
+        const int b = 63 - __builtin_clzll(d | 1);
+        bump(hist[b < N_BUCKETS ? b : N_BUCKETS - 1], 1);
+    }
+};
+
+struct ThreadBlock {
+    Slot slot[MAX_PROBES];
+};
+
+class Registry {
+public:
+    static Registry& get() {
+        static Registry r;
+        return r;
+    }
+
+    int add(const char* name) {
+        std::lock_guard<std::mutex> g(mu_);
+        for (int i = 0; i < n_probes_; ++i)
+            if (std::strcmp(names_[i], name) == 0) return i;
+        if (n_probes_ == MAX_PROBES) return MAX_PROBES - 1;     // 넘치면 마지막 칸 공유
+        names_[n_probes_] = name;
+        return n_probes_++;
+    }
+
+    ThreadBlock* attach() {
+        std::lock_guard<std::mutex> g(mu_);
+        blocks_.emplace_back(new ThreadBlock);
+        return blocks_.back().get();
+    }
+
+    ~Registry() { dump(); }
+
+private:
+    Registry()
+        : t0_tick_(now()), t0_(std::chrono::steady_clock::now()) {}
+
+    // tick → ns (TSC 는 실행 구간 전체로 보정)
+    double ns_per_tick() const {
+#if PID_PROBE_TSC
+        const uint64_t dt = now() - t0_tick_;
+        const double   ns = std::chrono::duration<double, std::nano>(
+                                std::chrono::steady_clock::now() - t0_).count();
+        return (dt > 0) ? ns / (double)dt : 1.0;
+#else
+        return 1.0;
+#endif
+    }
+
+    // 빈 프로브 비용 (연속 now() 두 번)
+    static uint64_t probe_floor() {
+        uint64_t best = ~0ull;
+        for (int i = 0; i < 1000; ++i) {
+            const uint64_t a = now();
+            const uint64_t b = now();
+            if (b - a < best) best = b - a;
+        }
+        return best;
+    }
+
+    // 히스토그램에서 분위수 추정 (버킷 기하 중앙값)
+    static double quantile(const uint64_t* h, uint64_t n, double q) {
+        const uint64_t target = (uint64_t)(q * (double)n);
+        uint64_t acc = 0;
+        for (int b = 0; b < N_BUCKETS; ++b) {
+            acc += h[b];
+            if (acc > target) return (double)(1ull << b) * 1.41421356;
+        }
+        return 0.0;
+    }
+
+    void dump() {
+        if (n_probes_ == 0) return;
+        FILE* f = stderr;
+        const char* path = std::getenv("PID_PROFILE_OUT");
+        if (path && *path) {
+            FILE* o = std::fopen(path, "w");
+            if (o) f = o;
+        }
+        const double k = ns_per_tick();
+
+        std::fprintf(f, "# probe profile (%zu threads, %.3f ns/tick, empty probe %.1f ns)\n",
+                     blocks_.size(), k, (double)probe_floor() * k);
+        std::fprintf(f, "%-24s %12s %10s %10s %10s %10s %12s\n",
+                     "probe", "calls", "mean[ns]", "p50[ns]", "p99[ns]", "max[ns]", "total[ms]");
+        for (int i = 0; i < n_probes_; ++i) {
+            uint64_t n = 0, tot = 0, mx = 0, h[N_BUCKETS] = {};
+            for (const auto& blk : blocks_) {
+                const Slot& s = blk->slot[i];
+                n   += s.count.load(std::memory_order_relaxed);
+                tot += s.total.load(std::memory_order_relaxed);
+                const uint64_t m = s.max.load(std::memory_order_relaxed);
+                if (m > mx) mx = m;
+                for (int b = 0; b < N_BUCKETS; ++b) h[b] += s.hist[b].load(std::memory_order_relaxed);
+            }
+            if (n == 0) continue;
+            std::fprintf(f, "%-24s %12llu %10.1f %10.1f %10.1f %10.1f %12.3f\n",
+                         names_[i], (unsigned long long)n,
+                         (double)tot / (double)n * k,
+                         quantile(h, n, 0.50) * k, quantile(h, n, 0.99) * k,
+                         (double)mx * k, (double)tot * k * 1e-6);
+        }
+        if (f != stderr) std::fclose(f);
+    }
+
+    std::mutex  mu_;
+    const char* names_[MAX_PROBES] = {};
+    int         n_probes_ = 0;
+    std::vector<std::unique_ptr<ThreadBlock>> blocks_;
+    uint64_t    t0_tick_;
+    std::chrono::steady_clock::time_point t0_;
+};
+
+static inline ThreadBlock& thread_block() {
+    thread_local ThreadBlock* tb = nullptr;
+    if (__builtin_expect(tb == nullptr, 0)) tb = Registry::get().attach();
+    return *tb;
+}
+
+// 슬롯 조회(TLS)는 시작 시각 전에 끝내 측정 구간에 넣지 않는다
+class Scoped {
+public:
+    explicit Scoped(int id) : slot_(&thread_block().slot[id]), t0_(now()) {}
+    ~Scoped() { slot_->record(now() - t0_); }
+    Scoped(const Scoped&) = delete;
+    Scoped& operator=(const Scoped&) = delete;
+
+private:
+    Slot*    slot_;
+    uint64_t t0_;
+};
+
+} // namespace pid_prof
+
+#define PID_PROBE_CAT2(a, b) a##b
+#define PID_PROBE_CAT(a, b)  PID_PROBE_CAT2(a, b)
+#define PID_PROBE(name)                                                                  \
+    static const int PID_PROBE_CAT(pid_probe_id_, __LINE__) =                             \
+        ::pid_prof::Registry::get().add(name);                                           \
+    ::pid_prof::Scoped PID_PROBE_CAT(pid_probe_, __LINE__)(PID_PROBE_CAT(pid_probe_id_, __LINE__))
+
+#else
+
+#define PID_PROBE(name) do { } while (0)
+
+#endif
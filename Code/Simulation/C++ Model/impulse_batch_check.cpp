@@ -0,0 +1,97 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "impulse_response.hpp"
+
+// ============================================================
+//  임펄스 응답 중첩 vs 게이트 스텝 (프로파일 묶음)
+//  - 빌드: g++ -O2 -std=c++20 -fno-fast-math -ffp-contract=off impulse_batch_check.cpp
+//  - 사용: ./a.out [profiles] [gates]
+//  - 프로파일: 랜덤 스텝/램프 조합, 일부는 포화를 일으키는 큰 스텝
+//      sparse : 그대로 (계단/램프 중첩 경로)
+//      dense  : 잡음을 섞음 (FFT 또는 직접 스텝 중 비용 추정이 작은 쪽)
+//  - 둘 다 게이트 스텝과 결과/시간 비교
+// ============================================================
+
+static bool run(const LinearLoop& proto, long P, long N, bool dense) {
+    // ---- 프로파일 생성 ----
+    std::mt19937 rng(1234);
+    std::uniform_real_distribution<float> lvl(0.0f, 80.0f);
+    std::uniform_int_distribution<long>   at(0, N - 1);
+    std::normal_distribution<float>       noise(0.0f, 0.5f);
+    std::vector<float> W(P * N);
+    for (long p = 0; p < P; ++p) {
+        float* w = &W[p * N];
+        const long  t1 = at(rng), t2 = at(rng);
+        const float a = lvl(rng), b = lvl(rng);
+        const float big = (p % 10 == 0) ? 400.0f : 0.0f;    // 10% 는 포화 유발
+        for (long n = 0; n < N; ++n) {
+            float v = (n >= t1) ? a : 0.0f;
+            if (n >= t2) v += b + 0.0078125f * (float)(n - t2);  // 램프 (2^-7 기울기: float 로 정확)
+            if (n >= N / 2) v += big;
+            if (dense) v += noise(rng);
+            w[n] = v;
+        }
+    }
+
+    // ---- 기준: 게이트 스텝 ----
+    std::vector<float> Yref(P * N), Xref(P * N);
+    const auto t0 = std::chrono::steady_clock::now();
+    for (long p = 0; p < P; ++p) {
+        LinearLoop loop = proto;
+        for (long n = 0; n < N; ++n) {
+            const GateSample s = loop.step(W[p * N + n]);
+            Yref[p * N + n] = s.y;  Xref[p * N + n] = s.x_true;
+        }
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+
+    // ---- 임펄스 응답 중첩 ----
+    ImpulseResponseEngine eng(proto);
+    std::vector<float> Y(P * N), X(P * N);
+    std::vector<long>  exact_from(P);
+    const auto t2 = std::chrono::steady_clock::now();
+    eng.evaluate_batch(W.data(), P, N, Y.data(), X.data(), exact_from.data());
+    const auto t3 = std::chrono::steady_clock::now();
+
+    float max_err = 0.0f;
+    long  n_direct = 0, n_exact = 0;
+    for (long p = 0; p < P; ++p) {
+        if (exact_from[p] == 0)      ++n_direct;
+        else if (exact_from[p] < N)  ++n_exact;
+        for (long n = 0; n < N; ++n)
+            max_err = std::max(max_err, std::fabs(Y[p * N + n] - Yref[p * N + n]));
+    }
+
+    const double ms_step = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    const double ms_eng  = std::chrono::duration<double, std::milli>(t3 - t2).count();
+    const float  TOL = 1e-3f;
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "[" << (dense ? "dense" : "sparse") << "]\n";
+    std::cout << "stepping     : " << ms_step << " ms\n";
+    std::cout << "superposition: " << ms_eng << " ms  (x" << ms_step / ms_eng << ", direct " << n_direct << "/" << P
+              << ", exact fallback " << n_exact << "/" << P << ")\n";
+    std::cout << "max |y_eng - y_step| = " << std::setprecision(9) << max_err
+              << ((max_err <= TOL) ? "  ==> PASS" : "  ==> FAIL") << " (tol=" << std::setprecision(3) << TOL << ")\n";
+    return max_err <= TOL;
+}
+
+int main(int argc, char** argv) {
+    const long P = (argc > 1) ? std::atol(argv[1]) : 1000;
+    const long N = (argc > 2) ? std::atol(argv[2]) : 4000;
+
+    const float Ts = 0.005f, Ku = 50.0f, lam = 5.0f;
+    const LinearLoop proto(IdealSensor<RoundNative>(), DeltaPid2TapAw<RoundNative>(YSAT),
+                           FirstOrderPlant<RoundNative>(Ku, lam, Ts));
+
+    std::cout << "profiles=" << P << " gates=" << N << " h_len=" << ImpulseResponseEngine(proto).length() << "\n";
+    bool ok = run(proto, P, N, false);
+    ok &= run(proto, P, N, true);
+    std::cout << (ok ? "==> PASS" : "==> FAIL") << "\n";
+    return ok ? 0 : 1;
+}
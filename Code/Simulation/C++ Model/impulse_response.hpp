@@ -0,0 +1,282 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <memory>
+#include <vector>
+
+#include "linear_model.hpp"
+
+// ============================================================
+//  임펄스 응답 중첩(superposition) 빠른 경로
+//  - 정지 상태에서 시작하는 선형 루프(비포화, 이상 센서)는 w → (y, x_true)
+//    에 대해 LTI 이므로 구성당 한 번 h_y, h_x 를 구해두고
+//      y = h_y * w,  x_true = h_x * w
+//    를 합성곱으로 계산한다.
+//  - 목표값이 구간별 상수/램프이면 Δw 또는 Δ²w 가 희소하므로 계단/램프
+//    응답의 이동 합으로 직접 중첩 (샘플당 nnz 회 곱셈-덧셈, 벡터화)
+//  - 그 외(조밀)에는 FFT 합성곱 (h_y + i·h_x 를 한 번에 변환) 과 FP32 루프
+//    직접 스텝 중 비용 추정이 작은 쪽. 게이트 1회 ≈ STEP_COST 곱셈-덧셈이라
+//    FFT (샘플당 ≈ 16·log2(2n)) 는 스텝이 그보다 비쌀 때만 이김
+//  - 합성곱 결과에서 처음 |y| >= YSAT 가 되는 샘플 k 를 찾으면
+//    k 직전 상태를 (y, x, w) 로부터 복원하고 k 부터는 FP32 루프로 정확 스텝
+// ============================================================
+
+// 반경 2 반복 FFT (double). 크기별 twiddle 캐시
+class Fft {
+public:
+    using cd = std::complex<double>;
+
+    explicit Fft(size_t n) : n_(n), tw_(n / 2), rev_(n) {
+        const double PI = 3.14159265358979323846;
+        for (size_t i = 0; i < n / 2; ++i)
+            tw_[i] = std::polar(1.0, -2.0 * PI * (double)i / (double)n);
+        size_t bits = 0;
+        while (((size_t)1 << bits) < n) ++bits;
+        for (size_t i = 0; i < n; ++i) {
+            size_t r = 0;
+            for (size_t b = 0; b < bits; ++b) if (i & ((size_t)1 << b)) r |= (size_t)1 << (bits - 1 - b);
+            rev_[i] = r;
+        }
+    }
+
+    size_t size() const { return n_; }
+
+    void forward(cd* a) const { transform(a, false); }
+
+    void inverse(cd* a) const {
+        transform(a, true);
+        const double s = 1.0 / (double)n_;
+        for (size_t i = 0; i < n_; ++i) a[i] *= s;
+    }
+
+    // std::complex operator* 는 NaN 처리(__muldc3) 때문에 느리므로 직접 전개
+    static cd cmul(const cd& a, const cd& b) {
+        return cd(a.real() * b.real() - a.imag() * b.imag(),
+                  a.real() * b.imag() + a.imag() * b.real());
+    }
+
+private:
+    void transform(cd* a, bool inv) const {
+        for (size_t i = 0; i < n_; ++i) if (i < rev_[i]) std::swap(a[i], a[rev_[i]]);
+        for (size_t len = 2; len <= n_; len <<= 1) {
+            const size_t half = len / 2, stride = n_ / len;
+            for (size_t i = 0; i < n_; i += len) {
+                for (size_t j = 0; j < half; ++j) {
+                    const cd w = inv ? std::conj(tw_[j * stride]) : tw_[j * stride];
+                    const cd u = a[i + j];
+                    const cd v = cmul(a[i + j + half], w);
+                    a[i + j]        = u + v;
+                    a[i + j + half] = u - v;
+                }
+            }
+        }
+    }
+
+    size_t          n_;
+    std::vector<cd> tw_;
+    std::vector<size_t> rev_;
+};
+
+class ImpulseResponseEngine {
+public:
+    using cd = std::complex<double>;
+
+    // tail_eps : |h| 가 peak*tail_eps 이하로 tail_hold 게이트 유지되면 절단
+    explicit ImpulseResponseEngine(const LinearLoop& proto,
+                                   double tail_eps = 1e-12, long max_len = 1L << 20)
+        : proto_(proto), lin_(proto)
+    {
+        const long tail_hold = 64;
+        double z[LinearLoopModel::NS] = {};
+        double peak = 0.0;
+        long   quiet = 0;
+        for (long n = 0; n < max_len; ++n) {
+            const double x = z[6];                       // 게이트 시작 시 속도
+            const double y = lin_.step(z, (n == 0) ? 1.0 : 0.0);
+            hy_.push_back(y);
+            hx_.push_back(x);
+            const double mag = std::max(std::fabs(y), std::fabs(x));
+            peak  = std::max(peak, mag);
+            quiet = (mag <= peak * tail_eps) ? quiet + 1 : 0;
+            if (quiet >= tail_hold) break;
+        }
+
+        // 계단/램프 응답 (누적합)
+        const long L = length();
+        sy_.resize(L); sx_.resize(L); ry_.resize(L); rx_.resize(L);
+        double ay = 0, ax = 0, by = 0, bx = 0;
+        for (long i = 0; i < L; ++i) {
+            ay += hy_[i];  ax += hx_[i];
+            by += ay;      bx += ax;
+            sy_[i] = ay;   sx_[i] = ax;
+            ry_[i] = by;   rx_[i] = bx;
+        }
+    }
+
+    long length() const { return (long)hy_.size(); }
+
+    // w[0..n) 평가. 반환값: 정확 스텝으로 전환된 샘플 (전 구간 선형이면 n)
+    //  (직접 스텝 경로면 0)
+    long evaluate(const float* w, long n, float* y, float* x_true) {
+        const double fft_cost  = fft_cost_estimate(n);
+        const double step_cost = STEP_COST * (double)n;
+        const double nnz_max   = std::min(fft_cost, step_cost) / (double)n;    // 중첩이 이기는 차분 수 상한
+
+        // 희소 차분 추출 (d1 = Δw, d2 = Δ²w, w[-1] = w[-2] = 0)
+        //  둘 다 nnz_max 를 넘으면 중첩은 탈락이므로 그만 셈
+        d1_.clear();  d2_.clear();
+        double wp = 0.0, dp = 0.0;
+        for (long i = 0; i < n; ++i) {
+            const double d = (double)w[i] - wp;
+            if (d != 0.0)       d1_.push_back({ i, d });
+            if (d - dp != 0.0)  d2_.push_back({ i, d - dp });
+            wp = (double)w[i];  dp = d;
+            if ((double)d1_.size() > nnz_max && (double)d2_.size() > nnz_max) break;
+        }
+
+        const double s1_cost  = (double)d1_.size() * (double)n;
+        const double s2_cost  = (double)d2_.size() * (double)n;
+        if (std::min({ s1_cost, s2_cost, fft_cost }) > step_cost) {
+            PID_PROBE("impulse.direct_step");
+            step_direct(w, n, y, x_true);
+            return 0;
+        }
+
+        ybuf_.assign(n, 0.0);
+        xbuf_.assign(n, 0.0);
+        {
+        PID_PROBE("impulse.convolve");
+        if (s1_cost <= fft_cost && d1_.size() <= d2_.size())
+            superpose(d1_, sy_, sx_, false, n);
+        else if (s2_cost <= fft_cost)
+            superpose(d2_, ry_, rx_, true, n);
+        else
+            convolve_fft(w, n);
+        }
+
+        const float lim = proto_.controller().y_sat_limit();
+        long k = n;
+        for (long i = 0; i < n; ++i) {
+            if (std::fabs(ybuf_[i]) >= (double)lim) { k = i; break; }
+            y[i]      = (float)ybuf_[i];
+            x_true[i] = (float)xbuf_[i];
+        }
+        if (k == n) return n;
+
+        // k 직전 상태 복원: dy1 = y[k-1]-y[k-2], yu1 = y[k-1], xp = x[k] ...
+        auto yv = [&](long i) { return (i >= 0) ? ybuf_[i] : 0.0; };
+        auto xv = [&](long i) { return (i >= 0) ? xbuf_[i] : 0.0; };
+        auto wv = [&](long i) { return (i >= 0) ? (double)w[i] : 0.0; };
+        double z[LinearLoopModel::NS];
+        z[0] = yv(k - 1) - yv(k - 2);
+        z[1] = wv(k - 1);  z[2] = wv(k - 2);
+        z[3] = xv(k - 1);  z[4] = xv(k - 2);
+        z[5] = yv(k - 1);
+        z[6] = xv(k);
+
+        PID_PROBE("impulse.exact_tail");
+        LinearLoop loop = proto_;
+        LinearLoopModel::load(loop, z);
+        for (long i = k; i < n; ++i) {
+            const GateSample s = loop.step(w[i]);
+            y[i] = s.y;  x_true[i] = s.x_true;
+        }
+        return k;
+    }
+
+    // 같은 길이의 프로파일 묶음 (행 우선 n_profiles × n)
+    // exact_from[p] = 정확 스텝 전환 샘플
+    void evaluate_batch(const float* W, long n_profiles, long n,
+                        float* Y, float* X, long* exact_from) {
+        for (long p = 0; p < n_profiles; ++p) {
+            const long k = evaluate(W + p * n, n, Y + p * n, X + p * n);
+            if (exact_from) exact_from[p] = k;
+        }
+    }
+
+private:
+    struct Impulse { long at; double v; };
+
+    // FP32 게이트 1회 (센서 + Δ-PID + 식물) 비용, 곱셈-덧셈 단위
+    //  (impulse_batch_check: 스텝 ≈ 15 ns/게이트, FFT ≈ 0.33 ns/단위)
+    static constexpr double STEP_COST = 40.0;
+
+    // 정지 상태부터 FP32 루프 그대로. evaluate 본문에 두면 게이트 스텝보다
+    // ~12% 느리게 생성되어 (GCC -O2 측정) 따로 둠
+    void step_direct(const float* w, long n, float* y, float* x_true) const {
+        LinearLoop loop = proto_;
+        for (long i = 0; i < n; ++i) {
+            const GateSample s = loop.step(w[i]);
+            y[i] = s.y;  x_true[i] = s.x_true;
+        }
+    }
+
+    // 응답 r 이 길이 L 에서 절단되었으면 이후는 마지막 값(정상상태)으로 연장
+    // (계단 응답은 상수, 램프 응답은 기울기 sy[L-1] 로 증가)
+    void superpose(const std::vector<Impulse>& d, const std::vector<double>& ry,
+                   const std::vector<double>& rx, bool ramp, long n) {
+        const long   L     = length();
+        const double sy_ss = sy_[L - 1], sx_ss = sx_[L - 1];
+        for (const Impulse& im : d) {
+            const long   m  = std::min(n - im.at, L);
+            double*      yb = &ybuf_[im.at];
+            double*      xb = &xbuf_[im.at];
+            for (long i = 0; i < m; ++i) {
+                yb[i] += im.v * ry[i];
+                xb[i] += im.v * rx[i];
+            }
+            for (long i = m; i < n - im.at; ++i) {
+                const double extra = ramp ? (double)(i - L + 1) : 0.0;
+                yb[i] += im.v * (ry[L - 1] + extra * sy_ss);
+                xb[i] += im.v * (rx[L - 1] + extra * sx_ss);
+            }
+        }
+    }
+
+    // 정·역변환 2회, 나비 1개 ≈ 곱셈-덧셈 4 회
+    double fft_cost_estimate(long n) const {
+        size_t sz = 1;
+        while (sz < (size_t)(2 * n - 1)) sz <<= 1;
+        return 2.0 * 4.0 * (double)sz * std::log2((double)sz);
+    }
+
+    void convolve_fft(const float* w, long n) {
+        prepare(n);
+        std::vector<cd>& buf = buf_;
+        std::fill(buf.begin(), buf.end(), cd(0.0, 0.0));
+        for (long i = 0; i < n; ++i) buf[i] = cd((double)w[i], 0.0);
+        fft_->forward(buf.data());
+        for (size_t i = 0; i < buf.size(); ++i) buf[i] = Fft::cmul(buf[i], G_[i]);
+        fft_->inverse(buf.data());
+        for (long i = 0; i < n; ++i) { ybuf_[i] = buf[i].real(); xbuf_[i] = buf[i].imag(); }
+    }
+
+    // 합성곱 길이 n + L - 1 이상의 2의 거듭제곱 크기로 G = FFT(h_y + i·h_x) 준비
+    //  (출력은 앞 n 샘플만 필요하므로 h 도 앞 n 개만 사용)
+    void prepare(long n) {
+        const long L = std::min(n, length());
+        size_t need = (size_t)(n + L - 1), sz = 1;
+        while (sz < need) sz <<= 1;
+        if (fft_ && fft_->size() == sz && g_len_ == L) return;
+        fft_.reset(new Fft(sz));
+        g_len_ = L;
+        G_.assign(sz, cd(0.0, 0.0));
+        for (long i = 0; i < L; ++i) G_[i] = cd(hy_[i], hx_[i]);
+        fft_->forward(G_.data());
+        buf_.assign(sz, cd(0.0, 0.0));
+    }
+
+    LinearLoop           proto_;
+    LinearLoopModel      lin_;
+    std::vector<double>  hy_, hx_;       // 임펄스 응답
+    std::vector<double>  sy_, sx_;       // 계단 응답
+    std::vector<double>  ry_, rx_;       // 램프 응답
+    std::vector<Impulse> d1_, d2_;
+    std::vector<double>  ybuf_, xbuf_;
+    std::unique_ptr<Fft> fft_;
+    std::vector<cd>      G_;
+    long                 g_len_ = 0;
+    std::vector<cd>      buf_;
+};
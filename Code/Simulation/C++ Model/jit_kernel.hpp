@@ -0,0 +1,355 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <vector>
+
+#if defined(__x86_64__) && defined(__linux__)
+#include <sys/mman.h>
+#define PID_JIT_AVAILABLE 1
+#else
+#define PID_JIT_AVAILABLE 0
+#endif
+
+#include "pid_model.hpp"
+
+// ============================================================
+//  DeltaPid2TapAw::step 런타임 특수화 (x86-64 SSE, 외부 JIT 의존 없음)
+//  - 계수 C0..C7B, YSAT 를 mov eax, imm32 / movd 로 코드에 직접 박는다
+//  - 계수 0  : 항 제거 (acc 는 +0 에서 시작하고 -0 이 될 수 없으므로
+//              acc + (±0) == acc, 유한 입력에서 비트 동일)
+//  - 계수 1  : mulss 생략 (1*s == s),  계수 -1 : addss → subss
+//  - MUL→ADD 각 단계 라운딩은 RoundNative/RoundVolatile 과 같다
+//  - 생성 직후 일반 커널과 상태/출력 비트 비교, 불일치면 폐기
+//  - 커널 ABI: float fn(DeltaPidState* st, float w, float x)
+//      rdi = st, xmm0 = w, xmm1 = x, 반환 xmm0 = y_sat
+// ============================================================
+
+using DeltaKernelFn = float (*)(DeltaPidState*, float, float);
+
+class X64Emitter {
+public:
+    enum Op : uint8_t { ADDSS = 0x58, MULSS = 0x59, SUBSS = 0x5C, MINSS = 0x5D, MAXSS = 0x5F };
+
+    // DeltaPidState 필드 오프셋
+    static constexpr uint8_t OFF_DY1 = offsetof(DeltaPidState, dy1);
+    static constexpr uint8_t OFF_W1  = offsetof(DeltaPidState, w1);
+    static constexpr uint8_t OFF_W2  = offsetof(DeltaPidState, w2);
+    static constexpr uint8_t OFF_X1  = offsetof(DeltaPidState, x1);
+    static constexpr uint8_t OFF_X2  = offsetof(DeltaPidState, x2);
+    static constexpr uint8_t OFF_YU1 = offsetof(DeltaPidState, y_unsat_1);
+    static constexpr uint8_t OFF_YU2 = offsetof(DeltaPidState, y_unsat_2);
+    static constexpr uint8_t OFF_YS1 = offsetof(DeltaPidState, y_sat_1);
+    static constexpr uint8_t OFF_YS2 = offsetof(DeltaPidState, y_sat_2);
+
+    const std::vector<uint8_t>& code() const { return buf_; }
+
+    // movss xmm, [rdi+disp8]
+    void load(int xmm, uint8_t disp)  { emit({ 0xF3, 0x0F, 0x10, modrm(1, xmm, 7), disp }); }
+    // movss [rdi+disp8], xmm
+    void store(uint8_t disp, int xmm) { emit({ 0xF3, 0x0F, 0x11, modrm(1, xmm, 7), disp }); }
+    // addss/mulss/subss/minss/maxss dst, src
+    void arith(Op op, int dst, int src) { emit({ 0xF3, 0x0F, (uint8_t)op, modrm(3, dst, src) }); }
+    // movaps dst, src
+    void mov(int dst, int src)        { emit({ 0x0F, 0x28, modrm(3, dst, src) }); }
+    // xorps xmm, xmm
+    void zero(int xmm)                { emit({ 0x0F, 0x57, modrm(3, xmm, xmm) }); }
+    // mov eax, imm32 ; movd xmm, eax
+    void imm(int xmm, float v) {
+        uint32_t u;
+        std::memcpy(&u, &v, 4);
+        emit({ 0xB8, (uint8_t)u, (uint8_t)(u >> 8), (uint8_t)(u >> 16), (uint8_t)(u >> 24) });
+        emit({ 0x66, 0x0F, 0x6E, modrm(3, xmm, 0) });
+    }
+    void ret() { emit({ 0xC3 }); }
+
+private:
+    static uint8_t modrm(int mod, int reg, int rm) {
+        return (uint8_t)((mod << 6) | ((reg & 7) << 3) | (rm & 7));
+    }
+    void emit(std::initializer_list<uint8_t> b) { buf_.insert(buf_.end(), b); }
+
+    std::vector<uint8_t> buf_;
+};
+
+class DeltaKernelJit {
+public:
+    DeltaKernelJit() = default;
+    DeltaKernelJit(const DeltaKernelJit&) = delete;
+    DeltaKernelJit& operator=(const DeltaKernelJit&) = delete;
+    ~DeltaKernelJit() { release(); }
+
+    // 생성 + 검증. 실패(미지원 플랫폼/불일치)면 false, fn() == nullptr
+    bool build(const DeltaCoeffs& k, float ysat) {
+        release();
+#if PID_JIT_AVAILABLE
+        const std::vector<uint8_t> code = emit(k, ysat);
+        void* p = mmap(nullptr, code.size(), PROT_READ | PROT_WRITE,
+                       MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (p == MAP_FAILED) return false;
+        std::memcpy(p, code.data(), code.size());
+        if (mprotect(p, code.size(), PROT_READ | PROT_EXEC) != 0) { munmap(p, code.size()); return false; }
+        mem_ = p;  size_ = code.size();
+        fn_  = reinterpret_cast<DeltaKernelFn>(p);
+        if (!verify(k, ysat)) { release(); return false; }
+        return true;
+#else
+        (void)k; (void)ysat;
+        return false;
+#endif
+    }
+
+    DeltaKernelFn fn() const { return fn_; }
+    size_t code_size() const { return size_; }
+
+private:
+    // xmm0 = w, xmm1 = x, xmm2 = acc, xmm3..5 임시
+    static std::vector<uint8_t> emit(const DeltaCoeffs& k, float ysat) {
+        X64Emitter e;
+        e.zero(2);                                    // acc = +0
+
+        // acc += c * s  (s 는 xmm 에 이미 있거나 [rdi+off] 에서 로드)
+        auto term = [&](float c, int src_xmm, int off) {
+            if (c == 0.0f) return;                    // 항 제거
+            int s = src_xmm;
+            if (s < 0) { e.load(3, (uint8_t)off); s = 3; }
+            if (c == 1.0f)       { e.arith(X64Emitter::ADDSS, 2, s); return; }
+            if (c == -1.0f)      { e.arith(X64Emitter::SUBSS, 2, s); return; }
+            if (s != 3) { e.mov(3, s); s = 3; }
+            e.imm(4, c);
+            e.arith(X64Emitter::MULSS, 3, 4);
+            e.arith(X64Emitter::ADDSS, 2, 3);
+        };
+        // e_sat = ys - yu  (a + (-b) 와 a - b 는 IEEE 상 동일)
+        auto esat_term = [&](float c, uint8_t off_ys, uint8_t off_yu) {
+            if (c == 0.0f) return;
+            e.load(5, off_ys);
+            e.load(3, off_yu);
+            e.arith(X64Emitter::SUBSS, 5, 3);
+            term(c, 5, 0);
+        };
+
+        term(k.c0, -1, X64Emitter::OFF_DY1);
+        term(k.c1,  0, 0);
+        term(k.c2, -1, X64Emitter::OFF_W1);
+        term(k.c3, -1, X64Emitter::OFF_W2);
+        term(k.c4,  1, 0);
+        term(k.c5, -1, X64Emitter::OFF_X1);
+        term(k.c6, -1, X64Emitter::OFF_X2);
+        esat_term(k.c7a, X64Emitter::OFF_YS1, X64Emitter::OFF_YU1);
+        esat_term(k.c7b, X64Emitter::OFF_YS2, X64Emitter::OFF_YU2);
+
+        // xmm3 = y_unsat = yu1 + dy
+        e.load(3, X64Emitter::OFF_YU1);
+        e.arith(X64Emitter::ADDSS, 3, 2);
+        // xmm5 = clamp(y_unsat, -YSAT, +YSAT)
+        //   maxss(lo, v) = lo > v ? lo : v,  minss(hi, t) = hi < t ? hi : t  (std::clamp 와 동일, NaN 통과)
+        e.imm(4, -ysat);
+        e.arith(X64Emitter::MAXSS, 4, 3);
+        e.imm(5, ysat);
+        e.arith(X64Emitter::MINSS, 5, 4);
+
+        // 상태 갱신
+        e.store(X64Emitter::OFF_DY1, 2);
+        e.load(4, X64Emitter::OFF_W1);   e.store(X64Emitter::OFF_W2, 4);
+        e.store(X64Emitter::OFF_W1, 0);
+        e.load(4, X64Emitter::OFF_X1);   e.store(X64Emitter::OFF_X2, 4);
+        e.store(X64Emitter::OFF_X1, 1);
+        e.load(4, X64Emitter::OFF_YU1);  e.store(X64Emitter::OFF_YU2, 4);
+        e.store(X64Emitter::OFF_YU1, 3);
+        e.load(4, X64Emitter::OFF_YS1);  e.store(X64Emitter::OFF_YS2, 4);
+        e.store(X64Emitter::OFF_YS1, 5);
+
+        e.mov(0, 5);
+        e.ret();
+        return e.code();
+    }
+
+    // 일반 커널과 비트 비교 (포화 구간 포함 랜덤 입력)
+    bool verify(const DeltaCoeffs& k, float ysat) const {
+        DeltaPid2TapAw<RoundNative> ref(ysat, k);
+        DeltaPidState st = ref.snapshot();
+        std::mt19937 rng(0x5EED);
+        std::uniform_real_distribution<float> u(-400.0f, 400.0f);
+        for (int i = 0; i < 4096; ++i) {
+            const float w = (i & 256) ? u(rng) : 100.0f;
+            const float x = u(rng);
+            const float y_ref = ref.step(w, x);
+            const float y_jit = fn_(&st, w, x);
+            const DeltaPidState s_ref = ref.snapshot();
+            if (f32_to_hex(y_ref) != f32_to_hex(y_jit)) return false;
+            if (std::memcmp(&s_ref, &st, sizeof(st)) != 0) return false;
+        }
+        return true;
+    }
+
+    void release() {
+#if PID_JIT_AVAILABLE
+        if (mem_) munmap(mem_, size_);
+#endif
+        mem_ = nullptr;  size_ = 0;  fn_ = nullptr;
+    }
+
+    void*         mem_  = nullptr;
+    size_t        size_ = 0;
+    DeltaKernelFn fn_   = nullptr;
+};
+
+// ============================================================
+//  JIT 사용 기준 (측정값) + 생성 코드 공유
+//  - 코드 모양 (계수마다 0 / 1 / -1 / 일반) 별로 프로세스에서 한 번 측정:
+//      build_ns   = build() (mmap + 검증 4096 스텝) 시간
+//      gain_ns    = 일반 step - JIT step  [ns/스텝]  (CAL_STEPS 스텝 × 3 회 중 최소)
+//      break_even = build_ns / gain_ns  (gain_ns <= 0 이면 사용 안 함)
+//  - 같은 계수/YSAT 커널이 이미 살아 있으면 (다른 채널, 복사본) 생성 비용이 없으므로
+//    기준과 무관하게 공유. 모든 소유자가 사라지면 코드도 해제 (weak_ptr)
+//  - 스레드 안전 (gain_search 의 parallel_for 에서 호출)
+// ============================================================
+class DeltaJitCache {
+public:
+    struct Calib {
+        double build_ns = 0.0, gain_ns = 0.0;
+        long   break_even = LONG_MAX;
+    };
+
+    static DeltaJitCache& instance() { static DeltaJitCache c; return c; }
+
+    // expected_steps 동안 쓸 커널. 기준 미달/생성 실패면 nullptr
+    std::shared_ptr<DeltaKernelJit> acquire(const DeltaCoeffs& k, float ysat, long expected_steps) {
+        std::lock_guard<std::mutex> lk(mu_);
+        const Key key = key_of(k, ysat);
+        if (auto it = code_.find(key); it != code_.end())
+            if (std::shared_ptr<DeltaKernelJit> p = it->second.lock()) return p;
+        if (expected_steps < calib_locked(k, ysat).break_even) return nullptr;
+        auto p = std::make_shared<DeltaKernelJit>();
+        if (!p->build(k, ysat)) return nullptr;
+        std::erase_if(code_, [](const auto& e) { return e.second.expired(); });
+        code_[key] = p;
+        return p;
+    }
+
+    Calib calib(const DeltaCoeffs& k, float ysat) {
+        std::lock_guard<std::mutex> lk(mu_);
+        return calib_locked(k, ysat);
+    }
+
+private:
+    using Key = std::array<uint32_t, 10>;
+    static constexpr int CAL_STEPS = 1 << 15;
+
+    static Key key_of(const DeltaCoeffs& k, float ysat) {
+        return { f32_to_hex(k.c0), f32_to_hex(k.c1), f32_to_hex(k.c2), f32_to_hex(k.c3), f32_to_hex(k.c4),
+                 f32_to_hex(k.c5), f32_to_hex(k.c6), f32_to_hex(k.c7a), f32_to_hex(k.c7b), f32_to_hex(ysat) };
+    }
+
+    // 계수마다 2 비트: 0 → 0, 1 → 1, -1 → 2, 일반 → 3 (emit() 의 분기와 같음)
+    static uint32_t shape_of(const DeltaCoeffs& k) {
+        const float c[9] = { k.c0, k.c1, k.c2, k.c3, k.c4, k.c5, k.c6, k.c7a, k.c7b };
+        uint32_t s = 0;
+        for (float v : c) s = (s << 2) | (v == 0.0f ? 0u : v == 1.0f ? 1u : v == -1.0f ? 2u : 3u);
+        return s;
+    }
+
+    template <class Step>
+    static double ns_per_step(Step&& step) {
+        double best = 1e30;
+        for (int r = 0; r < 3; ++r) {
+            float acc = 0.0f;
+            const auto t0 = std::chrono::steady_clock::now();
+            for (int i = 0; i < CAL_STEPS; ++i)
+                acc = acc + step(100.0f, (float)((i * 37) % 200 - 100) * INT2RADS);
+            const double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+            volatile float sink = acc;
+            (void)sink;
+            best = std::min(best, ns / CAL_STEPS);
+        }
+        return best;
+    }
+
+    const Calib& calib_locked(const DeltaCoeffs& k, float ysat) {
+        const uint32_t shape = shape_of(k);
+        if (auto it = calib_.find(shape); it != calib_.end()) return it->second;
+        Calib c;
+        DeltaKernelJit jit;
+        const auto t0 = std::chrono::steady_clock::now();
+        const bool ok = jit.build(k, ysat);
+        c.build_ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+        if (ok) {
+            DeltaPid2TapAw<RoundNative> ref(ysat, k);
+            DeltaPidState st = ref.snapshot();
+            const DeltaKernelFn fn = jit.fn();
+            const double t_ref = ns_per_step([&](float w, float x) { return ref.step(w, x); });
+            const double t_jit = ns_per_step([&](float w, float x) { return fn(&st, w, x); });
+            c.gain_ns = t_ref - t_jit;
+            if (c.gain_ns > 0.0) c.break_even = (long)std::min(c.build_ns / c.gain_ns, (double)LONG_MAX / 2);
+        }
+        return calib_.emplace(shape, c).first->second;
+    }
+
+    std::mutex                                          mu_;
+    std::map<uint32_t, Calib>                           calib_;
+    std::map<Key, std::weak_ptr<DeltaKernelJit>>        code_;
+};
+
+// ============================================================
+//  ClosedLoop ControllerPolicy: 실행 길이가 측정된 손익분기를 넘으면 JIT 커널,
+//  아니면(또는 생성 실패 시) 일반 DeltaPid2TapAw
+//  - 실행 길이는 ClosedLoop::run / LoopBank 가 prepare(steps) 로 알려줌
+//    (생성자의 expected_steps 는 같은 일을 미리 하는 것)
+//  - 출력/상태는 어느 쪽이든 비트 동일 (생성 시 검증)
+// ============================================================
+template <class Rnd = RoundVolatile>
+class JitDeltaPid2TapAw {
+public:
+    explicit JitDeltaPid2TapAw(float y_sat_limit, const DeltaCoeffs& k = COEFFS_HEX,
+                               long expected_steps = 0)
+        : ref_(y_sat_limit, k)
+    {
+        st_ = ref_.snapshot();
+        prepare(expected_steps);
+    }
+
+    // 앞으로 steps 스텝 실행 예정. 기준을 넘으면 현재 상태를 넘겨받아 JIT 로 전환
+    void prepare(long steps) {
+        if (fn_ || steps <= declined_) return;
+        jit_ = DeltaJitCache::instance().acquire(ref_.coeffs(), ref_.y_sat_limit(), steps);
+        if (!jit_) { declined_ = steps; return; }
+        st_ = ref_.snapshot();
+        fn_ = jit_->fn();
+    }
+
+    bool specialized() const { return fn_ != nullptr; }
+
+    void reset() { ref_.reset(); st_ = ref_.snapshot(); }
+
+    float step(float w, float x) {
+        if (fn_) return fn_(&st_, w, x);
+        return ref_.step(w, x);
+    }
+
+    DeltaPidState snapshot() const { return fn_ ? st_ : ref_.snapshot(); }
+    void restore(const DeltaPidState& s) { st_ = s; ref_.restore(s); }
+    bool aw_idle() const {
+        const DeltaPidState s = snapshot();
+        return s.y_sat_1 == s.y_unsat_1 && s.y_sat_2 == s.y_unsat_2;
+    }
+
+    const DeltaCoeffs& coeffs() const { return ref_.coeffs(); }
+    float y_sat_limit() const { return ref_.y_sat_limit(); }
+
+private:
+    DeltaPid2TapAw<Rnd>             ref_;
+    DeltaPidState                   st_;
+    std::shared_ptr<DeltaKernelJit> jit_;   // 같은 계수의 채널/복사본끼리 코드 공유
+    DeltaKernelFn                   fn_ = nullptr;
+    long                            declined_ = 0;
+};
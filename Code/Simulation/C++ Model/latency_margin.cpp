@@ -0,0 +1,65 @@
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <cstdlib>
+#include <string>
+
+#include "closed_loop.hpp"
+#include "loop_metrics.hpp"
+#include "pid_cycle_model.hpp"
+
+// ============================================================
+//  계산 지연이 계단 응답에 주는 영향 (PID_MY_DIGIT 과 같은 계수/식물)
+//  - 지연 0 / 사이클 모델 / Ts 비율 고정 / 지터(정규분포)
+//  - 빌드: g++ -O2 -std=c++20 -fno-fast-math -ffp-contract=off latency_margin.cpp
+//  - 사용: ./a.out [gates]
+// ============================================================
+
+template <class Latency>
+static StepMetrics run_case(long gates, float Ts, Latency lat) {
+    DeltaClosedLoop<> loop(EncoderFloor<>(Ts), DeltaPid2TapAw<>(YSAT),
+                           FirstOrderPlant<>(50.0f, 5.0f, Ts));
+    StepMetricsAcc acc(Ts, YSAT, gates);
+    loop.run_delayed(gates, [](long) { return W_TGT; }, lat,
+                     [&](long, const GateSample& s) { acc.feed(s); });
+    return acc.finish();
+}
+
+static void print_row(const std::string& name, float tau_us, const StepMetrics& r) {
+    std::cout << std::setw(22) << name << " | "
+              << std::setw(9) << std::setprecision(2) << tau_us << " | "
+              << std::setw(8) << std::setprecision(3) << r.x_final << " | "
+              << std::setw(7) << std::setprecision(3) << r.overshoot << " | "
+              << std::setw(8) << std::setprecision(4) << r.iae << " | "
+              << std::setw(9) << std::setprecision(3) << r.settle_s << " | "
+              << std::setw(5) << std::setprecision(3) << r.sat_ratio << "\n";
+}
+
+int main(int argc, char** argv) {
+    const long  GATES = (argc > 1) ? std::atol(argv[1]) : 400;
+    const float Ts    = 0.005f;
+
+    RtlParams rtl;
+    const float tau_rtl = cycle_model_latency(rtl);
+
+    std::cout << std::fixed;
+    std::cout << "# cycle-model latency = " << std::setprecision(2) << tau_rtl * 1e6f << " us ("
+              << (1 + PidFsmCycleModel::cycles_to_out_valid(rtl.ip)
+                    + PwmGeneratorModel::cycles_to_compare(rtl.ip))
+              << " cyc @ " << rtl.clk_hz / 1'000'000 << " MHz)\n";
+    std::cout << "                  case |  tau[us]  |  x_final |  OS[%]  |  IAE     | settle[s] |  sat\n";
+    std::cout << "---------------------------------------------------------------------------------------\n";
+
+    print_row("zero",        0.0f,           run_case(GATES, Ts, ZeroLatency{}));
+    print_row("cycle model", tau_rtl * 1e6f, run_case(GATES, Ts, ConstantLatency{ tau_rtl }));
+    for (float f : { 0.1f, 0.25f, 0.5f, 0.75f, 1.0f }) {
+        const float tau = f * Ts;
+        print_row("const " + std::to_string((int)(f * 100.0f)) + "% Ts", tau * 1e6f,
+                  run_case(GATES, Ts, ConstantLatency{ tau }));
+    }
+    // 소프트웨어 구현처럼 지연이 흔들리는 경우 (평균 0.25 Ts, σ 0.1 Ts)
+    print_row("jitter 25%±10% Ts", 0.25f * Ts * 1e6f,
+              run_case(GATES, Ts, JitterLatency<>(0.25f * Ts,
+                                                  std::normal_distribution<float>(0.0f, 0.1f * Ts))));
+    return 0;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "closed_loop.hpp"
+
+// ============================================================
+//  선형 구간 모델 (비포화, AW 탭 0, 이상 센서)
+//  - 상태 z = [dy1, w1, w2, x1, x2, yu1, xp]  (xp = 식물 속도)
+//  - double 로 계산하는 아핀 게이트:  z[n+1] = A z[n] + B w[n]
+//  - parallel_scan.hpp / impulse_response.hpp 공용
+// ============================================================
+
+using LinearLoop = ClosedLoop<IdealSensor, DeltaPid2TapAw, RoundNative, FirstOrderPlant>;
+
+struct LinearLoopModel {
+    static constexpr int NS = 7;
+
+    DeltaCoeffs k;
+    double Ku, lam, Ts;
+
+    explicit LinearLoopModel(const LinearLoop& l)
+        : k(l.controller().coeffs()),
+          Ku(l.plant().Ku), lam(l.plant().lam), Ts(l.plant().Ts) {}
+
+    // 게이트 1회. 반환값 = y[n] (비포화이므로 yu)
+    double step(double* z, double w) const {
+        const double x  = z[6];
+        const double dy = k.c0 * z[0]
+                        + k.c1 * w + k.c2 * z[1] + k.c3 * z[2]
+                        + k.c4 * x + k.c5 * z[3] + k.c6 * z[4];
+        const double yu = z[5] + dy;
+        z[2] = z[1];  z[1] = w;
+        z[4] = z[3];  z[3] = x;
+        z[0] = dy;    z[5] = yu;
+        z[6] = x + Ts * (Ku * yu - lam * x);
+        return yu;
+    }
+
+    // FP32 루프 → z
+    static void capture(const LinearLoop& l, double* z) {
+        const DeltaPidState s = l.controller().snapshot();
+        z[0] = s.dy1;  z[1] = s.w1;  z[2] = s.w2;
+        z[3] = s.x1;   z[4] = s.x2;  z[5] = s.y_unsat_1;
+        z[6] = l.plant().x;
+    }
+
+    // z → FP32 루프 (AW 이력은 0: y_sat == y_unsat)
+    static void load(LinearLoop& l, const double* z) {
+        DeltaPidState s;
+        s.dy1 = (float)z[0];  s.w1 = (float)z[1];  s.w2 = (float)z[2];
+        s.x1  = (float)z[3];  s.x2 = (float)z[4];
+        s.y_unsat_1 = s.y_sat_1 = (float)z[5];
+        s.y_unsat_2 = s.y_sat_2 = 0.0f;
+        l.controller().restore(s);
+        l.plant().x = (float)z[6];
+    }
+};
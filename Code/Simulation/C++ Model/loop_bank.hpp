@@ -0,0 +1,131 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include <unistd.h>
+
+#include "closed_loop.hpp"
+
+// ============================================================
+//  독립 채널 묶음 + 시간 블로킹 스케줄
+//  - 채널 = ClosedLoop 한 개 (DeltaClosedLoop 이면 약 120 B)
+//  - 단순 순서 (게이트마다 전 채널)는 채널 상태 전체를 매 게이트 캐시로 흘려보냄
+//    → 상태가 L2 를 넘으면 처리량 급락
+//  - 블록 순서: 게이트 타일(tile) 마다, 채널 블록(block) 하나를 타일 전체 게이트
+//    동안 연속 실행 후 다음 블록으로
+//      for tile: for block: for n in tile: for ch in block: step
+//    · 블록 상태 (block·sizeof(Loop)) 는 L1 절반 → 타일 동안 L1 상주
+//    · 게이트 타일은 채널 간 공유 자극 (setpoint 배열 등)이 블록 사이에서
+//      L1 에 남도록 나눈 것. 상태 왕복은 타일당 1회
+//    · 블록 안에서 채널 루프가 안쪽이므로 서로 독립인 채널의 의존 사슬이
+//      겹쳐 실행됨 (게이트당 지연 ≈ 곱셈·덧셈 사슬이 채널 수로 숨겨짐)
+//  - 채널마다 연산 순서는 그대로 → step() 을 게이트 순서로 부른 것과 비트 동일
+//  - 실행 전에 채널마다 prepare(n) (JitDeltaPid2TapAw 면 측정 기준으로 JIT 선택)
+//  - 캐시 크기: sysconf(_SC_LEVEL1_DCACHE_SIZE) → /sys/.../cache/index*/ → 32 KB
+// ============================================================
+
+struct CacheInfo {
+    size_t l1d = 32 * 1024;
+    size_t l2  = 1024 * 1024;
+
+    static CacheInfo detect() {
+        CacheInfo c;
+        const long l1 = sysconf(_SC_LEVEL1_DCACHE_SIZE);
+        const long l2 = sysconf(_SC_LEVEL2_CACHE_SIZE);
+        if (l1 > 0) c.l1d = (size_t)l1; else if (size_t v = sysfs(1, true))  c.l1d = v;
+        if (l2 > 0) c.l2  = (size_t)l2; else if (size_t v = sysfs(2, false)) c.l2  = v;
+        return c;
+    }
+
+private:
+    // /sys/devices/system/cpu/cpu0/cache/index*/{level,type,size}
+    static size_t sysfs(int level, bool data) {
+        for (int i = 0; i < 8; ++i) {
+            char path[96], buf[32];
+            auto rd = [&](const char* f) -> bool {
+                std::snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu0/cache/index%d/%s", i, f);
+                FILE* fp = std::fopen(path, "r");
+                if (!fp) return false;
+                const bool ok = std::fgets(buf, sizeof(buf), fp) != nullptr;
+                std::fclose(fp);
+                return ok;
+            };
+            if (!rd("level") || std::atoi(buf) != level) continue;
+            if (!rd("type") || (data && buf[0] == 'I')) continue;
+            if (!rd("size")) continue;
+            char* end = nullptr;
+            size_t v = std::strtoul(buf, &end, 10);
+            if (end && (*end == 'K' || *end == 'k')) v *= 1024;
+            else if (end && (*end == 'M' || *end == 'm')) v *= 1024 * 1024;
+            return v;
+        }
+        return 0;
+    }
+};
+
+template <class Loop>
+class LoopBank {
+public:
+    struct Schedule {
+        size_t block;   // 채널 블록 크기
+        long   tile;    // 게이트 타일 길이
+    };
+
+    // 블록 상태 = L1 의 1/2, 게이트 타일의 공유 자극(float/게이트) = L1 의 1/4
+    static Schedule tune(size_t channels, long gates, const CacheInfo& c = CacheInfo::detect()) {
+        Schedule s;
+        s.block = std::clamp<size_t>(c.l1d / 2 / sizeof(Loop), 1, std::max<size_t>(1, channels));
+        s.tile  = std::clamp<long>((long)(c.l1d / 4 / sizeof(float)), 64, std::max<long>(64, gates));
+        return s;
+    }
+
+    LoopBank() = default;
+    explicit LoopBank(size_t reserve) { ch_.reserve(reserve); }
+
+    size_t add(const Loop& proto) { ch_.push_back(proto); return ch_.size() - 1; }
+    size_t size() const { return ch_.size(); }
+    Loop&       operator[](size_t i)       { return ch_[i]; }
+    const Loop& operator[](size_t i) const { return ch_[i]; }
+
+    // 게이트 [g0, g0 + n) 를 스케줄 순서로 돌며 gate(ch, n, Loop&) 호출
+    // (스텝 방식을 호출부가 정함 — 자극 표 적용, 고장 게이트 등)
+    // 채널 간 호출 순서는 스케줄에 따라 다르지만 채널 안에서는 항상 게이트 순서
+    template <class Gate>
+    void run_with(long g0, long n, const Schedule& s, Gate&& gate) {
+        const size_t N = ch_.size();
+        if constexpr (requires(Loop& L) { L.prepare(n); })
+            for (Loop& L : ch_) L.prepare(n);
+        for (long t0 = g0; t0 < g0 + n; t0 += s.tile) {
+            const long t1 = std::min(g0 + n, t0 + s.tile);
+            for (size_t b0 = 0; b0 < N; b0 += s.block) {
+                const size_t b1 = std::min(N, b0 + s.block);
+                for (long g = t0; g < t1; ++g)
+                    for (size_t c = b0; c < b1; ++c)
+                        gate(c, g, ch_[c]);
+            }
+        }
+    }
+
+    // 게이트 [g0, g0 + n) 실행. setpoint(ch, n) -> w,  sink(ch, n, const GateSample&)
+    template <class Setpoint, class Sink>
+    void run(long g0, long n, const Schedule& s, Setpoint&& setpoint, Sink&& sink) {
+        run_with(g0, n, s, [&](size_t c, long g, Loop& L) { sink(c, g, L.step(setpoint(c, g))); });
+    }
+
+    template <class Setpoint, class Sink>
+    void run(long n, Setpoint&& setpoint, Sink&& sink) {
+        run(0, n, tune(ch_.size(), n), setpoint, sink);
+    }
+
+    // 비교 기준: 게이트마다 전 채널 (block = 전체, tile = 1)
+    template <class Setpoint, class Sink>
+    void run_gate_major(long g0, long n, Setpoint&& setpoint, Sink&& sink) {
+        run(g0, n, Schedule{ std::max<size_t>(1, ch_.size()), 1 }, setpoint, sink);
+    }
+
+private:
+    std::vector<Loop> ch_;
+};
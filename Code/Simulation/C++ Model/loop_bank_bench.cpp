@@ -0,0 +1,71 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "loop_bank.hpp"
+
+// ============================================================
+//  채널 수에 따른 처리량: 게이트 순서 vs 시간 블로킹 (LoopBank)
+//  - 빌드: g++ -O2 -std=c++20 -fno-fast-math -ffp-contract=off loop_bank_bench.cpp
+//  - 사용: ./a.out [steps_per_point]   (채널×게이트 총량, 기본 4e7)
+//  - 채널마다 Kp 스케일/식물 이득이 다름, setpoint 는 공유 프로파일 × 채널 배율
+//  - 두 순서의 채널별 Σy·마지막 y 가 비트 동일해야 함
+// ============================================================
+
+using Loop = DeltaClosedLoop<RoundNative>;
+
+static void build(LoopBank<Loop>& bank, size_t n, std::vector<float>& scale) {
+    const float Ts = 0.005f;
+    scale.resize(n);
+    for (size_t i = 0; i < n; ++i) {
+        const float Ku  = 30.0f + (float)(i % 53);
+        const float lam = 3.0f + 0.1f * (float)(i % 29);
+        bank.add(Loop(EncoderFloor<RoundNative>(Ts), DeltaPid2TapAw<RoundNative>(YSAT),
+                      FirstOrderPlant<RoundNative>(Ku, lam, Ts)));
+        scale[i] = 0.5f + (float)(i % 97) / 97.0f;
+    }
+}
+
+int main(int argc, char** argv) {
+    const double total = (argc > 1) ? std::atof(argv[1]) : 4e7;
+    const CacheInfo ci = CacheInfo::detect();
+    std::cout << "L1d=" << ci.l1d / 1024 << " KB  L2=" << ci.l2 / 1024 << " KB  sizeof(channel)="
+              << sizeof(Loop) << " B\n";
+    std::cout << "  channels   state[KB]  gates   gate-major[ns]   blocked[ns]  block  tile  match\n";
+
+    for (size_t N : { 64ul, 256ul, 1024ul, 4096ul, 16384ul, 65536ul, 262144ul, 1048576ul }) {
+        const long gates = std::max<long>(200, (long)(total / (double)N));
+        std::vector<float> prof(gates);
+        for (long g = 0; g < gates; ++g) prof[g] = (g < gates / 3) ? W_TGT : (g < 2 * gates / 3 ? 0.4f * W_TGT : 0.8f * W_TGT);
+
+        double ns[2];
+        std::vector<float> sum[2], last[2];
+        typename LoopBank<Loop>::Schedule sch{};
+        for (int mode = 0; mode < 2; ++mode) {
+            LoopBank<Loop> bank(N);
+            std::vector<float> scale;
+            build(bank, N, scale);
+            sum[mode].assign(N, 0.0f);
+            last[mode].assign(N, 0.0f);
+            float* S = sum[mode].data();
+            float* L = last[mode].data();
+            auto sp   = [&](size_t c, long g) { return prof[g] * scale[c]; };
+            auto sink = [&](size_t c, long, const GateSample& s) { S[c] += s.y; L[c] = s.y; };
+
+            const auto t0 = std::chrono::steady_clock::now();
+            if (mode == 0) bank.run_gate_major(0, gates, sp, sink);
+            else { sch = LoopBank<Loop>::tune(N, gates, ci); bank.run(0, gates, sch, sp, sink); }
+            const double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+            ns[mode] = 1e9 * sec / ((double)N * (double)gates);
+        }
+        const bool match = std::memcmp(sum[0].data(), sum[1].data(), 4 * N) == 0
+                        && std::memcmp(last[0].data(), last[1].data(), 4 * N) == 0;
+        std::cout << std::setw(10) << N << std::setw(12) << N * sizeof(Loop) / 1024 << std::setw(7) << gates
+                  << std::fixed << std::setprecision(2) << std::setw(17) << ns[0] << std::setw(14) << ns[1]
+                  << std::setw(7) << sch.block << std::setw(6) << sch.tile << "  " << (match ? "OK" : "DIFF") << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "closed_loop.hpp"
+
+// ============================================================
+//  계단 응답 지표 (스윕/탐색/비교 공용)
+//  - 엔코더 바닥 양자화로 정상상태가 w 와 다를 수 있으므로
+//    오버슈트/정착은 최종값(마지막 10% 평균) 기준, 정상상태 오차는 w 기준
+// ============================================================
+
+struct StepMetrics {
+    float x_final;      // 마지막 10% 평균 속도 [rad/s]
+    float ss_err;       // w - x_final
+    float overshoot;    // (peak - x_final) / |x_final| [%]
+    float settle_s;     // x_final ±2% 밴드에 마지막으로 들어온 시각 [s]
+    float iae;          // Σ|w - x|·Ts
+    float effort;       // Σ|Δy| [V]
+    float sat_ratio;    // |y| >= YSAT 게이트 비율
+
+    static constexpr int N_FIELDS = 7;
+    static constexpr const char* NAMES[N_FIELDS] = {
+        "x_final", "ss_err", "overshoot", "settle_s", "iae", "effort", "sat_ratio" };
+    const float* data() const { return &x_final; }
+    float*       data()       { return &x_final; }
+};
+
+class StepMetricsAcc {
+public:
+    StepMetricsAcc(float Ts, float ysat, long reserve = 0) : Ts_(Ts), ysat_(ysat) { x_.reserve(reserve); }
+
+    void feed(const GateSample& s) {
+        x_.push_back(s.x_true);
+        w_last_ = s.w;
+        iae_    += std::fabs(s.w - s.x_true) * Ts_;
+        effort_ += std::fabs(s.y - y_prev_);
+        y_prev_  = s.y;
+        if (std::fabs(s.y) >= ysat_) ++sat_;
+    }
+
+    StepMetrics finish() const {
+        StepMetrics m{};
+        const long n = (long)x_.size();
+        if (n == 0) return m;
+        const long tail = std::max<long>(1, n / 10);
+        double acc = 0.0;
+        for (long i = n - tail; i < n; ++i) acc += x_[i];
+        m.x_final = (float)(acc / (double)tail);
+        m.ss_err  = w_last_ - m.x_final;
+
+        const float peak = *std::max_element(x_.begin(), x_.end());
+        const float ref  = std::max(std::fabs(m.x_final), 1e-6f);
+        m.overshoot = std::max(0.0f, 100.0f * (peak - m.x_final) / ref);
+
+        const float band = 0.02f * ref;
+        long settle = 0;
+        for (long i = 0; i < n; ++i)
+            if (std::fabs(x_[i] - m.x_final) > band) settle = i + 1;
+        m.settle_s  = (float)settle * Ts_;
+        m.iae       = iae_;
+        m.effort    = effort_;
+        m.sat_ratio = (float)sat_ / (float)n;
+        return m;
+    }
+
+private:
+    float Ts_, ysat_;
+    std::vector<float> x_;
+    float w_last_ = 0.0f, iae_ = 0.0f, effort_ = 0.0f, y_prev_ = 0.0f;
+    long  sat_ = 0;
+};
@@ -0,0 +1,167 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+extern "C" {
+#include "../../SW Driver/mc_stats.h"
+}
+
+// ============================================================
+//  게이트 통계 (SW Driver/mc_stats.c) 호스트 검증
+//  - 빌드: gcc -O2 -std=gnu99 -c "../../SW Driver/mc_stats.c" -o mc_stats.o
+//          g++ -O2 -std=c++20 mc_stats_check.cpp mc_stats.o
+//  - 사용: ./a.out [gates=200000]
+//  알려진 열 (과도 지수 수렴 → 정상상태 잡음, 분포별) 을 넣고 전수 계산과 비교
+//  1) 평균/표준편차/최소/최대, 포화 비율 : double 전수 계산과 (거의) 같음
+//  2) 정착 게이트, excursion 수 : 같은 규칙의 전수 판정과 정확히 같음
+//  3) |e| p50/p90/p99 (로그 버킷) : 첫 정착 이후 표본을 정렬한 정확한 분위수
+//     (순위 floor(p·(n-1))) 대비 |오차| ≤ α·정확값 + QMIN
+//     과도 꼬리로 시작하는 열, 엔코더 카운트 양자화 열 포함 (P² 가 크게 틀리던 경우)
+//  4) mc_stats_skip : 미관측 게이트를 섞어도 게이트 축 (정착 시점, gates) 은 유지,
+//     평균/분위수는 관측 게이트만
+// ============================================================
+
+static const float  W    = 100.0f;
+static const float  YSAT = 12.0f;
+static const float  BAND = 0.02f;
+static const int    HOLD = 20;
+
+struct Sample { float x, y; bool seen; };
+
+// 과도 (w 의 30 % 에서 지수 수렴) + 정상상태 잡음. 일부 구간은 밴드 이탈 (excursion)
+template <class Noise>
+static std::vector<Sample> make_seq(long gates, Noise&& noise, std::mt19937& rng, double p_skip) {
+    std::bernoulli_distribution skip(p_skip);
+    std::vector<Sample> v(gates);
+    for (long n = 0; n < gates; ++n) {
+        float x = W * (1.0f - 0.7f * std::exp(-(float)n / 150.0f)) + noise(rng);
+        if (n % 40000 >= 30000 && n % 40000 < 30050) x -= 6.0f;                // 부하 충격
+        const float y = (n < 300) ? YSAT : 4.0f + 0.01f * (W - x);
+        v[n] = { x, (n % 7 == 3) ? NAN : y, !skip(rng) };
+    }
+    return v;
+}
+
+struct Ref {
+    double mean = 0, std = 0, e_min = 1e30, e_max = -1e30, sat = -1;
+    long   settle = -1, excursions = 0, gates = 0, skipped = 0;
+    std::vector<double> steady;
+
+    double q(double p) const {
+        if (steady.empty()) return 0.0;
+        return steady[(size_t)(p * (double)(steady.size() - 1))];
+    }
+};
+
+// 같은 규칙의 전수 판정 (mc_stats.h 설명 그대로)
+static Ref reference(const std::vector<Sample>& v) {
+    Ref r;
+    std::vector<double> e;
+    long run = 0, known = 0, sat = 0;
+    bool steady = false;
+    for (const Sample& s : v) {
+        ++r.gates;
+        if (!s.seen) { ++r.skipped; run = 0; continue; }
+        const float ef = W - s.x, ae = std::fabs(ef);
+        e.push_back(ef);
+        r.e_min = std::min(r.e_min, (double)ef);
+        r.e_max = std::max(r.e_max, (double)ef);
+        if (!std::isnan(s.y)) { ++known; sat += std::fabs(s.y) >= YSAT; }
+        if (ae <= BAND * std::fabs(W)) {
+            if (++run == HOLD && r.settle < 0) r.settle = r.gates - HOLD;
+            if (r.settle >= 0) steady = true;
+        } else {
+            if (r.settle >= 0) { ++r.excursions; r.settle = -1; }
+            run = 0;
+        }
+        if (steady) r.steady.push_back(ae);
+    }
+    for (double x : e) r.mean += x;
+    r.mean /= (double)e.size();
+    for (double x : e) r.std += (x - r.mean) * (x - r.mean);
+    r.std = std::sqrt(r.std / (double)(e.size() - 1));
+    r.sat = known ? (double)sat / (double)known : -1.0;
+    std::sort(r.steady.begin(), r.steady.end());
+    return r;
+}
+
+static bool run_case(const char* name, const std::vector<Sample>& v) {
+    mc_stats_t st;
+    mc_stats_init(&st, W, YSAT, BAND, HOLD);
+    for (const Sample& s : v) {
+        if (s.seen) mc_stats_feed(&st, s.x, s.y);
+        else        mc_stats_skip(&st, 1);
+    }
+    mc_stats_summary_t m;
+    mc_stats_summary(&st, &m);
+    const Ref r = reference(v);
+
+    auto rel = [](double a, double b) { return std::fabs(a - b) / std::max(std::fabs(b), 1e-9); };
+    int bad = 0;
+    bad += (long)m.gates != r.gates || (long)m.skipped != r.skipped;
+    bad += rel(m.e_mean, r.mean) > 1e-5 || rel(m.e_std, r.std) > 1e-5;
+    bad += (float)r.e_min != m.e_min || (float)r.e_max != m.e_max;
+    bad += std::fabs(m.sat_ratio - r.sat) > 1e-6;
+    bad += m.settle_gate != r.settle || (long)m.excursions != r.excursions;
+
+    std::cout << std::left << std::setw(18) << name << std::right << std::setw(8) << r.gates
+              << std::setw(7) << r.skipped << std::setw(8) << m.settle_gate << "/" << std::setw(6) << std::left
+              << r.settle << std::right << std::setw(4) << m.excursions;
+    for (int i = 0; i < MC_STATS_NQ; ++i) {
+        const double p = (i == 0) ? 0.50 : (i == 1) ? 0.90 : 0.99;
+        const double exact = r.q(p), err = rel(m.e_abs_q[i], exact);
+        bad += std::fabs(m.e_abs_q[i] - exact) > MC_STATS_QALPHA * exact * (1.0 + 1e-6) + MC_STATS_QMIN;
+        std::cout << std::setw(10) << std::setprecision(4) << std::fixed << exact << " "
+                  << std::setw(6) << std::setprecision(2) << 100.0 * err << "%";
+    }
+    std::cout << (bad ? "  FAIL" : "  OK") << "\n";
+    return bad == 0;
+}
+
+int main(int argc, char** argv) {
+    const long gates = (argc > 1) ? std::atol(argv[1]) : 200000;
+    std::mt19937 rng(11);
+    bool ok = true;
+
+    std::cout << "case                 gates   skip  settle/ref    exc        p50   err       p90   err"
+                 "       p99   err\n";
+    std::normal_distribution<float>      nrm(0.0f, 0.5f);
+    std::uniform_real_distribution<float> uni(-1.2f, 1.2f);
+    std::exponential_distribution<float> ex(3.0f);
+    std::bernoulli_distribution          coin(0.5);
+    auto normal   = [&](std::mt19937& g) { return nrm(g); };
+    auto uniform  = [&](std::mt19937& g) { return uni(g); };
+    auto expo     = [&](std::mt19937& g) { return coin(g) ? ex(g) : -ex(g); };     // 라플라스
+    auto bimodal  = [&](std::mt19937& g) { return (coin(g) ? 0.9f : -0.4f) + 0.1f * nrm(g); };
+    auto quant    = [&](std::mt19937& g) { return 0.94059658f * (float)(int)std::lround(1.2f * nrm(g)); };  // 엔코더 1카운트 단위
+
+    ok &= run_case("normal",          make_seq(gates, normal,  rng, 0.0));
+    ok &= run_case("uniform",         make_seq(gates, uniform, rng, 0.0));
+    ok &= run_case("laplace",         make_seq(gates, expo,    rng, 0.0));
+    ok &= run_case("bimodal",         make_seq(gates, bimodal, rng, 0.0));
+    ok &= run_case("count-quantized", make_seq(gates, quant,   rng, 0.0));
+    ok &= run_case("normal, 1% skip", make_seq(gates, normal,  rng, 0.01));
+    ok &= run_case("laplace, 5% skip", make_seq(gates, expo,   rng, 0.05));
+
+    // set_target: total 외 초기화
+    {
+        mc_stats_t st;
+        mc_stats_init(&st, W, YSAT, BAND, HOLD);
+        for (int i = 0; i < 500; ++i) mc_stats_feed(&st, W, 1.0f);
+        mc_stats_skip(&st, 3);
+        mc_stats_set_target(&st, 50.0f);
+        mc_stats_feed(&st, 49.0f, NAN);
+        mc_stats_summary_t m;
+        mc_stats_summary(&st, &m);
+        const bool r = m.total == 504 && m.gates == 1 && m.skipped == 0 && m.e_mean == 1.0f
+                    && m.settle_gate == -1 && m.sat_ratio == -1.0f;
+        std::cout << "set_target resets all but total" << (r ? "  OK" : "  FAIL") << "\n";
+        ok &= r;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,195 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+#include "hot_probe.hpp"
+#include "pid_model.hpp"
+
+// ============================================================
+//  기계적으로 결합된 다축 폐루프 (갠트리/듀얼 드라이브)
+//  - 축 i : dω_i/dt = Ku_i·y_i - lam_i·ω_i - Σ_j [k_ij(θ_i-θ_j) + d_ij(ω_i-ω_j)]
+//           dθ_i/dt = ω_i                                  (FirstOrderPlant 와 같은 전진 오일러)
+//  - 결합이 없으면 축 i 는 DeltaClosedLoop 과 비트 동일
+//  - 게이트 한 번
+//      A) 축별 엔코더 샘플 + DeltaPid2TapAw (스레드마다 연속 축 구간)
+//      ── spin barrier ──
+//      B) 결합 식물 갱신: 이전 버퍼의 모든 축 상태 → 다음 버퍼의 자기 축
+//    B 는 자기 축만 쓰고, 다음 A 는 자기 축만 읽으므로 게이트당 배리어 1회
+//  - 축 하나의 연산은 분할과 무관하게 같은 순서(링크 순서 고정)
+//    → 스레드 수와 관계없이 결과 비트 동일
+// ============================================================
+
+struct AxisParams {
+    float Ku;
+    float lam;
+};
+
+// 축 i–j 사이 스프링/댐퍼 (양쪽 축에 대칭으로 작용)
+struct AxisLink {
+    int   i, j;
+    float k;    // [rad/s² per rad]
+    float d;    // [rad/s² per rad/s]
+};
+
+// 세대 번호 스핀 배리어
+class SpinBarrier {
+public:
+    static constexpr unsigned SPIN_LIMIT = 2048;
+
+    explicit SpinBarrier(unsigned n) : n_(n) {}
+
+    void wait() {
+        const unsigned g = gen_.load(std::memory_order_acquire);
+        if (count_.fetch_add(1, std::memory_order_acq_rel) + 1 == n_) {
+            count_.store(0, std::memory_order_relaxed);
+            gen_.store(g + 1, std::memory_order_release);
+            return;
+        }
+        // 잠깐 스핀 후 양보 (코어보다 스레드가 많을 때 타임슬라이스 낭비 방지)
+        for (unsigned spin = 0; gen_.load(std::memory_order_acquire) == g; ++spin) {
+#if defined(__x86_64__) || defined(__i386__)
+            if (spin < SPIN_LIMIT) { _mm_pause(); continue; }
+#endif
+            std::this_thread::yield();
+        }
+    }
+
+private:
+    alignas(64) std::atomic<unsigned> count_{ 0 };
+    alignas(64) std::atomic<unsigned> gen_{ 0 };
+    unsigned n_;
+};
+
+template <class Rnd = RoundVolatile>
+class CoupledPlant {
+public:
+    CoupledPlant(std::vector<AxisParams> axes, const std::vector<AxisLink>& links, float Ts)
+        : Ts(Ts), ax_(std::move(axes)), adj_(ax_.size())
+    {
+        for (int b = 0; b < 2; ++b) { w_[b].assign(ax_.size(), 0.0f); th_[b].assign(ax_.size(), 0.0f); }
+        for (const AxisLink& l : links) {
+            adj_[l.i].push_back({ l.j, l.k, l.d });
+            adj_[l.j].push_back({ l.i, l.k, l.d });
+        }
+    }
+
+    size_t axes() const { return ax_.size(); }
+
+    float speed(size_t i, int buf) const { return w_[buf][i]; }
+    float angle(size_t i, int buf) const { return th_[buf][i]; }
+
+    // 축 [b, e) : 버퍼 src → src^1
+    void update_range(const float* y, size_t b, size_t e, int src) {
+        const float* w  = w_[src].data();
+        const float* th = th_[src].data();
+        float* wn  = w_[src ^ 1].data();
+        float* thn = th_[src ^ 1].data();
+        for (size_t i = b; i < e; ++i) {
+            // 결합 항 합 (+0 에서 시작 → 링크가 없으면 -(+0) 을 더해도 비트 불변)
+            float cpl = 0.0f;
+            for (const Link& l : adj_[i]) {
+                cpl = Rnd::add(cpl, Rnd::mul(l.k, Rnd::add(th[i], -th[l.j])));
+                cpl = Rnd::add(cpl, Rnd::mul(l.d, Rnd::add(w[i], -w[l.j])));
+            }
+            const float acc = Rnd::add(Rnd::add(Rnd::mul(ax_[i].Ku, y[i]), -Rnd::mul(ax_[i].lam, w[i])), -cpl);
+            wn[i]  = Rnd::add(w[i], Rnd::mul(Ts, acc));
+            thn[i] = Rnd::add(th[i], Rnd::mul(Ts, w[i]));
+        }
+    }
+
+    float Ts;
+
+private:
+    struct Link { int j; float k, d; };
+
+    std::vector<AxisParams>        ax_;
+    std::vector<std::vector<Link>> adj_;
+    std::vector<float>             w_[2], th_[2];
+};
+
+// 게이트 × 축 기록 (인덱스 n*axes + i)
+struct MultiAxisTrace {
+    size_t             axes = 0;
+    std::vector<float> w, x_true, x_meas, y;
+    std::vector<int>   spdcnt;
+
+    void resize(long gates, size_t n_axes) {
+        axes = n_axes;
+        const size_t n = (size_t)gates * n_axes;
+        w.resize(n); x_true.resize(n); x_meas.resize(n); y.resize(n); spdcnt.resize(n);
+    }
+};
+
+template <class Rnd = RoundVolatile>
+class MultiAxisLoop {
+public:
+    using Controller = DeltaPid2TapAw<Rnd>;
+
+    MultiAxisLoop(std::vector<Controller> ctrl, CoupledPlant<Rnd> plant, unsigned threads = 0)
+        : ctrl_(std::move(ctrl)), plant_(std::move(plant)), y_(plant_.axes(), 0.0f)
+    {
+        for (size_t i = 0; i < plant_.axes(); ++i) enc_.emplace_back(plant_.Ts);
+        threads_ = threads ? threads : std::max(1u, std::thread::hardware_concurrency());
+        threads_ = (unsigned)std::min<size_t>(threads_, std::max<size_t>(1, plant_.axes()));
+    }
+
+    size_t axes() const { return plant_.axes(); }
+    unsigned threads() const { return threads_; }
+
+    // setpoint(n, axis) -> w  (여러 스레드에서 동시에 호출됨)
+    template <class Setpoint>
+    void run(long n_gates, Setpoint&& setpoint, MultiAxisTrace& out) {
+        const size_t N = axes();
+        out.resize(n_gates, N);
+        SpinBarrier bar(threads_);
+
+        auto worker = [&](unsigned t) {
+            const size_t b = N * t / threads_, e = N * (t + 1) / threads_;
+            int src = buf_;
+            for (long n = 0; n < n_gates; ++n) {
+                {
+                    PID_PROBE("axis.sample_ctrl");
+                    for (size_t i = b; i < e; ++i) {
+                        const size_t o = (size_t)n * N + i;
+                        const float  w = setpoint(n, i);
+                        const float  x = plant_.speed(i, src);
+                        int   spd;
+                        float xm;
+                        enc_[i].sample(x, spd, xm);
+                        y_[i] = ctrl_[i].step(w, xm);
+                        out.w[o] = w;  out.x_true[o] = x;  out.x_meas[o] = xm;
+                        out.spdcnt[o] = spd;  out.y[o] = y_[i];
+                    }
+                }
+                { PID_PROBE("axis.barrier"); bar.wait(); }
+                { PID_PROBE("axis.plant");   plant_.update_range(y_.data(), b, e, src); }
+                src ^= 1;
+            }
+        };
+
+        std::vector<std::thread> pool;
+        for (unsigned t = 1; t < threads_; ++t) pool.emplace_back(worker, t);
+        worker(0);
+        for (auto& th : pool) th.join();
+        buf_ ^= (int)(n_gates & 1);
+    }
+
+    float speed(size_t i) const { return plant_.speed(i, buf_); }
+    float angle(size_t i) const { return plant_.angle(i, buf_); }
+    Controller& controller(size_t i) { return ctrl_[i]; }
+
+private:
+    std::vector<Controller>        ctrl_;
+    std::vector<EncoderFloor<Rnd>> enc_;
+    CoupledPlant<Rnd>              plant_;
+    std::vector<float>             y_;
+    unsigned                       threads_ = 1;
+    int                            buf_ = 0;
+};
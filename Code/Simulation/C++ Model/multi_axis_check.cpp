@@ -0,0 +1,100 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+
+#include "closed_loop.hpp"
+#include "multi_axis.hpp"
+
+// ============================================================
+//  결합 다축 루프 확인
+//   1) 결합 없는 1축 == DeltaClosedLoop (비트)
+//   2) 2축 갠트리(모터 불균형 + 강성 결합) : 축 간 속도차/출력 추적
+//   3) N축 링 결합 : 스레드 수 1..T 결과 비트 동일 + 처리량
+//  - 빌드: g++ -O2 -std=c++20 -fno-fast-math -ffp-contract=off -pthread multi_axis_check.cpp
+//  - 사용: ./a.out [gates] [ring_axes]
+// ============================================================
+
+static const float Ts = 0.005f;
+
+using Loop = MultiAxisLoop<RoundNative>;
+
+static Loop make_ring(size_t N, unsigned threads) {
+    std::vector<AxisParams> ax;
+    std::vector<AxisLink>   links;
+    for (size_t i = 0; i < N; ++i) {
+        ax.push_back({ 50.0f * (1.0f + 0.01f * (float)(i % 7)), 5.0f });
+        links.push_back({ (int)i, (int)((i + 1) % N), 40.0f, 2.0f });
+    }
+    return Loop(std::vector<Loop::Controller>(N, Loop::Controller(YSAT)),
+                CoupledPlant<RoundNative>(ax, links, Ts), threads);
+}
+
+int main(int argc, char** argv) {
+    const long   GATES = (argc > 1) ? std::atol(argv[1]) : 20000;
+    const size_t RING  = (argc > 2) ? (size_t)std::atol(argv[2]) : 64;
+    bool ok = true;
+
+    // ---- 1) 단일 축, 결합 없음 ----
+    {
+        Loop m(std::vector<Loop::Controller>(1, Loop::Controller(YSAT)),
+               CoupledPlant<RoundNative>({ { 50.0f, 5.0f } }, {}, Ts), 1);
+        MultiAxisTrace tr;
+        m.run(GATES, [](long, size_t) { return W_TGT; }, tr);
+
+        ClosedLoop<EncoderFloor, DeltaPid2TapAw, RoundNative, FirstOrderPlant> ref(
+            EncoderFloor<RoundNative>(Ts), DeltaPid2TapAw<RoundNative>(YSAT),
+            FirstOrderPlant<RoundNative>(50.0f, 5.0f, Ts));
+        long bad = 0;
+        ref.run(GATES, W_TGT, [&](long n, const GateSample& s) {
+            if (std::memcmp(&s.y, &tr.y[n], 4) != 0 || std::memcmp(&s.x_true, &tr.x_true[n], 4) != 0) ++bad;
+        });
+        std::cout << "single axis vs ClosedLoop : mismatches=" << bad << "\n";
+        ok &= (bad == 0);
+    }
+
+    // ---- 2) 2축 갠트리 ----
+    {
+        Loop g(std::vector<Loop::Controller>(2, Loop::Controller(YSAT)),
+               CoupledPlant<RoundNative>({ { 50.0f, 5.0f }, { 40.0f, 6.0f } },
+                                         { { 0, 1, 400.0f, 10.0f } }, Ts), 2);
+        MultiAxisTrace tr;
+        g.run(GATES, [](long, size_t) { return W_TGT; }, tr);
+        float max_dw = 0.0f;
+        for (long n = 0; n < GATES; ++n)
+            max_dw = std::max(max_dw, std::fabs(tr.x_true[2 * n] - tr.x_true[2 * n + 1]));
+        std::cout << std::fixed << std::setprecision(6)
+                  << "gantry: w0=" << g.speed(0) << " w1=" << g.speed(1)
+                  << "  dtheta=" << g.angle(0) - g.angle(1)
+                  << "  max|w0-w1|=" << max_dw
+                  << "  y_last=(" << tr.y[2 * (GATES - 1)] << ", " << tr.y[2 * (GATES - 1) + 1] << ")\n";
+    }
+
+    // ---- 3) 링 결합, 스레드 수 무관 ----
+    {
+        // 코어 수보다 많은 스레드도 결정성 확인용으로 돌린다
+        const unsigned hw = std::max(4u, std::thread::hardware_concurrency());
+        MultiAxisTrace base;
+        for (unsigned t = 1; t <= hw && t <= RING; t *= 2) {
+            Loop m = make_ring(RING, t);
+            MultiAxisTrace tr;
+            const auto t0 = std::chrono::steady_clock::now();
+            m.run(GATES, [](long n, size_t i) { return (n < 200) ? 0.0f : W_TGT * (1.0f + 0.05f * (float)(i % 3)); }, tr);
+            const auto t1 = std::chrono::steady_clock::now();
+            const double ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+
+            bool same = true;
+            if (t == 1) base = tr;
+            else same = std::memcmp(base.y.data(), tr.y.data(), base.y.size() * 4) == 0
+                     && std::memcmp(base.x_true.data(), tr.x_true.data(), base.x_true.size() * 4) == 0;
+            ok &= same;
+            std::cout << "ring N=" << RING << " threads=" << std::setw(2) << t
+                      << " : " << std::setprecision(1) << std::setw(8) << ns / (double)GATES << " ns/gate"
+                      << "  " << (same ? "identical" : "DIFFERENT") << "\n";
+        }
+    }
+
+    std::cout << (ok ? "==> PASS\n" : "==> FAIL\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,194 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#include "linear_model.hpp"
+
+// ============================================================
+//  Parallel-in-time 시뮬레이션 (선형 구간 전용)
+//
+//  비포화 + AW 탭 0 + 이상 센서(x_meas = x_true) 이면 한 게이트는
+//  상태 z = [dy1, w1, w2, x1, x2, yu1, xp] 에 대한 아핀 사상
+//      z[n+1] = A z[n] + B w[n]
+//  이다. 구간을 청크로 나누고 청크 사상 (A^L, v_c) 를 결합 연산
+//      (M1,v1) ∘ (M2,v2) = (M2 M1, M2 v1 + v2)
+//  로 스캔하여 각 청크의 시작 상태를 구한다.
+//
+//  1) 청크별 v_c : 0 상태에서 double 선형 스텝 (병렬)
+//  2) 청크 경계 스캔 : s[c+1] = A^L s[c] + v_c (청크 수만큼, 직렬)
+//  3) 청크별 재실행 : s[c]에서 실제 FP32 DeltaPid2TapAw/식물로 스텝 (병렬)
+//     - 포화 발생 또는 청크 끝 상태가 s[c+1]과 어긋나면(이중 확인)
+//       그 청크까지만 채택하고 이후는 직렬 스텝으로 진행
+//  결과는 선형 구간에서 직렬 FP32 재귀와 라운딩 수준 차이만 난다.
+// ============================================================
+
+struct ScanStats {
+    long gates_scan   = 0;   // 병렬 구간에서 채택된 게이트 수
+    long gates_serial = 0;   // 직렬 스텝 게이트 수
+    long windows      = 0;   // 병렬 윈도우 시도 횟수
+    long sat_breaks   = 0;   // 포화로 끊긴 횟수
+    long check_fails  = 0;   // 이중 확인 실패 횟수
+};
+
+class ParallelInTimeSim {
+public:
+    using Loop = LinearLoop;
+
+    static constexpr int NS = LinearLoopModel::NS;
+
+    // threads = 0 → hardware_concurrency
+    explicit ParallelInTimeSim(const Loop& proto, unsigned threads = 0, long chunk = 16384)
+        : proto_(proto), lin_(proto), chunk_(chunk)
+    {
+        threads_ = threads ? threads : std::max(1u, std::thread::hardware_concurrency());
+        build_chunk_matrix();
+    }
+
+    // 비포화 후 최소 몇 게이트 연속이면 병렬 모드 재진입
+    void set_min_linear_run(int g) { min_linear_run_ = g; }
+    // 청크 경계 이중 확인 허용 오차 (상대)
+    void set_check_tol(double tol) { check_tol_ = tol; }
+
+    // loop 상태에서 시작하여 w[0..n) 을 진행. y/x_true 는 n개 출력.
+    // 종료 시 loop 는 마지막 게이트 이후 상태.
+    ScanStats run(Loop& loop, const float* w, long n, float* y, float* x_true) {
+        ScanStats st;
+        long pos = 0;
+        int linear_run = 0;
+
+        while (pos < n) {
+            const long remain = n - pos;
+            const bool can_scan = loop.controller().aw_idle()
+                               && linear_run >= min_linear_run_
+                               && remain >= 2 * chunk_;
+
+            if (!can_scan) {
+                // 직렬 스텝 (포화 주변 / 짧은 꼬리)
+                const GateSample s = loop.step(w[pos]);
+                y[pos] = s.y;  x_true[pos] = s.x_true;
+                linear_run = (std::fabs(s.y) < ysat()) ? linear_run + 1 : 0;
+                ++pos;  ++st.gates_serial;
+                continue;
+            }
+
+            ++st.windows;
+            const long sat_before = st.sat_breaks;
+            const long took = scan_window(loop, w + pos, remain, y + pos, x_true + pos, st);
+            pos += took;
+            st.gates_scan += took;
+            // 포화로 끊긴 경우 다시 min_linear_run 만큼 직렬로 확인
+            if (st.sat_breaks != sat_before || !loop.controller().aw_idle()) linear_run = 0;
+        }
+        return st;
+    }
+
+private:
+    struct Chunk {
+        long   begin, len;
+        double v[NS];       // 0 상태에서의 청크 끝 상태
+        double s0[NS];      // 스캔으로 얻은 시작 상태
+        Loop   loop;        // 3단계 실행 결과 상태
+        long   sat_at;      // 청크 내 첫 포화 위치 (-1: 없음)
+        bool   check_ok;
+        explicit Chunk(const Loop& l) : begin(0), len(0), v{}, s0{}, loop(l), sat_at(-1), check_ok(true) {}
+    };
+
+    float ysat() const { return proto_.controller().y_sat_limit(); }
+
+    // M = A^chunk_ (w = 0 에서 단위벡터 전개)
+    void build_chunk_matrix() {
+        for (int j = 0; j < NS; ++j) {
+            double z[NS] = {};
+            z[j] = 1.0;
+            for (long i = 0; i < chunk_; ++i) lin_.step(z, 0.0);
+            for (int r = 0; r < NS; ++r) M_[r][j] = z[r];
+        }
+    }
+
+    template <class F>
+    void parallel_for(size_t n, F&& f) {
+        std::vector<std::thread> pool;
+        const size_t nt = std::min<size_t>(threads_, n);
+        for (size_t t = 1; t < nt; ++t)
+            pool.emplace_back([&, t] { for (size_t i = t; i < n; i += nt) f(i); });
+        for (size_t i = 0; i < n; i += nt) f(i);
+        for (auto& th : pool) th.join();
+    }
+
+    long scan_window(Loop& loop, const float* w, long remain, float* y, float* x_true, ScanStats& st) {
+        // 윈도우 = 스레드당 최대 4청크
+        const long n_chunks = std::min<long>(remain / chunk_, (long)threads_ * 4);
+        std::vector<Chunk> ch(n_chunks, Chunk(loop));
+        for (long c = 0; c < n_chunks; ++c) { ch[c].begin = c * chunk_; ch[c].len = chunk_; }
+
+        // 1) 청크별 입력 응답
+        parallel_for(ch.size(), [&](size_t c) {
+            PID_PROBE("scan.particular");
+            double z[NS] = {};
+            for (long i = 0; i < ch[c].len; ++i) lin_.step(z, (double)w[ch[c].begin + i]);
+            std::copy(z, z + NS, ch[c].v);
+        });
+
+        // 2) 청크 경계 스캔
+        {
+        PID_PROBE("scan.boundary");
+        LinearLoopModel::capture(loop, ch[0].s0);
+        for (long c = 0; c + 1 < n_chunks; ++c) {
+            for (int r = 0; r < NS; ++r) {
+                double acc = ch[c].v[r];
+                for (int j = 0; j < NS; ++j) acc += M_[r][j] * ch[c].s0[j];
+                ch[c + 1].s0[r] = acc;
+            }
+        }
+        }
+
+        // 3) 실제 FP32 모델로 청크 재실행 + 포화 검출
+        const float lim = ysat();
+        parallel_for(ch.size(), [&](size_t c) {
+            PID_PROBE("scan.replay");
+            Chunk& k = ch[c];
+            if (c == 0) k.loop = loop;            // 첫 청크는 정확한 직렬 상태에서
+            else        LinearLoopModel::load(k.loop, k.s0);
+            for (long i = 0; i < k.len; ++i) {
+                const long g = k.begin + i;
+                const GateSample s = k.loop.step(w[g]);
+                y[g] = s.y;  x_true[g] = s.x_true;
+                if (k.sat_at < 0 && std::fabs(s.y) >= lim) k.sat_at = i;
+            }
+        });
+
+        // 이중 확인: 청크 c 끝 상태 ≈ 스캔 s[c+1]
+        for (long c = 0; c + 1 < n_chunks; ++c) {
+            PID_PROBE("scan.check");
+            double z[NS];
+            LinearLoopModel::capture(ch[c].loop, z);
+            for (int r = 0; r < NS; ++r) {
+                const double ref = ch[c + 1].s0[r];
+                if (std::fabs(z[r] - ref) > check_tol_ * std::max(1.0, std::fabs(ref))) {
+                    ch[c].check_ok = false;
+                    break;
+                }
+            }
+        }
+
+        // 첫 포화/불일치 청크까지 채택 (그 청크 자체는 올바른 시작 상태에서 실행됨)
+        long last = n_chunks - 1;
+        for (long c = 0; c < n_chunks; ++c) {
+            if (ch[c].sat_at >= 0) { ++st.sat_breaks;  last = c; break; }
+            if (!ch[c].check_ok)   { ++st.check_fails; last = c; break; }
+        }
+        loop = ch[last].loop;
+        return ch[last].begin + ch[last].len;
+    }
+
+    Loop            proto_;
+    LinearLoopModel lin_;
+    unsigned        threads_;
+    long            chunk_;
+    int             min_linear_run_ = 64;
+    double          check_tol_      = 1e-4;
+    double          M_[NS][NS];
+};
@@ -0,0 +1,215 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "pareto_front.hpp"
+#include "sweep.hpp"
+#include "sweep_log.hpp"
+
+// ============================================================
+//  스윕 로그 → 파레토 프런트 (스트리밍, 점을 저장하지 않음)
+//  - 목적(모두 최소화): StepMetrics 필드 이름 (ss_err 는 |ss_err|)
+//                      + noise : 제어기 잡음 이득 noise_gain(compute_coeffs(g, Ts))
+//  - 빌드: g++ -O2 -std=c++20 -fno-fast-math -ffp-contract=off pareto_front.cpp -o pareto_front
+//  - 사용: ./pareto_front <in.log>... [--obj overshoot,settle_s,effort,noise]
+//                         [--eps 0.5,0.01,0.1,0.01] [--csv front.csv]
+//          ./pareto_front --check <n> [--obj ...] [--eps ...]
+//            : 상관된 난수 목적 벡터 n 개로 처리량 측정 + 전수 비교(n ≤ 20000)
+//  - 목적 개수 2..5
+// ============================================================
+
+static const int NOISE = -1;
+
+static std::vector<std::string> split(const std::string& s) {
+    std::vector<std::string> out;
+    std::stringstream ss(s);
+    for (std::string t; std::getline(ss, t, ',');) out.push_back(t);
+    return out;
+}
+
+template <int K>
+struct FrontJob {
+    const std::vector<std::string>& in;
+    const std::vector<int>&         obj;
+    const std::vector<std::string>& obj_names;
+    const std::vector<float>&       eps;
+    const std::string&              csv;
+    long                            check_n;
+
+    using Front = ParetoFront<K, SweepRecord>;
+    using Vec   = typename Front::Vec;
+
+    Vec eps_vec() const {
+        Vec e{};
+        for (int d = 0; d < K && d < (int)eps.size(); ++d) e[d] = eps[d];
+        return e;
+    }
+
+    Vec objectives(const SweepRecord& r, double Ts) const {
+        Vec f;
+        for (int d = 0; d < K; ++d) {
+            if (obj[d] == NOISE) {
+                f[d] = (float)noise_gain(compute_coeffs(SweepSpace::point_of(r.params.data()).g, Ts));
+            } else {
+                f[d] = r.metrics[obj[d]];
+                if (obj[d] == 1) f[d] = std::fabs(f[d]);       // ss_err
+            }
+        }
+        return f;
+    }
+
+    int run() const { return check_n > 0 ? check() : from_logs(); }
+
+    int from_logs() const {
+        Front pf(eps_vec());
+        const double Ts = SweepEval().Ts;
+        SweepLogHeader hdr{};
+        bool have_hdr = false;
+        const auto t0 = std::chrono::steady_clock::now();
+        for (const std::string& f : in) {
+            SweepLogHeader h{};
+            const size_t valid = SweepLog::scan(f, h, [&](const SweepRecord& r) {
+                if (r.type != SweepRecord::POINT) return;
+                if ((int)r.params.size() != SweepSpace::NP || (int)r.metrics.size() != StepMetrics::N_FIELDS) return;
+                pf.insert(objectives(r, Ts), r);
+            });
+            if (valid == 0) { std::cerr << f << ": 헤더 불량 — 건너뜀\n"; continue; }
+            if (!have_hdr) { hdr = h; have_hdr = true; }
+            else if (!hdr.compatible(h)) std::cerr << f << ": 다른 스윕 공간 (그대로 합침)\n";
+        }
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        // 같은 점이 여러 로그에 있으면 첫 점만 남는다 (같은 목적 벡터 → 먼저 들어온 점 유지)
+
+        const auto front = pf.front();
+        std::cout << "points=" << pf.seen() << "  front=" << front.size() << "  removed=" << pf.removed()
+                  << "  rebuilds=" << pf.rebuilds() << "  " << std::fixed << std::setprecision(1) << ms << " ms\n";
+
+        FILE* out = csv.empty() ? stdout : std::fopen(csv.c_str(), "w");
+        if (!out) { std::cerr << csv << ": open 실패\n"; return 1; }
+        std::fprintf(out, "index");
+        for (const char* n : SweepSpace::NAMES) std::fprintf(out, ",%s", n);
+        for (const std::string& n : obj_names) std::fprintf(out, ",%s", n.c_str());
+        std::fprintf(out, "\n");
+        for (const auto& e : front) {
+            std::fprintf(out, "%llu", (unsigned long long)e.payload.index);
+            for (double v : e.payload.params) std::fprintf(out, ",%.9g", v);
+            for (float v : e.f) std::fprintf(out, ",%.9g", v);
+            std::fprintf(out, "\n");
+        }
+        if (out != stdout) std::fclose(out);
+        return 0;
+    }
+
+    // 상관된 합성 목적 (한쪽을 줄이면 다른 쪽이 늘어나는 곡면 + 잡음)
+    int check() const {
+        std::mt19937 rng(7);
+        std::normal_distribution<float> g(0.0f, 1.0f);
+        std::uniform_real_distribution<float> u(0.0f, 1.0f);
+        auto sample = [&]() {
+            Vec f;
+            float s = 0.0f;
+            for (int d = 0; d < K; ++d) { f[d] = u(rng); s += f[d]; }
+            for (int d = 0; d < K; ++d) f[d] = f[d] / s + 0.05f * std::fabs(g(rng));
+            return f;
+        };
+
+        ParetoFront<K, uint64_t> pf(eps_vec());
+        std::vector<Vec> all;
+        const bool brute = check_n <= 20000;
+        const auto t0 = std::chrono::steady_clock::now();
+        for (long i = 0; i < check_n; ++i) {
+            const Vec f = sample();
+            if (brute) all.push_back(f);
+            pf.insert(f, (uint64_t)i);
+        }
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+        std::cout << "n=" << check_n << "  front=" << pf.size() << "  rebuilds=" << pf.rebuilds()
+                  << "  " << std::fixed << std::setprecision(1) << ms << " ms  ("
+                  << std::setprecision(0) << 1e6 * ms / (double)check_n << " ns/insert)\n";
+        if (!brute) return 0;
+
+        bool any_eps = false;
+        for (int d = 0; d < K; ++d) any_eps |= eps_vec()[d] > 0.0f;
+        if (any_eps) {
+            // ε-보관: 모든 입력 점이 프런트의 어떤 점에 ε-지배되는지 확인
+            // (기각은 ε-지배, 제거는 정확 지배이므로 연쇄돼도 eps 를 넘지 않음)
+            const auto fr = pf.front();
+            long bad = 0;
+            for (const Vec& p : all) {
+                bool cov = false;
+                for (const auto& e : fr) {
+                    bool ok = true;
+                    for (int d = 0; d < K; ++d) ok &= e.f[d] <= p[d] + eps_vec()[d];
+                    if (ok) { cov = true; break; }
+                }
+                bad += !cov;
+            }
+            std::cout << "eps coverage: " << (bad ? "FAIL " : "OK ") << bad << "\n";
+            return bad ? 1 : 0;
+        }
+
+        // 전수: 다른 어떤 점에도 약지배되지 않는 점 (동일 값은 먼저 나온 것)
+        std::vector<uint64_t> ref;
+        for (size_t i = 0; i < all.size(); ++i) {
+            bool dom = false;
+            for (size_t j = 0; j < all.size() && !dom; ++j) {
+                if (i == j) continue;
+                bool le = true, lt = false;
+                for (int d = 0; d < K; ++d) { le &= all[j][d] <= all[i][d]; lt |= all[j][d] < all[i][d]; }
+                dom = le && (lt || j < i);
+            }
+            if (!dom) ref.push_back(i);
+        }
+        std::vector<uint64_t> got;
+        pf.for_each([&](const typename ParetoFront<K, uint64_t>::Entry& e) { got.push_back(e.payload); });
+        std::sort(got.begin(), got.end());
+        const bool ok = got == ref;
+        std::cout << "brute-force front=" << ref.size() << "  " << (ok ? "MATCH" : "MISMATCH") << "\n";
+        return ok ? 0 : 1;
+    }
+};
+
+int main(int argc, char** argv) {
+    std::vector<std::string> in;
+    std::string obj_s = "overshoot,settle_s,effort,noise", eps_s, csv;
+    long check_n = 0;
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        if (a == "--obj" && i + 1 < argc)        obj_s = argv[++i];
+        else if (a == "--eps" && i + 1 < argc)   eps_s = argv[++i];
+        else if (a == "--csv" && i + 1 < argc)   csv = argv[++i];
+        else if (a == "--check" && i + 1 < argc) check_n = std::atol(argv[++i]);
+        else in.push_back(a);
+    }
+    if (in.empty() && check_n <= 0) {
+        std::cerr << "usage: " << argv[0] << " <in.log>... [--obj a,b,..] [--eps e1,e2,..] [--csv out.csv]\n"
+                  << "       " << argv[0] << " --check <n> [--obj ..] [--eps ..]\n";
+        return 1;
+    }
+
+    const std::vector<std::string> names = split(obj_s);
+    std::vector<int> obj;
+    for (const std::string& n : names) {
+        int id = (n == "noise") ? NOISE : -2;
+        for (int k = 0; k < StepMetrics::N_FIELDS; ++k)
+            if (n == StepMetrics::NAMES[k]) id = k;
+        if (id == -2) { std::cerr << "알 수 없는 목적: " << n << "\n"; return 1; }
+        obj.push_back(id);
+    }
+    std::vector<float> eps;
+    for (const std::string& e : split(eps_s)) eps.push_back(std::strtof(e.c_str(), nullptr));
+
+    switch (obj.size()) {
+    case 2: return FrontJob<2>{ in, obj, names, eps, csv, check_n }.run();
+    case 3: return FrontJob<3>{ in, obj, names, eps, csv, check_n }.run();
+    case 4: return FrontJob<4>{ in, obj, names, eps, csv, check_n }.run();
+    case 5: return FrontJob<5>{ in, obj, names, eps, csv, check_n }.run();
+    default: std::cerr << "목적 개수는 2..5\n"; return 1;
+    }
+}
@@ -0,0 +1,211 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// ============================================================
+//  스트리밍 파레토 프런트 (비지배 집합, 모든 목적 최소화)
+//  - 점을 하나씩 넣으면 비지배 점만 유지 — 스윕 결과 전체를 저장하지 않음
+//  - 색인: k-d 트리 + 노드별 부분트리 경계상자
+//      지배 여부  : 경계상자 lo 가 p(+eps) 보다 큰 축이 있으면 부분트리 생략
+//      제거 대상  : 경계상자 hi 가 p 보다 작은 축이 있으면 부분트리 생략
+//    삽입은 O(depth) = O(log n) (깊이가 2·log2(n)+8 을 넘거나 지운 점이
+//    살아 있는 점보다 많아지면 중앙값 분할로 재구성)
+//    지배 질의는 경계상자 가지치기 — 프런트가 작으면 사실상 O(log n),
+//    최악은 k-d 범위 질의와 같은 O(n^(1-1/K))
+//  - 질의 정확성은 경계상자만으로 보장 (분할 축은 삽입 경로 선택용)
+//  - 제거는 지연 삭제 (경계상자는 보수적으로 유지되므로 결과는 정확)
+//  - eps[d] > 0 : 가산 ε-지배 보관 (q ≤ p + eps 인 q 가 있으면 p 기각)
+//    → 모든 입력 점이 프런트의 어떤 점에 ε-지배되고, 한 변 eps 인 격자 칸마다
+//      최대 한 점이므로 연속 목적에서도 프런트 크기가 유한
+//  - 같은 값(모든 축 동일)은 먼저 들어온 점 유지
+//  - 비유한 값(NaN/Inf)이 있는 점은 기각
+// ============================================================
+
+template <int K, class T = uint64_t>
+class ParetoFront {
+public:
+    using Vec = std::array<float, K>;
+
+    struct Entry {
+        Vec f;
+        T   payload;
+    };
+
+    explicit ParetoFront(const Vec& eps = Vec{}) : eps_(eps) {}
+
+    // 반환: 채택 여부. 채택 시 이 점이 지배하는 기존 점은 제거
+    bool insert(const Vec& f, const T& payload) {
+        ++seen_;
+        for (int d = 0; d < K; ++d)
+            if (!std::isfinite(f[d])) return false;
+        if (dominated(f)) return false;
+        remove_dominated(f);
+        add(f, payload);
+        if (dead_ > alive_ + 64 || depth_ > depth_limit()) rebuild();
+        return true;
+    }
+
+    size_t   size() const { return alive_; }
+    uint64_t seen() const { return seen_; }
+    uint64_t removed() const { return removed_; }
+    uint64_t rebuilds() const { return rebuilds_; }
+
+    template <class F>
+    void for_each(F&& f) const {
+        for (const Node& n : nodes_)
+            if (n.alive) f(n.e);
+    }
+
+    // 첫 목적 오름차순 (동률은 다음 목적)
+    std::vector<Entry> front() const {
+        std::vector<Entry> out;
+        out.reserve(alive_);
+        for_each([&](const Entry& e) { out.push_back(e); });
+        std::sort(out.begin(), out.end(), [](const Entry& a, const Entry& b) { return a.f < b.f; });
+        return out;
+    }
+
+    void clear() {
+        nodes_.clear();
+        root_ = -1;
+        alive_ = dead_ = 0;
+        depth_ = 0;
+    }
+
+private:
+    struct Node {
+        Entry   e;
+        Vec     lo, hi;       // 부분트리 경계상자 (지운 점 포함, 보수적)
+        int32_t left = -1, right = -1;
+        uint8_t dim  = 0;
+        bool    alive = true;
+    };
+
+    // DFS 스택 깊이 ≤ 트리 깊이 + 1, 트리 깊이 ≤ depth_limit() + 1
+    static constexpr int STACK = 2 * 64 + 16;
+
+    int depth_limit() const {
+        int lg = 0;
+        for (size_t n = alive_; n > 1; n >>= 1) ++lg;
+        return 2 * lg + 8;
+    }
+
+    bool dominated(const Vec& p) const {
+        if (root_ < 0) return false;
+        int32_t stack[STACK];
+        int sp = 0;
+        stack[sp++] = root_;
+        while (sp > 0) {
+            const Node& n = nodes_[stack[--sp]];
+            bool cut = false, dom = n.alive;
+            for (int d = 0; d < K; ++d) {
+                const float lim = p[d] + eps_[d];
+                if (n.lo[d] > lim) { cut = true; break; }
+                if (n.e.f[d] > lim) dom = false;
+            }
+            if (cut) continue;
+            if (dom) return true;
+            if (n.left  >= 0) stack[sp++] = n.left;
+            if (n.right >= 0) stack[sp++] = n.right;
+        }
+        return false;
+    }
+
+    void remove_dominated(const Vec& p) {
+        if (root_ < 0) return;
+        int32_t stack[STACK];
+        int sp = 0;
+        stack[sp++] = root_;
+        while (sp > 0) {
+            Node& n = nodes_[stack[--sp]];
+            bool cut = false, dom = n.alive;
+            for (int d = 0; d < K; ++d) {
+                if (n.hi[d] < p[d]) { cut = true; break; }
+                if (n.e.f[d] < p[d]) dom = false;
+            }
+            if (cut) continue;
+            if (dom) { n.alive = false; --alive_; ++dead_; ++removed_; }
+            if (n.left  >= 0) stack[sp++] = n.left;
+            if (n.right >= 0) stack[sp++] = n.right;
+        }
+    }
+
+    int32_t new_node(const Entry& e, int dim) {
+        Node n;
+        n.e = e;
+        n.lo = n.hi = e.f;
+        n.dim = (uint8_t)dim;
+        nodes_.push_back(n);
+        ++alive_;
+        return (int32_t)nodes_.size() - 1;
+    }
+
+    void add(const Vec& f, const T& payload) {
+        const Entry e{ f, payload };
+        if (root_ < 0) { root_ = new_node(e, 0); depth_ = 1; return; }
+        int32_t i = root_;
+        int depth = 1;
+        for (;;) {
+            Node& n = nodes_[i];
+            for (int d = 0; d < K; ++d) {
+                n.lo[d] = std::min(n.lo[d], f[d]);
+                n.hi[d] = std::max(n.hi[d], f[d]);
+            }
+            const bool go_left = f[n.dim] < n.e.f[n.dim];
+            const int32_t next = go_left ? n.left : n.right;
+            ++depth;
+            if (next < 0) {
+                const int dim = (n.dim + 1) % K;
+                const int32_t c = new_node(e, dim);     // nodes_ 재할당 가능 → n 다시 참조
+                (go_left ? nodes_[i].left : nodes_[i].right) = c;
+                break;
+            }
+            i = next;
+        }
+        depth_ = std::max(depth_, depth);
+    }
+
+    // 살아 있는 점만 모아 중앙값 분할로 균형 트리 재구성
+    void rebuild() {
+        std::vector<Entry> es;
+        es.reserve(alive_);
+        for_each([&](const Entry& e) { es.push_back(e); });
+        clear();
+        nodes_.reserve(es.size());
+        root_ = build(es, 0, (int)es.size(), 0, 1);
+        ++rebuilds_;
+    }
+
+    int32_t build(std::vector<Entry>& es, int b, int e, int dim, int depth) {
+        if (b >= e) return -1;
+        const int m = b + (e - b) / 2;
+        std::nth_element(es.begin() + b, es.begin() + m, es.begin() + e,
+                         [dim](const Entry& x, const Entry& y) { return x.f[dim] < y.f[dim]; });
+        const int32_t i = new_node(es[m], dim);
+        depth_ = std::max(depth_, depth);
+        const int nd = (dim + 1) % K;
+        const int32_t l = build(es, b, m, nd, depth + 1);
+        const int32_t r = build(es, m + 1, e, nd, depth + 1);
+        Node& n = nodes_[i];
+        n.left = l;  n.right = r;
+        for (int32_t c : { l, r }) {
+            if (c < 0) continue;
+            for (int d = 0; d < K; ++d) {
+                n.lo[d] = std::min(n.lo[d], nodes_[c].lo[d]);
+                n.hi[d] = std::max(n.hi[d], nodes_[c].hi[d]);
+            }
+        }
+        return i;
+    }
+
+    Vec               eps_;
+    std::vector<Node> nodes_;
+    int32_t           root_ = -1;
+    size_t            alive_ = 0, dead_ = 0;
+    int               depth_ = 0;
+    uint64_t          seen_ = 0, removed_ = 0, rebuilds_ = 0;
+};
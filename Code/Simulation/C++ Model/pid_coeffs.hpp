@@ -0,0 +1,70 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+
+#include "pid_model.hpp"
+
+// ============================================================
+//  연속계 게인 → Δ-form 계수 (SW Driver/app.c compute_coeffs 와 같은 식)
+//  - double 로 계산 후 float 로 한 번 반올림 (드라이버와 비트 동일)
+//  - COEFFS_HEX 는 DEFAULT_GAINS, Ts = 0.005 의 계수를 소수 9자리로 자른 값에서
+//    만들어졌으므로 c0/c3/c7a/c7b 는 여기 결과와 수 ulp 차이가 난다
+// ============================================================
+
+struct PidGains {
+    double Kp, Ki, Kd;
+    double N;       // D-필터 (a = 1/N)
+    double b, c;    // P/D setpoint weight
+    double Kb;      // anti-windup [1/s]
+};
+
+static const PidGains DEFAULT_GAINS = { 0.11, 0.08, 0.0011, 120.0, 1.0, 0.0, 12.0 };
+
+// 연속계 → 시간상수/필터 파라미터 (app.c compute_time_constants)
+static inline void compute_time_constants(const PidGains& g, double& Ti, double& Td, double& a) {
+    Ti = (g.Ki > 0.0 && g.Kp > 0.0) ? (g.Kp / g.Ki) : 1e30;   // Ki=0 → effectively ∞
+    Td = (g.Kp > 0.0) ? (g.Kd / g.Kp) : 0.0;
+    a  = (g.N  > 0.0) ? (1.0 / g.N) : 0.0;
+}
+
+// double 계수 c0..c7b (드리프트 상한의 이상 계수로도 사용)
+static inline std::array<double, 9> compute_coeffs_d(const PidGains& g, double Ts) {
+    double Ti, Td, a;
+    compute_time_constants(g, Ti, Td, a);
+
+    const double Kp = g.Kp, b = g.b, c = g.c;
+    const double den        = Ts + a*Td;
+    const double Ts_over_Ti = (Ti < 1e20) ? (Ts/Ti) : 0;
+
+    const double C0_ = (den > 0.0) ? ((a*Td)/den) : 0.0;
+    const double C1_ =  Kp * ( b + Ts_over_Ti + (Td*c)/den );
+    const double C2_ = -Kp * (  b*(Ts + 2.0*a*Td)
+                              + (a*Td*Ts_over_Ti)
+                              + (2.0*Td*c) ) / den;
+    const double C3_ =  (Kp*Td*(a*b + c)) / den;
+    const double C4_ = -Kp * ( 1.0 + Ts_over_Ti + (Td/den) );
+    const double C5_ =  Kp * (  Ts + 2.0*a*Td
+                              + (a*Td*Ts_over_Ti)
+                              + (2.0*Td) ) / den;
+    const double C6_ = -Kp * ( Td*(a + 1.0) ) / den;
+
+    // 2-tap AW: c7a = Kb*Ki*Ts, c7b = -c7a*c0
+    const double C7A_ = g.Ki * g.Kb * Ts;
+    const double C7B_ = -C7A_ * C0_;
+
+    return { C0_, C1_, C2_, C3_, C4_, C5_, C6_, C7A_, C7B_ };
+}
+
+static inline DeltaCoeffs compute_coeffs(const PidGains& g, double Ts) {
+    const std::array<double, 9> c = compute_coeffs_d(g, Ts);
+    return DeltaCoeffs{ (float)c[0], (float)c[1], (float)c[2], (float)c[3], (float)c[4],
+                        (float)c[5], (float)c[6], (float)c[7], (float)c[8] };
+}
+
+// 측정 잡음 민감도: 선형 영역 x → y 의 나이퀴스트(z = -1) 이득
+//   Δy·(1 - c0·z⁻¹) = (c4 + c5·z⁻¹ + c6·z⁻²)·x,   y·(1 - z⁻¹) = Δy
+static inline double noise_gain(const DeltaCoeffs& k) {
+    const double den = 2.0 * std::fabs(1.0 + (double)k.c0);
+    return (den > 0.0) ? std::fabs((double)k.c4 - (double)k.c5 + (double)k.c6) / den : INFINITY;
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "pid_model.hpp"
+
+// ============================================================
+//  RTL 사이클 모델 (pid_top.v / pid_controller.v / pwm_generator.v / enc_pulse.v)
+//  - 값은 C++ 모델로 계산하고, 여기서는 "언제" 보이는지만 사이클 단위로 계산
+//  - Xilinx Floating-Point IP 지연은 Vivado IP 설정에 맞춰 수정
+// ============================================================
+
+struct IpLatency {
+    int fma  = 16;  // floating_point_0 : a*b±c
+    int comp = 2;   // floating_point_1 : compare
+    int i2f  = 6;   // floating_point_2 : int16 → float
+    int mul  = 8;   // floating_point_3 : a*b (pwm_generator)
+    int f2f  = 6;   // floating_point_4 : float → fixed
+    int div  = 28;  // floating_point_5 : a / b (coeff_synth)
+};
+
+struct RtlParams {
+    long clk_hz    = 100'000'000;
+    long pwm_hz    = 20'000;
+    long gate_hz   = 200;
+    int  minpw_cyc = 50;            // enc_pulse MINPW_CYC
+    IpLatency ip;
+
+    long gate_cycles() const { return clk_hz / gate_hz; }
+    long pwm_period()  const { return clk_hz / pwm_hz; }
+};
+
+// ------------------------------------------------------------
+// pid_controller_axi FSM
+//  IDLE(data_valid) → LATCH → X_CONV(SETUP+i2f) → XN_CALC(SETUP+fma)
+//  → MAC×7 → AW(SUB,ACC)×2 → ADD_Y → SAT GT/LT(SETUP+comp)×2
+//  → FINALIZE → UPDATE(out_valid)
+//  SETUP 은 tready=1 가정 시 1사이클, WAIT 은 IP 지연만큼
+// ------------------------------------------------------------
+struct PidFsmCycleModel {
+    static constexpr int N_FMA_OPS  = 1 + 7 + 4 + 1;   // XN, MAC×7, AW×4, ADD_Y
+    static constexpr int N_COMP_OPS = 2;
+
+    // data_valid_in 을 본 IDLE 사이클 → out_valid(S_UPDATE) 사이클까지
+    static long cycles_to_out_valid(const IpLatency& ip) {
+        return 1                                   // IDLE → LATCH
+             + 1                                   // LATCH → X_CONV_SETUP
+             + (1 + ip.i2f)
+             + (long)N_FMA_OPS  * (1 + ip.fma)
+             + (long)N_COMP_OPS * (1 + ip.comp)
+             + 1;                                  // FINALIZE → UPDATE
+    }
+};
+
+// ------------------------------------------------------------
+// pwm_generator
+//  - voltage_valid 을 본 IDLE 사이클 다음에 dir_out 갱신
+//  - SCALE_MUL, FINAL_MUL, F2F 를 거쳐 compare_value 갱신
+//  - pwm_out <= (pwm_counter < compare_value) : 1사이클 레지스터 지연
+// ------------------------------------------------------------
+struct PwmGeneratorModel {
+    static constexpr float PWM_PERIOD_FP = 5000.0f;   // RTL 상수 32'h459C4000
+
+    static long cycles_to_dir(const IpLatency&) { return 1; }
+
+    static long cycles_to_compare(const IpLatency& ip) {
+        return 1 + 2 * (1 + ip.mul) + (1 + ip.f2f);
+    }
+
+    // |y| * (1/YSAT) * 5000 → 정수 (float→fixed IP: round-to-nearest-even)
+    static long compare_value(float y, float recip_ysat, long period) {
+        const float scaled = mul_rn(std::fabs(y), recip_ysat);
+        const float final_ = mul_rn(scaled, PWM_PERIOD_FP);
+        const long  cv     = std::lrintf(final_);
+        return (cv >= period) ? period - 1 : cv;
+    }
+
+    static bool dir_from(float y) { return !std::signbit(y); }
+};
+
+// ------------------------------------------------------------
+// gate_pulse → 새 compare_value 적용까지 지연 [s]
+//  (delta_valid 1 + PID FSM + pwm_generator 파이프라인)
+//  ClosedLoop::run_delayed 용 ConstantLatency 의 값으로 사용
+// ------------------------------------------------------------
+static inline float cycle_model_latency(const RtlParams& rtl) {
+    const long cyc = 1 + PidFsmCycleModel::cycles_to_out_valid(rtl.ip)
+                       + PwmGeneratorModel::cycles_to_compare(rtl.ip);
+    return (float)((double)cyc / (double)rtl.clk_hz);
+}
+
+// ------------------------------------------------------------
+// enc_pulse
+//  - 에지가 샘플된 사이클 c 에서 2-FF 동기화 + MINPW 필터 + 디코더 레지스터를
+//    거쳐 c + latency() 사이클에 step 이 acc8_next 에 반영
+//  - gate_pulse 사이클에 acc8_next 를 spdcnt 로 래치, 다음 사이클 delta_valid
+//  - 누적기는 16비트 포화
+// ------------------------------------------------------------
+struct EncPulseModel {
+    int  minpw_cyc;
+    long gate_cycles;
+
+    int16_t acc = 0;
+
+    long latency() const { return 2 + minpw_cyc; }
+
+    // gate_pulse 사이클 (k = 1, 2, ...) : gate_cnt == GATE_CYCLES-1
+    long gate_pulse_cycle(long k) const { return k * gate_cycles - 1; }
+
+    void step(int dir) {
+        if (dir > 0 && acc != INT16_MAX) ++acc;
+        if (dir < 0 && acc != INT16_MIN) --acc;
+    }
+
+    int16_t latch() {
+        const int16_t v = acc;
+        acc = 0;
+        return v;
+    }
+};
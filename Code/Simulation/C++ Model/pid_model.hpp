@@ -0,0 +1,441 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+// ============================================================
+//  공용 C++ 모델 (PID_MY_DIGIT / pid_last_compare 에서 분리)
+//  - 컴파일 옵션 권장: -O2 -std=c++20 -fno-fast-math -ffp-contract=off
+//  - 인코더/컨트롤러/식물은 RoundingPolicy 를 템플릿 인자로 받아
+//    ClosedLoop(closed_loop.hpp)에서 가상 호출 없이 조립된다.
+// ============================================================
+
+// ============================================================
+//  FP32 bit-accurate constants (Verilog localparam HEX 그대로 사용)
+// ============================================================
+static inline float f32_from_hex(uint32_t u){
+    float f;
+    std::memcpy(&f, &u, sizeof(float));
+    return f;
+}
+
+static inline uint32_t f32_to_hex(float f){
+    uint32_t u;
+    std::memcpy(&u, &f, sizeof(float));
+    return u;
+}
+
+// ---- Verilog coeffs (IEEE-754 FP32 bit pattern) ----
+static const float C0  = f32_from_hex(0x3C864B8B); // 0.016393443
+static const float C1  = f32_from_hex(0x3DE21965); // 0.110400000
+static const float C2  = f32_from_hex(0xBDE4FC8E); // -0.254104918
+static const float C3  = f32_from_hex(0x3AEC5C01); // 0.004098361
+static const float C4  = f32_from_hex(0xBEA75178); // -0.742203279
+static const float C5  = f32_from_hex(0x3F0B6AB1); // 1.237711475
+static const float C6  = f32_from_hex(0xBE5F6EF6); // -0.495901639
+static const float C7A = f32_from_hex(0x3B9D4952); // 0.040000000
+static const float C7B = f32_from_hex(0xB8A505D6); // -0.000655738
+
+static const float YSAT       = f32_from_hex(0x41400000); // 12.0
+static const float RECIP_YSAT = f32_from_hex(0x3DAAAAAB); // 1/12
+static const float W_TGT      = f32_from_hex(0x42C80000); // 100.0
+
+// 인코더 변환 상수도 Verilog HEX 그대로
+static const float INT2RADS   = f32_from_hex(0x3F70CAF0); // 0.94059658 rad/s per count
+
+// ============================================================
+//  Δ-form 계수 묶음 (레지스터 REG_A0..REG_C8 과 1:1)
+// ============================================================
+struct DeltaCoeffs {
+    float c0;
+    float c1, c2, c3;   // w[n], w[n-1], w[n-2]
+    float c4, c5, c6;   // x[n], x[n-1], x[n-2]
+    float c7a, c7b;     // AW tap1, tap2
+};
+
+static const DeltaCoeffs COEFFS_HEX = { C0, C1, C2, C3, C4, C5, C6, C7A, C7B };
+
+// Δ-form 이력 레지스터 스냅샷 (RTL: delta_y_d1, w_d*, x_d*, y_d*, y_sat_d*)
+struct DeltaPidState {
+    float dy1;
+    float w1, w2;
+    float x1, x2;
+    float y_unsat_1, y_unsat_2;
+    float y_sat_1,   y_sat_2;
+};
+
+// RTL 이력 레지스터 (pid_controller hist_out / REG_HIST0..8) 와 같은 순서의 FP32 워드
+static constexpr int DELTA_PID_STATE_WORDS = 9;
+
+static inline void state_to_words(const DeltaPidState& s, uint32_t w[DELTA_PID_STATE_WORDS]) {
+    const float f[DELTA_PID_STATE_WORDS] = { s.dy1, s.w1, s.w2, s.x1, s.x2,
+                                             s.y_unsat_1, s.y_unsat_2, s.y_sat_1, s.y_sat_2 };
+    for (int i = 0; i < DELTA_PID_STATE_WORDS; ++i) w[i] = f32_to_hex(f[i]);
+}
+
+static inline DeltaPidState state_from_words(const uint32_t w[DELTA_PID_STATE_WORDS]) {
+    auto f = [w](int i) { return f32_from_hex(w[i]); };
+    return { f(0), f(1), f(2), f(3), f(4), f(5), f(6), f(7), f(8) };
+}
+
+// ============================================================
+//  RoundingPolicy
+//  - RoundVolatile : 기존 mul_rn/add_rn. volatile 저장으로 매 단계 FP32
+//                    라운딩을 강제 (융합하지 않는 MUL->ADD 데이터패스의 라운딩 지점.
+//                    RTL MAC 은 융합 FMA IP 라 마지막 ulp 가 다를 수 있음)
+//  - RoundNative   : 일반 float 연산. -ffp-contract=off + SSE 에서는
+//                    RoundVolatile 과 비트 동일하며, 컴파일러가 한 게이트
+//                    전체를 하나의 블록으로 인라인/스케줄할 수 있다.
+// ============================================================
+struct RoundVolatile {
+    static float mul(float a, float b) { volatile float r = a * b; return r; }
+    static float add(float a, float b) { volatile float r = a + b; return r; }
+};
+
+struct RoundNative {
+    static float mul(float a, float b) { return a * b; }
+    static float add(float a, float b) { return a + b; }
+};
+
+// 기존 드라이버 호환용 헬퍼
+static inline float mul_rn(float a, float b) { return RoundVolatile::mul(a, b); }
+static inline float add_rn(float a, float b) { return RoundVolatile::add(a, b); }
+
+// ============================================================
+//  이력 저장 형식 (DeltaPid2TapAw::kernel 의 Hist 인자)
+//  - W / X : w[n-1..2], x[n-1..2] 저장 (enc 로 저장, dec 로 FP32 복원)
+//  - S     : y_sat[n-1..2] 저장. dec 는 같은 게이트의 y_unsat, YSAT 를 받는다
+//            (축소 형식은 reduced_history.hpp)
+//  - HistExact (기본) : 전부 FP32 그대로 = RTL 이력 레지스터
+// ============================================================
+struct HistF32 {
+    using type = float;
+    static constexpr const char* NAME = "f32";
+    static type  enc(float f) { return f; }
+    static float dec(type v)  { return v; }
+};
+
+struct SatF32 {
+    using type = float;
+    static type  enc(float y_sat, float) { return y_sat; }
+    static float dec(type s, float, float) { return s; }
+};
+
+template <class WS, class XS, class SS>
+struct HistCodec {
+    using W = WS;
+    using X = XS;
+    using S = SS;
+};
+
+using HistExact = HistCodec<HistF32, HistF32, SatF32>;
+
+// ============================================================
+// Δ-form PID (2-tap AW) : Verilog과 동일 계수/누적 순서
+// ============================================================
+template <class Rnd = RoundVolatile>
+class DeltaPid2TapAw {
+public:
+    explicit DeltaPid2TapAw(float y_sat_limit, const DeltaCoeffs& k = COEFFS_HEX)
+        : YSAT_(y_sat_limit), k_(k) { reset(); }
+
+    // 이력만 0 (수동 모드/계수는 레지스터라 유지)
+    void reset() {
+        dy1 = 0.0f;
+        w1 = w2 = 0.0f;
+        x1 = x2 = 0.0f;
+        y_unsat_1 = 0.0f;  y_unsat_2 = 0.0f;
+        y_sat_1   = 0.0f;  y_sat_2   = 0.0f;
+    }
+
+    float step(float w, float x) {
+        if (man_)
+            return kernel<true>(k_, YSAT_, y_man_, dy1, w1, w2, x1, x2, y_unsat_1, y_unsat_2, y_sat_1, y_sat_2, w, x);
+        return kernel<false>(k_, YSAT_, y_man_, dy1, w1, w2, x1, x2, y_unsat_1, y_unsat_2, y_sat_1, y_sat_2, w, x);
+    }
+
+    // 입력을 미리 아는 재생/비교용 일괄 스텝 (반복 step() 과 비트 동일)
+    //  - 상태/계수를 지역 변수로 옮겨 루프 내내 레지스터에 둔다
+    //    (y 쓰기가 멤버와 별칭일 수 있어 step() 반복은 매번 다시 읽고 쓴다)
+    //  - 길이는 가장 짧은 span 기준
+    void step_n(std::span<const float> w, std::span<const float> x, std::span<float> y) {
+        const size_t n = std::min({ w.size(), x.size(), y.size() });
+        run_n(n, [w](size_t i) { return w[i]; }, x.data(), y.data());
+    }
+
+    // 고정 목표값
+    void step_n(float w, std::span<const float> x, std::span<float> y) {
+        run_n(std::min(x.size(), y.size()), [w](size_t) { return w; }, x.data(), y.data());
+    }
+
+    DeltaPidState snapshot() const {
+        return { dy1, w1, w2, x1, x2, y_unsat_1, y_unsat_2, y_sat_1, y_sat_2 };
+    }
+
+    void restore(const DeltaPidState& s) {
+        dy1 = s.dy1;
+        w1 = s.w1;  w2 = s.w2;
+        x1 = s.x1;  x2 = s.x2;
+        y_unsat_1 = s.y_unsat_1;  y_unsat_2 = s.y_unsat_2;
+        y_sat_1   = s.y_sat_1;    y_sat_2   = s.y_sat_2;
+    }
+
+    // AW 탭이 모두 0 (직전 2샘플 비포화) → 다음 스텝은 순수 선형
+    bool aw_idle() const { return y_sat_1 == y_unsat_1 && y_sat_2 == y_unsat_2; }
+
+    const DeltaCoeffs& coeffs() const { return k_; }
+    float y_sat_limit() const { return YSAT_; }
+
+    // 계수 레지스터 재기록 (이력은 유지 — 동작 중 REG 쓰기와 같음)
+    void set_coeffs(const DeltaCoeffs& k) { k_ = k; }
+
+    // 수동/자동 (REG_CTRL bit3, REG_Y_MAN). 다음 step() 부터 적용 (RTL 입력 래치와 같음)
+    //  - 수동: 출력 = clamp(y_man). Δy 는 그대로 계산해 dy[n-1] 로 남기고
+    //          y_unsat/y_sat 이력은 실제 출력으로 추종 (AW 오차 0)
+    //  - 자동 복귀 첫 게이트: y = y_man + Δy → 무충격
+    void set_manual(bool on) { man_ = on; }
+    void set_y_man(float y)  { y_man_ = y; }
+    bool  manual() const { return man_; }
+    float y_man()  const { return y_man_; }
+
+    // 한 스텝 (step / step_n / DeltaPid2TapAwHist 공용). 상태는 참조로 받아 그 자리에서 갱신
+    //  Manual: y 누적 대신 y_man (RTL: 1·y_man + 0, −0 → +0 까지 같게) 후 이력 추종
+    //  Hist  : 이력 저장 형식 (HistExact 면 FP32 레지스터 그대로)
+    template <bool Manual, class Hist = HistExact>
+    static float kernel(const DeltaCoeffs& k, float ysat, float y_man, float& dy1,
+                        typename Hist::W::type& w1, typename Hist::W::type& w2,
+                        typename Hist::X::type& x1, typename Hist::X::type& x2,
+                        float& y_unsat_1, float& y_unsat_2,
+                        typename Hist::S::type& y_sat_1, typename Hist::S::type& y_sat_2,
+                        float w, float x) {
+        using WS = typename Hist::W;
+        using XS = typename Hist::X;
+        using SS = typename Hist::S;
+        const float e_sat_1 = Rnd::add(SS::dec(y_sat_1, y_unsat_1, ysat), -y_unsat_1); // ysat - yunsat [n-1]
+        const float e_sat_2 = Rnd::add(SS::dec(y_sat_2, y_unsat_2, ysat), -y_unsat_2); // ysat - yunsat [n-2]
+
+        // dy = Σ(ci * si)  (MUL -> ADD 누산, 각 단계 라운딩)
+        float acc = 0.0f;
+        acc = Rnd::add(acc, Rnd::mul(k.c0,  dy1));
+        acc = Rnd::add(acc, Rnd::mul(k.c1,  w));
+        acc = Rnd::add(acc, Rnd::mul(k.c2,  WS::dec(w1)));
+        acc = Rnd::add(acc, Rnd::mul(k.c3,  WS::dec(w2)));
+        acc = Rnd::add(acc, Rnd::mul(k.c4,  x));
+        acc = Rnd::add(acc, Rnd::mul(k.c5,  XS::dec(x1)));
+        acc = Rnd::add(acc, Rnd::mul(k.c6,  XS::dec(x2)));
+        acc = Rnd::add(acc, Rnd::mul(k.c7a, e_sat_1));
+        acc = Rnd::add(acc, Rnd::mul(k.c7b, e_sat_2));
+        const float dy = acc;
+
+        // 누적 구조: y_unsat[n] = y_unsat[n-1] + dy[n]
+        float       y_unsat = Manual ? Rnd::add(y_man, 0.0f) : Rnd::add(y_unsat_1, dy);
+        const float y_sat   = std::clamp(y_unsat, -ysat, +ysat);
+        if constexpr (Manual) y_unsat = y_sat;
+
+        // 상태 갱신
+        dy1 = dy;
+        w2 = w1; w1 = WS::enc(w);
+        x2 = x1; x1 = XS::enc(x);
+
+        y_unsat_2 = y_unsat_1;  y_unsat_1 = y_unsat;
+        y_sat_2   = y_sat_1;    y_sat_1   = SS::enc(y_sat, y_unsat);
+
+        return y_sat;
+    }
+
+private:
+
+    template <class WAt>
+    void run_n(size_t n, WAt w_at, const float* x, float* y) {
+        const DeltaCoeffs k = k_;
+        const float ysat = YSAT_;
+        float d1 = dy1, a1 = w1, a2 = w2, b1 = x1, b2 = x2;
+        float u1 = y_unsat_1, u2 = y_unsat_2, s1 = y_sat_1, s2 = y_sat_2;
+        const float ym = y_man_;
+        if (man_)
+            for (size_t i = 0; i < n; ++i)
+                y[i] = kernel<true>(k, ysat, ym, d1, a1, a2, b1, b2, u1, u2, s1, s2, w_at(i), x[i]);
+        else
+            for (size_t i = 0; i < n; ++i)
+                y[i] = kernel<false>(k, ysat, ym, d1, a1, a2, b1, b2, u1, u2, s1, s2, w_at(i), x[i]);
+        dy1 = d1;  w1 = a1;  w2 = a2;  x1 = b1;  x2 = b2;
+        y_unsat_1 = u1;  y_unsat_2 = u2;  y_sat_1 = s1;  y_sat_2 = s2;
+    }
+
+    float YSAT_;
+    DeltaCoeffs k_;
+    bool  man_   = false;
+    float y_man_ = 0.0f;
+
+    float dy1;
+    float w1, w2;
+    float x1, x2;
+    float y_unsat_1, y_unsat_2;
+    float y_sat_1,   y_sat_2;
+};
+
+// ============================================================
+// General PID (FP32) : P/I/D 분리형 + 1차 D필터 + back-calculation AW(1-tap)
+//  - "수식 동치" 비교용. step()은 ClosedLoop 인터페이스용 별칭
+// ============================================================
+template <class Rnd = RoundVolatile>
+class GeneralPidControllerF32 {
+public:
+    GeneralPidControllerF32(float kp, float ki, float kd,
+                            float a, float b, float c,
+                            float kb,
+                            float dt, float out_min, float out_max)
+        : Kp(kp), Ki(ki), Kd(kd),
+          a_param(a), b_weight(b), c_weight(c),
+          Kb(kb),
+          dt(dt), output_min(out_min), output_max(out_max)
+    { reset(); }
+
+    void reset() {
+        integral_term = 0.0f;
+        derivative_term_prev = 0.0f;
+        setpoint_prev = 0.0f;
+        measurement_prev = 0.0f;
+        unsaturated_output_prev = 0.0f;
+        saturated_output_prev   = 0.0f;
+    }
+
+    float calculate(float setpoint, float measurement) {
+        const float error = Rnd::add(setpoint, -measurement);
+
+        const float p_term = Rnd::mul(Kp, Rnd::add(Rnd::mul(b_weight, setpoint), -measurement));
+
+        const float Td = (Kp > 1e-12f) ? (Kd / Kp) : 0.0f;
+        const float common_denominator = Rnd::add(Rnd::mul(a_param, Td), dt); // (a*Td + Ts)
+        const float coeff_feedback     = Rnd::mul(a_param, Td) / common_denominator;
+        const float coeff_gain         = Rnd::mul(Kp, Td) / common_denominator;
+
+        const float derivative_input_change =
+            Rnd::add(Rnd::mul(c_weight, Rnd::add(setpoint, -setpoint_prev)),
+                     -Rnd::add(measurement, -measurement_prev));
+
+        const float d_term = Rnd::add(Rnd::mul(coeff_feedback, derivative_term_prev),
+                                      Rnd::mul(coeff_gain, derivative_input_change));
+
+        const float saturation_error = Rnd::add(saturated_output_prev, -unsaturated_output_prev); // e_sat[n-1]
+        integral_term = Rnd::add(integral_term,
+                                 Rnd::mul(Rnd::mul(Ki, Rnd::add(error, Rnd::mul(Kb, saturation_error))), dt));
+
+        const float unsaturated_output = Rnd::add(Rnd::add(p_term, integral_term), d_term);
+        const float saturated_output   = std::max(output_min, std::min(unsaturated_output, output_max));
+
+        setpoint_prev           = setpoint;
+        measurement_prev        = measurement;
+        derivative_term_prev    = d_term;
+        unsaturated_output_prev = unsaturated_output;
+        saturated_output_prev   = saturated_output;
+
+        return saturated_output;
+    }
+
+    float step(float w, float x) { return calculate(w, x); }
+
+private:
+    float Kp, Ki, Kd;
+    float a_param, b_weight, c_weight;
+    float Kb;
+    float dt, output_min, output_max;
+
+    float integral_term;
+    float derivative_term_prev;
+    float setpoint_prev, measurement_prev;
+    float unsaturated_output_prev, saturated_output_prev;
+};
+
+// ============================================================
+// Encoder: floor + carry
+//  - INT_TO_RADS_FACTOR는 Verilog HEX를 그대로 사용(INT2RADS)
+//  - rad_per_cnt는 INT2RADS*Ts로 만들어 PI 계산 경로 제거
+// ============================================================
+template <class Rnd = RoundVolatile>
+struct EncoderFloor {
+    float Ts;
+    float rad_per_cnt;   // (2π/CPR)와 동치
+    float int2radfac;    // INT_TO_RADS_FACTOR (Verilog 상수)
+    float theta_rad;
+    long  C_prev;
+
+    explicit EncoderFloor(float Ts_)
+        : Ts(Ts_), theta_rad(0.0f), C_prev(0)
+    {
+        int2radfac  = INT2RADS;
+        rad_per_cnt = Rnd::mul(int2radfac, Ts);
+    }
+
+    void sample(float x_true, int& spdcnt, float& x_meas) {
+        // theta += w*Ts
+        theta_rad = std::fmaf(x_true, Ts, theta_rad);
+
+        const float C_real = theta_rad / rad_per_cnt;
+        const long  C_now  = (long)std::floor(C_real);
+
+        spdcnt = (int)(C_now - C_prev);
+        C_prev = C_now;
+
+        // x_meas = spdcnt * INT2RADS
+        x_meas = Rnd::mul((float)spdcnt, int2radfac);
+    }
+};
+
+// ============================================================
+// 이상 센서: 양자화 없이 x_meas = x_true (선형 구간 해석/병렬 스캔용)
+//  - spdcnt 는 표시용으로 가장 가까운 카운트
+// ============================================================
+template <class Rnd = RoundVolatile>
+struct IdealSensor {
+    float int2radfac = INT2RADS;
+
+    void sample(float x_true, int& spdcnt, float& x_meas) {
+        spdcnt = (int)std::lrintf(x_true / int2radfac);
+        x_meas = x_true;
+    }
+};
+
+// ============================================================
+// 식물(예시 1차): x += Ts*(Ku*y - lam*x)
+// ============================================================
+template <class Rnd = RoundVolatile>
+struct FirstOrderPlant {
+    float Ku;
+    float lam;
+    float Ts;
+    float x;     // 실제 속도 [rad/s]
+
+    FirstOrderPlant(float Ku_, float lam_, float Ts_, float x0 = 0.0f)
+        : Ku(Ku_), lam(lam_), Ts(Ts_), x(x0) {}
+
+    float speed() const { return x; }
+
+    // 전압 y 를 dt 동안 적분 (계산 지연 분할용)
+    void integrate(float y, float dt) {
+        x = Rnd::add(x, Rnd::mul(dt, Rnd::add(Rnd::mul(Ku, y), -Rnd::mul(lam, x))));
+    }
+
+    void update(float y) { integrate(y, Ts); }
+};
+
+// ============================================================
+// 식물 + 부하 외란 d [rad/s²]: x += Ts*(Ku*y - lam*x - d)
+//  - d == 0 이면 FirstOrderPlant 와 비트 동일 (시나리오 스크립트용)
+// ============================================================
+template <class Rnd = RoundVolatile>
+struct LoadPlant : FirstOrderPlant<Rnd> {
+    using Base = FirstOrderPlant<Rnd>;
+    using Base::Base;
+    float d = 0.0f;
+
+    void integrate(float y, float dt) {
+        if (d == 0.0f) { Base::integrate(y, dt); return; }
+        this->x = Rnd::add(this->x, Rnd::mul(dt, Rnd::add(Rnd::add(Rnd::mul(this->Ku, y), -Rnd::mul(this->lam, this->x)), -d)));
+    }
+
+    void update(float y) { integrate(y, this->Ts); }
+};
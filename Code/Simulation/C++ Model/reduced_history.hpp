@@ -0,0 +1,151 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+#include "pid_model.hpp"
+
+// ============================================================
+//  축소 정밀도 이력 저장 (다축 시분할 설계의 축당 상태 메모리 절감 검토용)
+//  - 이력 w[n-1..2], x[n-1..2] 를 FP16 / bfloat16 로 저장,
+//    읽을 때 FP32 로 복원해 누산은 그대로 FP32 (DeltaPid2TapAw::kernel 을 그대로 사용)
+//  - dy[n-1], y_unsat[n-1..2] 는 적분기 자체라 FP32 고정
+//  - y_sat[n-1..2] 는 포화 상태 2비트 (SatState). y_sat 은 항상 y_unsat 또는 ±YSAT 라
+//    무손실 — e_sat 이 선형 구간에서 정확히 0 (값으로 축소 저장하면 e_sat = dec(enc(y)) - y
+//    가 선형 구간에서도 0 이 아니게 되어 AW 탭이 매 게이트 가짜 보정을 넣는다)
+//  - QuantIn = true (기본): 현재 샘플 w[n], x[n] 도 저장 형식으로 한 번 반올림해서 사용
+//    (RTL 에서 입력 래치 w_n_fp/x_n_fp 자체를 축소 저장하면 자연히 이렇게 된다)
+//    false 면 현재 샘플만 FP32 → c4·x + c5·x1 + c6·x2 에서 (Σc ≈ 0) 반올림 차이가
+//    게이트마다 같은 부호의 dy 편향이 되고, Δ-form 이 이를 적분해 정상상태 오차로 남는다
+//  - 저장 정책 (W/X 각각):
+//      HistF32  : 그대로 (두 축 모두 F32 면 DeltaPid2TapAw 와 비트 동일, pid_model.hpp)
+//      HistF16  : IEEE binary16, RNE, 범위 밖은 ±inf
+//      HistBF16 : FP32 상위 16비트, RNE
+//  - RTL 에서는 UPDATE 단계의 저장 직전에 변환기 한 개씩 (값 경로는 불변)
+// ============================================================
+
+struct HistF16 {
+    using type = uint16_t;
+    static constexpr const char* NAME = "f16";
+
+    static type enc(float f) {
+        const uint32_t u    = f32_to_hex(f);
+        const uint32_t sign = (u >> 16) & 0x8000u;
+        const uint32_t a    = u & 0x7FFFFFFFu;
+        if (a > 0x7F800000u)  return (type)(sign | 0x7E00u | ((a >> 13) & 0x3FFu));   // NaN (quiet)
+        if (a >= 0x477FF000u) return (type)(sign | 0x7C00u);                           // ≥ 65520 → inf
+        if (a < 0x38800000u) {                                                         // < 2^-14 : 비정규
+            if (a < 0x33000000u) return (type)sign;                                    // < 2^-25 → 0
+            const uint32_t e = a >> 23, m = (a & 0x7FFFFFu) | 0x800000u;
+            const uint32_t sh = 126u - e, half = 1u << (sh - 1);
+            uint32_t h = m >> sh;
+            const uint32_t rem = m & ((1u << sh) - 1u);
+            if (rem > half || (rem == half && (h & 1u))) ++h;
+            return (type)(sign | h);
+        }
+        uint32_t h = (a - 0x38000000u) >> 13;                                          // 지수 재바이어스
+        const uint32_t rem = a & 0x1FFFu;
+        if (rem > 0x1000u || (rem == 0x1000u && (h & 1u))) ++h;                        // 올림이 지수로 넘쳐도 정상
+        return (type)(sign | h);
+    }
+
+    static float dec(type h) {
+        const uint32_t sign = (uint32_t)(h & 0x8000u) << 16;
+        const uint32_t e = (h >> 10) & 0x1Fu, m = h & 0x3FFu;
+        if (e == 0x1Fu) return f32_from_hex(sign | 0x7F800000u | (m << 13));
+        if (e != 0)     return f32_from_hex(sign | ((e + 112u) << 23) | (m << 13));
+        if (m == 0)     return f32_from_hex(sign);
+        int s = 0;                                                                      // 비정규 → 정규화
+        uint32_t mm = m;
+        while (!(mm & 0x400u)) { mm <<= 1; ++s; }
+        return f32_from_hex(sign | ((uint32_t)(113 - s) << 23) | ((mm & 0x3FFu) << 13));
+    }
+};
+
+struct HistBF16 {
+    using type = uint16_t;
+    static constexpr const char* NAME = "bf16";
+
+    static type enc(float f) {
+        const uint32_t u = f32_to_hex(f);
+        if ((u & 0x7FFFFFFFu) > 0x7F800000u) return (type)((u >> 16) | 0x40u);          // NaN (quiet)
+        return (type)((u + 0x7FFFu + ((u >> 16) & 1u)) >> 16);
+    }
+    static float dec(type v) { return f32_from_hex((uint32_t)v << 16); }
+};
+
+// 포화 상태: 0 = 선형 (y_sat = y_unsat, NaN 포함), 1 = +YSAT, 2 = -YSAT
+struct SatState {
+    using type = uint8_t;
+    static type enc(float y_sat, float y_unsat) {
+        if (y_sat == y_unsat || std::isnan(y_sat)) return 0;
+        return (y_sat > 0.0f) ? 1 : 2;
+    }
+    static float dec(type s, float y_unsat, float ysat) {
+        return (s == 0) ? y_unsat : (s == 1) ? ysat : -ysat;
+    }
+};
+
+template <class Rnd = RoundVolatile, class WS = HistF32, class XS = HistF32, bool QuantIn = true>
+class DeltaPid2TapAwHist {
+public:
+    using Hist  = HistCodec<WS, XS, SatState>;
+    using WType = typename WS::type;
+    using XType = typename XS::type;
+
+    // 축 하나가 들고 있는 이력 바이트 (계수/YSAT 는 축 사이 공유라 제외, 포화 상태 2×2비트 = 1바이트)
+    static constexpr size_t STATE_BYTES = 3 * sizeof(float) + 2 * (sizeof(WType) + sizeof(XType)) + 1;
+
+    explicit DeltaPid2TapAwHist(float y_sat_limit, const DeltaCoeffs& k = COEFFS_HEX)
+        : YSAT_(y_sat_limit), k_(k) { reset(); }
+
+    void reset() { restore(DeltaPidState{}); }
+
+    float step(float w, float x) {
+        if constexpr (QuantIn) { w = WS::dec(WS::enc(w)); x = XS::dec(XS::enc(x)); }
+        // 출력(PWM 으로 가는 값)은 FP32 그대로
+        return DeltaPid2TapAw<Rnd>::template kernel<false, Hist>(k_, YSAT_, 0.0f, dy1, w1, w2, x1, x2,
+                                                                 y_unsat_1, y_unsat_2, y_sat_1, y_sat_2, w, x);
+    }
+
+    // 복원된 값 (저장 정밀도로 반올림된 이력)
+    DeltaPidState snapshot() const {
+        return { dy1, WS::dec(w1), WS::dec(w2), XS::dec(x1), XS::dec(x2), y_unsat_1, y_unsat_2,
+                 SatState::dec(y_sat_1, y_unsat_1, YSAT_), SatState::dec(y_sat_2, y_unsat_2, YSAT_) };
+    }
+
+    // y_sat 은 y_unsat 과 같은지/부호만 남는다
+    void restore(const DeltaPidState& s) {
+        dy1 = s.dy1;
+        w1 = WS::enc(s.w1);  w2 = WS::enc(s.w2);
+        x1 = XS::enc(s.x1);  x2 = XS::enc(s.x2);
+        y_unsat_1 = s.y_unsat_1;  y_unsat_2 = s.y_unsat_2;
+        y_sat_1 = SatState::enc(s.y_sat_1, s.y_unsat_1);
+        y_sat_2 = SatState::enc(s.y_sat_2, s.y_unsat_2);
+    }
+
+    bool aw_idle() const { return y_sat_1 == 0 && y_sat_2 == 0; }
+
+    const DeltaCoeffs& coeffs() const { return k_; }
+    float y_sat_limit() const { return YSAT_; }
+    void set_coeffs(const DeltaCoeffs& k) { k_ = k; }
+
+private:
+    float YSAT_;
+    DeltaCoeffs k_;
+
+    float dy1;
+    float y_unsat_1, y_unsat_2;
+    WType w1, w2;
+    XType x1, x2;
+    SatState::type y_sat_1, y_sat_2;
+};
+
+// ClosedLoop 의 ControllerPolicy (template <class Rnd>) 로 쓰기 위한 묶음
+//   ClosedLoop<EncoderFloor, HistPrecision<HistF16, HistF16>::Pid, Rnd, FirstOrderPlant>
+template <class WS, class XS, bool QuantIn = true>
+struct HistPrecision {
+    template <class Rnd>
+    using Pid = DeltaPid2TapAwHist<Rnd, WS, XS, QuantIn>;
+};
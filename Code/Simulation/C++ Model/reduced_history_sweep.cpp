@@ -0,0 +1,155 @@
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "closed_loop.hpp"
+#include "reduced_history.hpp"
+
+// ============================================================
+//  이력 저장 정밀도 (w / x 각각 f32 / f16 / bf16, y_sat 은 포화 상태 2비트) 의 폐루프 영향
+//  - 빌드: g++ -O2 -std=c++20 -fno-fast-math -ffp-contract=off reduced_history_sweep.cpp
+//  - 사용: ./a.out [gates_per_segment=2000]
+//  1) 변환기 검사: HistF16 대 _Float16 (컴파일러 지원 시), HistBF16 라운딩/왕복
+//  2) f32/f32 (+ 포화 상태) 가 DeltaClosedLoop 과 비트 동일
+//  3) 9 조합: 축당 이력 바이트, f32 기준 max|Δy|, max|Δx|, IAE 변화, 끝 구간 정상상태 오차
+//     목표값 구간: 1000 → 3000 (지속 포화, AW 동작) → 600 → -800 RPM
+//  4) 같은 표를 QuantIn=false (이력만 축소, 현재 샘플 FP32) 로 — 편향 적분 효과 비교
+// ============================================================
+
+using Rnd = RoundNative;
+
+static float setpoint(long n, long seg) {
+    static const float W[4] = { 104.71976f, 314.15927f, 62.831853f, -83.775804f };   // RPM → rad/s
+    return W[std::min<long>(n / seg, 3)];
+}
+
+// ---- 1) 변환기 ----
+static bool check_convert() {
+    std::mt19937 rng(3);
+    long bad16 = 0, badbf = 0, n = 0;
+    auto one = [&](uint32_t u) {
+        const float f = f32_from_hex(u);
+#ifdef __FLT16_MAX__
+        const _Float16 h = (_Float16)f;
+        uint16_t hb;
+        std::memcpy(&hb, &h, 2);
+        const uint16_t mine = HistF16::enc(f);
+        const bool nan = std::isnan(f);
+        if (nan ? !std::isnan(HistF16::dec(mine)) : (mine != hb)) ++bad16;
+        if (!nan && f32_to_hex(HistF16::dec(mine)) != f32_to_hex((float)h)) ++bad16;
+#endif
+        // bf16: 왕복 오차가 반 ulp 이내, 동률은 짝수
+        const float r = HistBF16::dec(HistBF16::enc(f));
+        if (std::isfinite(f) && std::isfinite(r)) {
+            const double err = std::fabs((double)r - (double)f);
+            const double ulp = std::ldexp(1.0, std::max(std::ilogb(f), -126) - 7);
+            if (err > 0.5 * ulp || (err == 0.5 * ulp && (HistBF16::enc(f) & 1u))) ++badbf;
+        }
+        ++n;
+    };
+    for (uint32_t u : { 0x00000000u, 0x80000000u, 0x7F800000u, 0xFF800000u, 0x7FC00000u, 0x477FE000u,
+                        0x477FF000u, 0x477FEFFFu, 0x38800000u, 0x387FFFFFu, 0x33000000u, 0x33000001u,
+                        0x337FFFFFu, 0x3F801000u, 0x3F803000u, 0x3F808000u, 0x3F818000u })
+        one(u);
+    for (long i = 0; i < 20'000'000; ++i) one(rng());
+    for (uint32_t u = 0x33000000u; u < 0x39000000u; u += 97) one(u);                // 비정규 경계 조밀하게
+#ifdef __FLT16_MAX__
+    std::cout << "convert: " << n << " values, f16 vs _Float16 mismatches " << bad16;
+#else
+    std::cout << "convert: " << n << " values, (_Float16 없음: f16 대조 생략)";
+#endif
+    std::cout << ", bf16 rounding errors " << badbf << ((bad16 || badbf) ? "  FAIL" : "  OK") << "\n";
+    return bad16 == 0 && badbf == 0;
+}
+
+struct Trace {
+    std::vector<float> y, x;
+};
+
+template <template <class> class Ctrl>
+static Trace run_loop(long seg, float Ts) {
+    ClosedLoop<EncoderFloor, Ctrl, Rnd, FirstOrderPlant> loop(EncoderFloor<Rnd>(Ts), Ctrl<Rnd>(YSAT),
+                                                             FirstOrderPlant<Rnd>(50.0f, 5.0f, Ts));
+    Trace t;
+    loop.run(4 * seg, [seg](long n) { return setpoint(n, seg); }, [&](long, const GateSample& s) {
+        t.y.push_back(s.y);
+        t.x.push_back(s.x_true);
+    });
+    return t;
+}
+
+static double iae(const Trace& t, long seg, float Ts) {
+    double a = 0.0;
+    for (size_t n = 0; n < t.x.size(); ++n) a += std::fabs(setpoint((long)n, seg) - t.x[n]) * Ts;
+    return a;
+}
+
+// 마지막 구간 끝 10% 의 평균 |w - x|
+static double ss_err(const Trace& t, long seg) {
+    const long n0 = 4 * seg - seg / 10;
+    double a = 0.0;
+    for (long n = n0; n < 4 * seg; ++n) a += std::fabs(setpoint(n, seg) - t.x[n]);
+    return a / (double)(4 * seg - n0);
+}
+
+template <class W, class X, bool Q>
+static void row(const Trace& base, long seg, float Ts) {
+    using P = HistPrecision<W, X, Q>;
+    const Trace t = run_loop<P::template Pid>(seg, Ts);
+    double dy = 0.0, dx = 0.0;
+    long first = -1;
+    for (size_t n = 0; n < t.y.size(); ++n) {
+        if (first < 0 && f32_to_hex(t.y[n]) != f32_to_hex(base.y[n])) first = (long)n;
+        dy = std::max(dy, (double)std::fabs(t.y[n] - base.y[n]));
+        dx = std::max(dx, (double)std::fabs(t.x[n] - base.x[n]));
+    }
+    const double i0 = iae(base, seg, Ts), i1 = iae(t, seg, Ts);
+    std::cout << std::setw(5) << W::NAME << std::setw(6) << X::NAME
+              << std::setw(7) << DeltaPid2TapAwHist<Rnd, W, X>::STATE_BYTES
+              << std::scientific << std::setprecision(2)
+              << std::setw(11) << dy << std::setw(11) << dx
+              << std::fixed << std::setprecision(3)
+              << std::setw(10) << (i1 / i0 - 1.0) * 100.0
+              << std::setw(10) << ss_err(t, seg)
+              << std::setw(9) << first << "\n";
+}
+
+template <bool Q>
+static void table(const Trace& base, long seg, float Ts) {
+    std::cout << "    w     x  bytes   max|dy|V  max|dx|r/s    IAE[%]  ss_err  1st_diff\n";
+    row<HistF32,  HistF32,  Q>(base, seg, Ts);
+    row<HistF32,  HistF16,  Q>(base, seg, Ts);
+    row<HistF32,  HistBF16, Q>(base, seg, Ts);
+    row<HistF16,  HistF32,  Q>(base, seg, Ts);
+    row<HistF16,  HistF16,  Q>(base, seg, Ts);
+    row<HistF16,  HistBF16, Q>(base, seg, Ts);
+    row<HistBF16, HistF32,  Q>(base, seg, Ts);
+    row<HistBF16, HistF16,  Q>(base, seg, Ts);
+    row<HistBF16, HistBF16, Q>(base, seg, Ts);
+}
+
+int main(int argc, char** argv) {
+    const long  seg = (argc > 1) ? std::atol(argv[1]) : 2000;
+    const float Ts  = 0.005f;
+
+    bool ok = check_convert();
+
+    const Trace base = run_loop<DeltaPid2TapAw>(seg, Ts);
+    const Trace f32  = run_loop<HistPrecision<HistF32, HistF32>::Pid>(seg, Ts);
+    long bad = 0;
+    for (size_t n = 0; n < base.y.size(); ++n) bad += f32_to_hex(base.y[n]) != f32_to_hex(f32.y[n]);
+    std::cout << "f32/f32 + saturation state vs DeltaClosedLoop: " << base.y.size() << " gates, y mismatches " << bad
+              << (bad ? "  FAIL" : "  OK") << "\n";
+    ok &= bad == 0;
+
+    std::cout << "\nsetpoint 1000 → 3000(sat) → 600 → -800 RPM, " << seg << " gates each; baseline IAE "
+              << std::fixed << std::setprecision(4) << iae(base, seg, Ts) << ", ss_err " << ss_err(base, seg) << "\n";
+    std::cout << "[QuantIn = true] 현재 샘플도 저장 형식으로 반올림\n";
+    table<true>(base, seg, Ts);
+    std::cout << "\n[QuantIn = false] 이력만 축소 (현재 샘플 FP32)\n";
+    table<false>(base, seg, Ts);
+    return ok ? 0 : 1;
+}
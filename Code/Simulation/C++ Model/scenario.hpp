@@ -0,0 +1,217 @@
+#pragma once
+
+#include <coroutine>
+#include <cmath>
+#include <exception>
+#include <utility>
+#include <vector>
+
+#include "loop_bank.hpp"
+
+// ============================================================
+//  코루틴 시나리오 스크립트 + 레인 묶음 엔진
+//  - 스크립트 = Scenario 를 돌려주는 C++20 코루틴, 레인(채널) 하나를 구동
+//        Scenario step_test(ScenarioLane& L, float w) {
+//            L.set_w(w);
+//            if (!co_await until_settled()) co_return;
+//            co_await gates(200);
+//            L.plant().d = 30.0f;              // 부하 외란
+//            co_await until_settled();
+//        }
+//  - 대기 (게이트 경계에서만 재개)
+//      co_await gates(n)              : n 게이트 진행 후 재개
+//      co_await until_settled(...)    : |w - x| ≤ band·|w| + tol 이 hold 게이트
+//                                       연속이면 true, timeout 게이트 지나면 false
+//  - 엔진은 대기 조건을 레인 상태(LaneWait)로 직접 검사 → 대기 중인 게이트의
+//    비용은 step() + 감소/비교 하나. 코루틴 재개는 조건이 풀릴 때만
+//  - 스케줄은 LoopBank 와 같은 시간 블로킹 (레인 안에서는 항상 게이트 순서)
+//  - 레인 동작은 ClosedLoop::step 호출 사이에만 일어나므로, 같은 게이트에
+//    같은 변경을 하는 손 루프와 비트 동일
+// ============================================================
+
+struct LaneWait {
+    enum Kind : uint8_t { RUN, GATES, SETTLE, DONE };
+    Kind  kind = RUN;
+    bool  settled = false;
+    int   hold = 0, held = 0;
+    long  left = 0;           // GATES: 남은 게이트, SETTLE: 남은 timeout
+    float band = 0.0f, tol = 0.0f;
+};
+
+class Scenario {
+public:
+    struct promise_type {
+        LaneWait*          wait = nullptr;
+        std::exception_ptr err;
+
+        Scenario get_return_object() { return Scenario(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { err = std::current_exception(); }
+    };
+    using Handle = std::coroutine_handle<promise_type>;
+
+    Scenario(Scenario&& o) noexcept : h_(std::exchange(o.h_, {})) {}
+    Scenario& operator=(Scenario&& o) noexcept { if (this != &o) { reset(); h_ = std::exchange(o.h_, {}); } return *this; }
+    Scenario(const Scenario&) = delete;
+    ~Scenario() { reset(); }
+
+    Handle release() { return std::exchange(h_, {}); }
+
+private:
+    explicit Scenario(Handle h) : h_(h) {}
+    void reset() { if (h_) h_.destroy(); h_ = {}; }
+    Handle h_;
+};
+
+struct GatesAwait {
+    long n;
+    bool await_ready() const noexcept { return n <= 0; }
+    void await_suspend(Scenario::Handle h) const noexcept {
+        LaneWait& w = *h.promise().wait;
+        w.kind = LaneWait::GATES;
+        w.left = n;
+    }
+    void await_resume() const noexcept {}
+};
+
+struct SettleAwait {
+    float band, tol;
+    int   hold;
+    long  timeout;
+    LaneWait* wait = nullptr;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(Scenario::Handle h) noexcept {
+        wait = h.promise().wait;
+        wait->kind    = LaneWait::SETTLE;
+        wait->band    = band;
+        wait->tol     = tol;
+        wait->hold    = std::max(1, hold);
+        wait->held    = 0;
+        wait->left    = timeout;
+        wait->settled = false;
+    }
+    bool await_resume() const noexcept { return wait->settled; }
+};
+
+static inline GatesAwait gates(long n) { return GatesAwait{ n }; }
+
+// band: 목표 대비 비율, tol: 절대 허용 (기본 1 카운트 = INT2RADS, 엔코더 바닥 양자화 흡수)
+static inline SettleAwait until_settled(float band = 0.02f, int hold = 20, long timeout = 4000,
+                                        float tol = INT2RADS) {
+    return SettleAwait{ band, tol, hold, timeout };
+}
+
+template <class Loop>
+class ScenarioBank {
+public:
+    struct Lane {
+        explicit Lane(const Loop& proto) : loop(proto) {}
+
+        Loop       loop;
+        float      w    = 0.0f;
+        long       gate = 0;            // 다음에 실행할 게이트 번호
+        float      x    = 0.0f;         // 마지막 게이트의 x_true
+        float      y    = 0.0f;         // 마지막 게이트의 y
+        LaneWait   wait;
+        Scenario::Handle h{};
+
+        void  set_w(float v) { w = v; }
+        auto& plant()        { return loop.plant(); }
+        auto& controller()   { return loop.controller(); }
+    };
+
+    explicit ScenarioBank(size_t capacity) { lanes_.reserve(capacity); }
+    ScenarioBank(const ScenarioBank&) = delete;
+    ~ScenarioBank() { for (Lane& L : lanes_) if (L.h) L.h.destroy(); }
+
+    // 레인 추가 + 스크립트 연결. script(Lane&) -> Scenario
+    // 코루틴이 Lane& 를 잡으므로 용량을 넘기면 추가하지 않고 nullptr
+    template <class F>
+    Lane* spawn(const Loop& proto, F&& script) {
+        if (lanes_.size() == lanes_.capacity()) return nullptr;
+        Lane& L = lanes_.emplace_back(proto);
+        L.h = script(L).release();
+        L.h.promise().wait = &L.wait;
+        return &L;
+    }
+
+    size_t size() const { return lanes_.size(); }
+    Lane&  operator[](size_t i) { return lanes_[i]; }
+
+    // 모든 스크립트가 끝나거나 게이트 번호 max_gates 까지 (다시 부르면 이어서)
+    // sink(lane, gate, const GateSample&). 끝난 레인은 더 이상 스텝하지 않음
+    // 반환: 끝나지 않은 레인 수
+    template <class Sink>
+    size_t run(long max_gates, Sink&& sink) {
+        const size_t N = lanes_.size();
+        size_t active = 0;
+        for (Lane& L : lanes_) {
+            if (L.wait.kind == LaneWait::RUN && L.gate == 0 && L.h && !L.h.done()) resume(L);
+            active += L.wait.kind != LaneWait::DONE;
+        }
+        const auto sch = LoopBank<Lane>::tune(N, max_gates);
+
+        long g0 = 0;
+        for (const Lane& L : lanes_) if (L.wait.kind != LaneWait::DONE) { g0 = L.gate; break; }
+        for (long t0 = g0; t0 < max_gates && active > 0; t0 += sch.tile) {
+            const long t1 = std::min(max_gates, t0 + sch.tile);
+            for (size_t b0 = 0; b0 < N; b0 += sch.block) {
+                const size_t b1 = std::min(N, b0 + sch.block);
+                for (long g = t0; g < t1; ++g) {
+                    size_t live = 0;
+                    for (size_t c = b0; c < b1; ++c) {
+                        Lane& L = lanes_[c];
+                        if (L.wait.kind == LaneWait::DONE) continue;
+                        ++live;
+                        const GateSample s = L.loop.step(L.w);
+                        L.x = s.x_true;
+                        L.y = s.y;
+                        sink(c, L.gate, s);
+                        ++L.gate;
+                        const bool go = (L.wait.kind == LaneWait::GATES) ? --L.wait.left <= 0 : settled(L);
+                        if (go) {
+                            resume(L);
+                            if (L.wait.kind == LaneWait::DONE) --active;
+                        }
+                    }
+                    if (live == 0) break;
+                }
+            }
+        }
+        return active;
+    }
+
+    size_t run(long max_gates) {
+        return run(max_gates, [](size_t, long, const GateSample&) {});
+    }
+
+private:
+    // until_settled 조건이 이번 게이트로 풀렸는가 (정착 또는 timeout)
+    static bool settled(Lane& L) {
+        LaneWait& w = L.wait;
+        const float e = std::fabs(L.w - L.x);
+        if (e <= w.band * std::fabs(L.w) + w.tol) {
+            if (++w.held >= w.hold) { w.settled = true; return true; }
+        } else {
+            w.held = 0;
+        }
+        return --w.left <= 0;
+    }
+
+    static void resume(Lane& L) {
+        L.wait.kind = LaneWait::RUN;
+        L.h.resume();
+        if (L.h.promise().err) std::rethrow_exception(L.h.promise().err);
+        if (L.h.done()) L.wait.kind = LaneWait::DONE;
+        else if (L.wait.kind == LaneWait::RUN) { L.wait.kind = LaneWait::GATES; L.wait.left = 1; }   // 다른 awaitable
+    }
+
+    std::vector<Lane> lanes_;
+};
+
+template <class Rnd = RoundNative>
+using ScenarioLoop = ClosedLoop<EncoderFloor, DeltaPid2TapAw, Rnd, LoadPlant>;
+using ScenarioLane = ScenarioBank<ScenarioLoop<RoundNative>>::Lane;
@@ -0,0 +1,125 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <vector>
+
+#include "pid_coeffs.hpp"
+#include "scenario.hpp"
+
+// ============================================================
+//  코루틴 시나리오 데모: 계단 → 정착 → 부하 외란 → 게인 전환 → 감속
+//  - 빌드: g++ -O2 -std=c++20 -fno-fast-math -ffp-contract=off scenario_demo.cpp
+//  - 사용: ./a.out [lanes]
+//  - 레인마다 목표/외란/전환 게인이 다름. 결과: 정착·회복 게이트 분포,
+//    레인·게이트당 비용
+//  - 기준: 스크립트가 기록한 이벤트 게이트를 LoopBank setpoint 콜백에서 재현
+//    (기존 방식). 레인별 Σy 비트 동일 + 게이트당 비용 비교
+// ============================================================
+
+using Loop = ScenarioLoop<RoundNative>;
+
+struct LaneResult {
+    long settle = -1, recover = -1, resettle = -1;  // 각 구간 소요 게이트 (-1: timeout)
+    long ev_load = -1, ev_gain = -1, ev_down = -1;  // 이벤트 게이트 (재현용)
+    float w = 0.0f, d = 0.0f;
+    DeltaCoeffs k2{};
+};
+
+static Scenario step_load_switch(ScenarioLane& L, LaneResult& r) {
+    L.set_w(r.w);
+    long g = L.gate;
+    if (co_await until_settled()) r.settle = L.gate - g;
+    co_await gates(100);
+
+    r.ev_load = L.gate;
+    L.plant().d = r.d;
+    g = L.gate;
+    co_await gates(1);
+    if (co_await until_settled(0.02f, 40)) r.recover = L.gate - g;
+
+    r.ev_gain = L.gate;
+    L.controller().set_coeffs(r.k2);
+    co_await gates(200);
+
+    r.ev_down = L.gate;
+    L.set_w(0.5f * r.w);
+    g = L.gate;
+    if (co_await until_settled()) r.resettle = L.gate - g;
+    co_await gates(50);
+}
+
+static Loop make_loop(size_t i) {
+    const float Ts = 0.005f;
+    return Loop(EncoderFloor<RoundNative>(Ts), DeltaPid2TapAw<RoundNative>(YSAT),
+                LoadPlant<RoundNative>(40.0f + (float)(i % 31), 4.0f + 0.05f * (float)(i % 41), Ts));
+}
+
+static long pct(std::vector<long> v, double p) {
+    v.erase(std::remove(v.begin(), v.end(), -1L), v.end());
+    if (v.empty()) return -1;
+    std::sort(v.begin(), v.end());
+    return v[(size_t)(p * (double)(v.size() - 1))];
+}
+
+int main(int argc, char** argv) {
+    const size_t N = (argc > 1) ? (size_t)std::atol(argv[1]) : 20000;
+    const long   MAX_G = 20000;
+
+    std::vector<LaneResult> res(N);
+    for (size_t i = 0; i < N; ++i) {
+        PidGains g = DEFAULT_GAINS;
+        g.Kp *= 0.6 + 0.8 * (double)(i % 17) / 16.0;
+        g.Ki *= 0.5 + 1.5 * (double)(i % 13) / 12.0;
+        res[i].w  = 40.0f + 60.0f * (float)(i % 11) / 10.0f;
+        res[i].d  = 50.0f + 10.0f * (float)(i % 7);
+        res[i].k2 = compute_coeffs(g, 0.005);
+    }
+
+    ScenarioBank<Loop> bank(N);
+    std::vector<double> ysum(N, 0.0);
+    for (size_t i = 0; i < N; ++i)
+        bank.spawn(make_loop(i), [&, i](ScenarioLane& L) { return step_load_switch(L, res[i]); });
+
+    long lane_gates = 0;
+    const auto t0 = std::chrono::steady_clock::now();
+    const size_t left = bank.run(MAX_G, [&](size_t c, long, const GateSample& s) { ysum[c] += s.y; });
+    const double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    long g_max = 0;
+    for (size_t i = 0; i < N; ++i) { lane_gates += bank[i].gate; g_max = std::max(g_max, bank[i].gate); }
+
+    // 같은 이벤트를 콜백으로 짠 기준 (LoopBank + setpoint 람다에서 게이트 비교)
+    // 레인이 끝난 뒤 게이트는 합에서 제외 → 레인마다 Σy 비트 비교
+    LoopBank<Loop> plain(N);
+    for (size_t i = 0; i < N; ++i) plain.add(make_loop(i));
+    std::vector<double> psum(N, 0.0);
+    long plain_gates = 0;
+    const auto t1 = std::chrono::steady_clock::now();
+    plain.run(g_max,
+              [&](size_t c, long g) {
+                  const LaneResult& r = res[c];
+                  if (g == r.ev_load) plain[c].plant().d = r.d;
+                  if (g == r.ev_gain) plain[c].controller().set_coeffs(r.k2);
+                  return (g >= r.ev_down) ? 0.5f * r.w : r.w;
+              },
+              [&](size_t c, long g, const GateSample& s) { if (g < bank[c].gate) psum[c] += s.y; });
+    const double sec_p = std::chrono::duration<double>(std::chrono::steady_clock::now() - t1).count();
+    plain_gates = g_max * (long)N;
+    long diff = 0;
+    for (size_t i = 0; i < N; ++i) diff += psum[i] != ysum[i];
+
+    std::vector<long> st, rc, rs;
+    for (const LaneResult& r : res) { st.push_back(r.settle); rc.push_back(r.recover); rs.push_back(r.resettle); }
+    std::cout << "lanes=" << N << "  unfinished=" << left << "  lane-gates=" << lane_gates
+              << "  (max " << g_max << ")\n" << std::fixed << std::setprecision(2)
+              << "scripted : " << 1e9 * sec / (double)lane_gates << " ns/lane-gate\n"
+              << "callback : " << 1e9 * sec_p / (double)plain_gates << " ns/lane-gate\n";
+    std::cout << "gates      p10   p50   p90\n";
+    std::cout << "settle   " << std::setw(6) << pct(st, .1) << std::setw(6) << pct(st, .5) << std::setw(6) << pct(st, .9) << "\n";
+    std::cout << "recover  " << std::setw(6) << pct(rc, .1) << std::setw(6) << pct(rc, .5) << std::setw(6) << pct(rc, .9) << "\n";
+    std::cout << "resettle " << std::setw(6) << pct(rs, .1) << std::setw(6) << pct(rs, .5) << std::setw(6) << pct(rs, .9) << "\n";
+
+    std::cout << "per-lane Σy vs callback version: " << (diff ? "DIFF " : "bit-identical ") << diff << "\n";
+    return diff ? 1 : 0;
+}
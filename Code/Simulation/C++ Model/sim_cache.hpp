@@ -0,0 +1,331 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "loop_metrics.hpp"
+#include "sweep_log.hpp"   // crc32_ieee
+
+// ============================================================
+//  내용 주소(content-addressed) 시뮬레이션 결과 캐시
+//  - 키 = 구성 전체의 128비트 해시 (FNV-1a 두 갈래). float 는 비트 패턴으로
+//    넣으므로 C0..C7B 가 1ulp 만 달라도 다른 키
+//  - 저장 = 키 상위 4비트로 나눈 append-only 로그 16개 <dir>/shard-<x>.log
+//    (지표만이면 항목 하나 72 B. 파일 하나씩이면 4 KB 블록을 통째로 써서 6480 점 스윕이
+//     27 MB 였음 → 0.5 MB)
+//      레코드 : magic u32 | len u32 | key u64[2] | metrics f32[7] | n u64 | comp_len u64
+//               | comp[] | crc u32 (magic~comp)
+//      트레이스 압축: 이전 값과 비트 XOR → LEB128 varint (같은 값이면 1바이트)
+//  - 쓰기는 O_APPEND write() 한 번에 레코드 하나 (sweep_log 와 같음) → 여러 프로세스가
+//    같은 디렉터리 공유 가능. 색인에 없는 키는 로그 꼬리를 다시 읽어 확인
+//  - 같은 키가 여러 번 있으면 마지막 것. 읽을 때 key/crc 를 다시 확인하고, 손상
+//    구간은 다음 magic 까지 건너뜀 (그 항목만 miss)
+//  - LRU: 적중 순서 (이 프로세스) + 파일 순서. 로그 합계가 상한을 넘으면 최근 것부터
+//    90% 까지 남겨 샤드를 새로 쓰고 rename (그 사이 다른 프로세스가 붙인 항목은 잃음)
+// ============================================================
+
+class CacheKey {
+public:
+    CacheKey& str(const char* s)  { mix(s, std::strlen(s)); return u8(0); }
+    CacheKey& u8(uint8_t v)       { mix(&v, 1); return *this; }
+    CacheKey& u64(uint64_t v)     { mix(&v, 8); return *this; }
+    CacheKey& f32(float v)        { const uint32_t u = f32_to_hex(v); mix(&u, 4); return *this; }
+    CacheKey& f64(double v)       { mix(&v, 8); return *this; }
+    // 필드별로 명시 (구조체 배치/패딩과 무관, 순서는 기존 키와 같음)
+    CacheKey& coeffs(const DeltaCoeffs& k) {
+        return f32(k.c0).f32(k.c1).f32(k.c2).f32(k.c3).f32(k.c4).f32(k.c5).f32(k.c6).f32(k.c7a).f32(k.c7b);
+    }
+
+    std::string hex() const {
+        char b[33];
+        std::snprintf(b, sizeof(b), "%016llx%016llx", (unsigned long long)h0_, (unsigned long long)h1_);
+        return b;
+    }
+
+private:
+    void mix(const void* d, size_t n) {
+        const uint8_t* p = (const uint8_t*)d;
+        for (size_t i = 0; i < n; ++i) {
+            h0_ = (h0_ ^ p[i]) * 1099511628211ull;
+            h1_ = (h1_ ^ p[i]) * 0x100000001B3ull + 0x9E3779B97F4A7C15ull;
+        }
+    }
+
+    friend class SimCache;
+
+    uint64_t h0_ = 1469598103934665603ull;
+    uint64_t h1_ = 0x6A09E667F3BCC908ull;
+};
+
+class SimCache {
+public:
+    static constexpr uint32_t REC_MAGIC = 0x31435350;   // "PSC1" (레코드 형식이 바뀌면 올림)
+    static constexpr int      SHARDS    = 16;
+
+    SimCache(const std::string& dir, uint64_t max_bytes) : dir_(dir), cap_(max_bytes) {
+        ::mkdir(dir_.c_str(), 0755);
+        for (int i = 0; i < SHARDS; ++i) {
+            char name[16];
+            std::snprintf(name, sizeof(name), "/shard-%x.log", i);
+            shards_[i].path = dir_ + name;
+            reopen(shards_[i]);
+        }
+    }
+    SimCache(const SimCache&) = delete;
+    SimCache& operator=(const SimCache&) = delete;
+    ~SimCache() { for (Shard& s : shards_) if (s.fd >= 0) ::close(s.fd); }
+
+    // 적중이면 true. trace 가 주어지면 저장된 트레이스도 복원 (없으면 miss 처리)
+    bool get(const CacheKey& key, StepMetrics& m, std::vector<float>* trace = nullptr) {
+        const Key k{ key.h0_, key.h1_ };
+        Shard& s = shard_of(k);
+        auto it = s.index.find(k);
+        if (it == s.index.end()) {
+            catch_up(s);                               // 다른 프로세스가 붙인 레코드
+            it = s.index.find(k);
+        }
+        std::vector<uint8_t> rec;
+        if (it == s.index.end() || !read_rec(s, it->second, rec) || !decode(rec, k, m, trace)) {
+            ++misses_;
+            return false;
+        }
+        it->second.stamp = ++clock_;
+        ++hits_;
+        return true;
+    }
+
+    void put(const CacheKey& key, const StepMetrics& m, const std::vector<float>* trace = nullptr) {
+        const Key k{ key.h0_, key.h1_ };
+        Shard& s = shard_of(k);
+        std::vector<uint8_t> rec;
+        encode(k, m, trace, rec);
+        catch_up(s);
+        if (s.fd < 0 || ::write(s.fd, rec.data(), rec.size()) != (ssize_t)rec.size()) return;
+        catch_up(s);                                   // 방금 쓴 레코드까지 색인
+        if (total_ > cap_) evict();
+    }
+
+    // 있으면 읽고, 없으면 compute() 후 저장
+    template <class F>
+    StepMetrics get_or_compute(const CacheKey& key, F&& compute) {
+        StepMetrics m;
+        if (get(key, m)) return m;
+        m = compute();
+        put(key, m);
+        return m;
+    }
+
+    uint64_t hits()    const { return hits_; }
+    uint64_t misses()  const { return misses_; }
+    uint64_t bytes()   const { return total_; }                 // 로그 합계 (덮어쓴 레코드 포함)
+    uint64_t corrupt() const { return corrupt_; }               // 건너뛴 손상 구간 수
+    size_t   entries() const {
+        size_t n = 0;
+        for (const Shard& s : shards_) n += s.index.size();
+        return n;
+    }
+
+private:
+    using Key = std::pair<uint64_t, uint64_t>;
+    struct Loc { uint64_t off; uint32_t len; uint64_t stamp; };  // stamp: 작을수록 오래됨
+    struct Shard {
+        std::string         path;
+        int                 fd  = -1;
+        uint64_t            end = 0;                              // 여기까지 읽어 색인함
+        std::map<Key, Loc>  index;
+    };
+
+    static constexpr size_t   HEAD    = 8 + 16 + 4 * StepMetrics::N_FIELDS + 16;
+    static constexpr uint32_t MAX_REC = 1u << 28;
+
+    Shard& shard_of(const Key& k) { return shards_[k.first >> 60]; }
+
+    // 처음부터 다시 (다른 프로세스가 압축해 파일이 바뀐 경우 포함)
+    void reopen(Shard& s) {
+        if (s.fd >= 0) ::close(s.fd);
+        total_ -= s.end;
+        s.fd  = ::open(s.path.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+        s.end = 0;
+        s.index.clear();
+        scan(s);
+    }
+
+    void catch_up(Shard& s) {
+        struct stat a, b;
+        if (s.fd < 0 || ::stat(s.path.c_str(), &a) != 0 || ::fstat(s.fd, &b) != 0 || a.st_ino != b.st_ino) {
+            reopen(s);
+            return;
+        }
+        if ((uint64_t)b.st_size > s.end) scan(s);
+    }
+
+    // s.end 부터 파일 끝까지 색인. 끝에 덜 쓰인 레코드는 다음에 다시
+    void scan(Shard& s) {
+        if (s.fd < 0) return;
+        struct stat st;
+        if (::fstat(s.fd, &st) != 0 || (uint64_t)st.st_size <= s.end) return;
+        std::vector<uint8_t> buf((size_t)st.st_size - s.end);
+        if (::pread(s.fd, buf.data(), buf.size(), (off_t)s.end) != (ssize_t)buf.size()) return;
+
+        size_t off = 0;
+        bool   skipping = false;
+        while (off + HEAD + 4 <= buf.size()) {
+            const uint32_t len = rec_len(buf, off);
+            if (len && off + len > buf.size()) {
+                // 덜 쓰인 꼬리면 다음에 다시. 뒤에 온전한 레코드가 있으면 중간에 끊긴 것
+                size_t next = off + 1;
+                while (next + HEAD + 4 <= buf.size() && !rec_ok(buf, next)) ++next;
+                if (next + HEAD + 4 > buf.size()) break;
+            }
+            if (!rec_ok(buf, off)) {
+                if (!skipping) ++corrupt_;
+                skipping = true;
+                ++off;                                             // 다음 magic 찾기
+                continue;
+            }
+            skipping = false;
+            Key k;
+            std::memcpy(&k.first, &buf[off + 8], 8);
+            std::memcpy(&k.second, &buf[off + 16], 8);
+            s.index[k] = Loc{ s.end + off, len, ++clock_ };
+            off += len;
+        }
+        s.end  += off;
+        total_ += off;
+    }
+
+    // 머리가 그럴듯하면 길이, 아니면 0
+    static uint32_t rec_len(const std::vector<uint8_t>& b, size_t off) {
+        uint32_t magic, len;
+        std::memcpy(&magic, &b[off], 4);
+        std::memcpy(&len, &b[off + 4], 4);
+        return magic == REC_MAGIC && len >= HEAD + 4 && len <= MAX_REC ? len : 0;
+    }
+
+    static bool rec_ok(const std::vector<uint8_t>& b, size_t off) {
+        const uint32_t len = rec_len(b, off);
+        if (!len || off + len > b.size()) return false;
+        uint32_t crc;
+        std::memcpy(&crc, &b[off + len - 4], 4);
+        return crc == crc32_ieee(&b[off], len - 4);
+    }
+
+    bool read_rec(const Shard& s, const Loc& l, std::vector<uint8_t>& rec) const {
+        rec.resize(l.len);
+        return ::pread(s.fd, rec.data(), l.len, (off_t)l.off) == (ssize_t)l.len;
+    }
+
+    // 최근 사용 순으로 상한의 90% 까지 남기고 샤드를 새로 씀 (임시 파일 + rename)
+    void evict() {
+        std::vector<std::pair<uint64_t, std::pair<int, Key>>> order;
+        for (int i = 0; i < SHARDS; ++i)
+            for (const auto& kv : shards_[i].index) order.push_back({ kv.second.stamp, { i, kv.first } });
+        std::sort(order.begin(), order.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+
+        const uint64_t target = cap_ - cap_ / 10;
+        std::vector<std::vector<std::pair<uint64_t, Key>>> keep(SHARDS);
+        uint64_t kept = 0;
+        for (const auto& o : order) {
+            const uint32_t len = shards_[o.second.first].index[o.second.second].len;
+            if (kept + len > target) { ++evicted_; continue; }
+            kept += len;
+            keep[o.second.first].push_back({ o.first, o.second.second });
+        }
+
+        for (int i = 0; i < SHARDS; ++i) {
+            Shard& s = shards_[i];
+            std::vector<std::pair<uint64_t, Key>>& ks = keep[i];
+            std::sort(ks.begin(), ks.end());                    // 오래된 것 먼저 (파일 순서 = 나이)
+            const std::string tmp = s.path + ".tmp." + std::to_string(::getpid());
+            const int fd = ::open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (fd < 0) continue;
+            bool ok = true;
+            std::vector<uint8_t> rec;
+            for (const auto& e : ks)
+                ok = ok && read_rec(s, s.index[e.second], rec) && ::write(fd, rec.data(), rec.size()) == (ssize_t)rec.size();
+            ::close(fd);
+            if (!ok || std::rename(tmp.c_str(), s.path.c_str()) != 0) { std::remove(tmp.c_str()); continue; }
+            reopen(s);
+            for (const auto& e : ks) {                          // 사용 순서 유지
+                auto it = s.index.find(e.second);
+                if (it != s.index.end()) it->second.stamp = e.first;
+            }
+        }
+    }
+
+    static void encode(const Key& k, const StepMetrics& m, const std::vector<float>* trace, std::vector<uint8_t>& b) {
+        auto put = [&](const void* p, size_t n) { b.insert(b.end(), (const uint8_t*)p, (const uint8_t*)p + n); };
+        std::vector<uint8_t> comp;
+        const uint64_t n = trace ? trace->size() : 0;
+        uint32_t prev = 0;
+        for (uint64_t i = 0; i < n; ++i) {
+            const uint32_t u = f32_to_hex((*trace)[i]);
+            uint32_t x = u ^ prev;
+            prev = u;
+            do { uint8_t byte = x & 0x7F; x >>= 7; comp.push_back(byte | (x ? 0x80 : 0)); } while (x);
+        }
+        const uint64_t clen = comp.size();
+        const uint32_t len  = (uint32_t)(HEAD + clen + 4);
+
+        put(&REC_MAGIC, 4);  put(&len, 4);
+        put(&k.first, 8);    put(&k.second, 8);
+        put(m.data(), 4 * StepMetrics::N_FIELDS);
+        put(&n, 8);  put(&clen, 8);
+        put(comp.data(), comp.size());
+        const uint32_t crc = crc32_ieee(b.data(), b.size());
+        put(&crc, 4);
+    }
+
+    static bool decode(const std::vector<uint8_t>& b, const Key& k, StepMetrics& m, std::vector<float>* trace) {
+        if (b.size() < HEAD + 4) return false;
+        uint32_t magic, len, crc;
+        Key      key;
+        std::memcpy(&magic, &b[0], 4);
+        std::memcpy(&len, &b[4], 4);
+        std::memcpy(&key.first, &b[8], 8);
+        std::memcpy(&key.second, &b[16], 8);
+        std::memcpy(&crc, &b[b.size() - 4], 4);
+        if (magic != REC_MAGIC || len != b.size() || key != k || crc != crc32_ieee(b.data(), b.size() - 4))
+            return false;
+        std::memcpy(m.data(), &b[24], 4 * StepMetrics::N_FIELDS);
+        uint64_t n, clen;
+        std::memcpy(&n, &b[24 + 4 * StepMetrics::N_FIELDS], 8);
+        std::memcpy(&clen, &b[32 + 4 * StepMetrics::N_FIELDS], 8);
+        if (HEAD + clen + 4 != b.size()) return false;
+        if (!trace) return true;
+        if (n == 0) return false;                  // 지표만 저장된 항목
+
+        trace->resize(n);
+        const uint8_t* p = &b[HEAD];
+        const uint8_t* e = p + clen;
+        uint32_t prev = 0;
+        for (uint64_t i = 0; i < n; ++i) {
+            uint32_t x = 0;
+            for (int sh = 0; ; sh += 7) {
+                if (p == e || sh > 28) return false;
+                const uint8_t byte = *p++;
+                x |= (uint32_t)(byte & 0x7F) << sh;
+                if (!(byte & 0x80)) break;
+            }
+            prev ^= x;
+            (*trace)[i] = f32_from_hex(prev);
+        }
+        return p == e;
+    }
+
+    std::string dir_;
+    uint64_t    cap_;
+    Shard       shards_[SHARDS];
+    uint64_t    total_ = 0, clock_ = 0;
+    uint64_t    hits_ = 0, misses_ = 0, evicted_ = 0, corrupt_ = 0;
+};
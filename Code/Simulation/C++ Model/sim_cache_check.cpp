@@ -0,0 +1,284 @@
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "sim_cache.hpp"
+
+// ============================================================
+//  SimCache (샤드 append 로그) 검사
+//  - 빌드: g++ -O2 -std=c++20 -fno-fast-math -ffp-contract=off sim_cache_check.cpp
+//  - 사용: ./a.out [entries=6480]
+//  1) hit / miss, 지표만 저장된 항목에 트레이스 요청 → miss, 트레이스 비트 왕복 (NaN, -0 포함)
+//  2) 키 충돌: 계수 1ulp 차이, 문자열 경계 ("ab"+"c" vs "a"+"bc"), 같은 샤드에 많은 키,
+//     같은 키 다시 쓰기 → 마지막 값
+//  3) 다시 열기 / 두 인스턴스 (한쪽이 붙인 레코드를 다른 쪽이 읽음)
+//  4) 손상: 레코드 한 바이트 뒤집기 → 그 항목만 miss, 끊긴 꼬리 뒤에 붙인 레코드도 읽힘
+//  5) 상한: 로그 합계 <= 상한, 최근 적중한 항목은 남음
+//  6) 지표만 entries 개 → 디스크 사용량
+// ============================================================
+
+static std::string make_dir() {
+    char tmpl[] = "/tmp/sim_cache_check.XXXXXX";
+    const char* d = ::mkdtemp(tmpl);
+    if (!d) { std::perror("mkdtemp"); std::exit(2); }
+    return d;
+}
+
+static void remove_dir(const std::string& dir) {
+    if (DIR* d = ::opendir(dir.c_str())) {
+        while (dirent* e = ::readdir(d))
+            if (e->d_name[0] != '.') std::remove((dir + "/" + e->d_name).c_str());
+        ::closedir(d);
+    }
+    ::rmdir(dir.c_str());
+}
+
+static uint64_t dir_bytes(const std::string& dir, int* files = nullptr) {
+    uint64_t b = 0;
+    int      n = 0;
+    if (DIR* d = ::opendir(dir.c_str())) {
+        while (dirent* e = ::readdir(d)) {
+            struct stat st;
+            if (e->d_name[0] == '.' || ::stat((dir + "/" + e->d_name).c_str(), &st) != 0) continue;
+            b += (uint64_t)st.st_blocks * 512;
+            ++n;
+        }
+        ::closedir(d);
+    }
+    if (files) *files = n;
+    return b;
+}
+
+static StepMetrics metrics_of(uint64_t i) {
+    StepMetrics m;
+    for (int f = 0; f < StepMetrics::N_FIELDS; ++f) m.data()[f] = (float)(i * 7 + f) * 0.25f;
+    return m;
+}
+
+static bool same(const StepMetrics& a, const StepMetrics& b) {
+    return std::memcmp(a.data(), b.data(), 4 * StepMetrics::N_FIELDS) == 0;
+}
+
+static CacheKey key_of(uint64_t i) { return CacheKey().str("check").u64(i); }
+
+// 키가 들어간 샤드 파일 (hex() 첫 글자 = h0 상위 4비트)
+static std::string shard_path(const std::string& dir, const CacheKey& k) {
+    return dir + "/shard-" + k.hex().substr(0, 1) + ".log";
+}
+
+static void report(const char* name, int bad) {
+    std::cout << std::left << std::setw(44) << name << (bad ? "  FAIL" : "  OK") << "\n";
+}
+
+static int check_hit_miss() {
+    const std::string dir = make_dir();
+    int bad = 0;
+    {
+        SimCache c(dir, 1ull << 30);
+        StepMetrics m;
+        bad += c.get(key_of(1), m);                                    // 빈 캐시
+        c.put(key_of(1), metrics_of(1));
+        bad += !c.get(key_of(1), m) || !same(m, metrics_of(1));
+        bad += c.get(key_of(2), m);
+
+        std::vector<float> t;
+        bad += c.get(key_of(1), m, &t);                                // 지표만 → 트레이스 miss
+
+        std::vector<float> tr(3000);
+        for (size_t i = 0; i < tr.size(); ++i) tr[i] = i < 1000 ? 100.0f : std::sin((float)i * 0.01f);
+        tr[5]  = -0.0f;
+        tr[6]  = std::nanf("");
+        tr[7]  = INFINITY;
+        c.put(key_of(3), metrics_of(3), &tr);
+        bad += !c.get(key_of(3), m, &t) || !same(m, metrics_of(3)) || t.size() != tr.size()
+            || std::memcmp(t.data(), tr.data(), 4 * tr.size()) != 0;
+        bad += !c.get(key_of(3), m) || !same(m, metrics_of(3));        // 트레이스 항목의 지표만
+
+        bad += c.hits() != 3 || c.misses() != 3 || c.entries() != 2;
+    }
+    remove_dir(dir);
+    return bad;
+}
+
+static int check_collision() {
+    const std::string dir = make_dir();
+    int bad = 0;
+    {
+        SimCache c(dir, 1ull << 30);
+        StepMetrics m;
+
+        DeltaCoeffs k0 = COEFFS_HEX, k1 = COEFFS_HEX;
+        k1.c7b = std::nextafter(k1.c7b, INFINITY);
+        const CacheKey a = CacheKey().str("step").coeffs(k0), b = CacheKey().str("step").coeffs(k1);
+        bad += a.hex() == b.hex();
+        c.put(a, metrics_of(10));
+        bad += c.get(b, m);
+        c.put(b, metrics_of(11));
+        bad += !c.get(a, m) || !same(m, metrics_of(10));
+        bad += !c.get(b, m) || !same(m, metrics_of(11));
+
+        bad += CacheKey().str("ab").str("c").hex() == CacheKey().str("a").str("bc").hex();
+        bad += CacheKey().f32(0.0f).hex() == CacheKey().f32(-0.0f).hex();
+
+        // 같은 샤드에 몰린 키 여럿
+        const std::string s0 = key_of(0).hex().substr(0, 1);
+        std::vector<uint64_t> ids;
+        std::set<std::string> seen;
+        for (uint64_t i = 0; ids.size() < 500; ++i)
+            if (key_of(i).hex().substr(0, 1) == s0) {
+                ids.push_back(i);
+                seen.insert(key_of(i).hex());
+            }
+        bad += seen.size() != ids.size();
+        for (uint64_t i : ids) c.put(key_of(i), metrics_of(i));
+        for (uint64_t i : ids) bad += !c.get(key_of(i), m) || !same(m, metrics_of(i));
+
+        c.put(key_of(ids[7]), metrics_of(999));                       // 다시 쓰기 → 마지막 값
+        bad += !c.get(key_of(ids[7]), m) || !same(m, metrics_of(999));
+        SimCache r(dir, 1ull << 30);
+        bad += !r.get(key_of(ids[7]), m) || !same(m, metrics_of(999));
+        bad += r.entries() != c.entries();
+    }
+    remove_dir(dir);
+    return bad;
+}
+
+static int check_reopen() {
+    const std::string dir = make_dir();
+    int bad = 0;
+    {
+        StepMetrics m;
+        {
+            SimCache c(dir, 1ull << 30);
+            for (uint64_t i = 0; i < 200; ++i) c.put(key_of(i), metrics_of(i));
+        }
+        SimCache a(dir, 1ull << 30), b(dir, 1ull << 30);
+        bad += a.entries() != 200;
+        for (uint64_t i = 0; i < 200; ++i) bad += !a.get(key_of(i), m) || !same(m, metrics_of(i));
+
+        for (uint64_t i = 200; i < 300; ++i) a.put(key_of(i), metrics_of(i));
+        for (uint64_t i = 200; i < 300; ++i) bad += !b.get(key_of(i), m) || !same(m, metrics_of(i));
+        bad += b.misses() != 0;
+    }
+    remove_dir(dir);
+    return bad;
+}
+
+static int check_corrupt() {
+    const std::string dir = make_dir();
+    int bad = 0;
+    {
+        StepMetrics m;
+        const std::string path = shard_path(dir, key_of(0));
+        std::vector<uint64_t> ids;
+        for (uint64_t i = 0; ids.size() < 3; ++i)
+            if (shard_path(dir, key_of(i)) == path) ids.push_back(i);
+        {
+            SimCache c(dir, 1ull << 30);
+            for (uint64_t i : ids) c.put(key_of(i), metrics_of(i));
+        }
+
+        // 가운데 레코드의 지표 한 바이트 뒤집기
+        const int fd = ::open(path.c_str(), O_RDWR);
+        struct stat st;
+        ::fstat(fd, &st);
+        const off_t rec = st.st_size / 3, at = rec + 30;
+        uint8_t byte = 0;
+        bad += ::pread(fd, &byte, 1, at) != 1;
+        byte ^= 0x10;
+        bad += ::pwrite(fd, &byte, 1, at) != 1;
+        ::close(fd);
+        {
+            SimCache c(dir, 1ull << 30);
+            bad += c.corrupt() != 1 || c.entries() != 2;
+            bad += !c.get(key_of(ids[0]), m) || !same(m, metrics_of(ids[0]));
+            bad += c.get(key_of(ids[1]), m);
+            bad += !c.get(key_of(ids[2]), m) || !same(m, metrics_of(ids[2]));
+            c.put(key_of(ids[1]), metrics_of(ids[1]));                 // 다시 계산해 붙이면 적중
+            bad += !c.get(key_of(ids[1]), m) || !same(m, metrics_of(ids[1]));
+        }
+
+        // 끊긴 꼬리 (프로세스가 쓰다 죽음) 뒤에 붙인 레코드
+        const int afd = ::open(path.c_str(), O_RDWR | O_APPEND);
+        std::vector<uint8_t> half(rec / 2);
+        bad += ::pread(afd, half.data(), half.size(), 0) != (ssize_t)half.size();
+        bad += ::write(afd, half.data(), half.size()) != (ssize_t)half.size();
+        ::close(afd);
+        {
+            SimCache c(dir, 1ull << 30);
+            c.put(key_of(ids[0]), metrics_of(5));
+            bad += !c.get(key_of(ids[0]), m) || !same(m, metrics_of(5));
+        }
+        SimCache c(dir, 1ull << 30);
+        bad += !c.get(key_of(ids[0]), m) || !same(m, metrics_of(5));
+        bad += !c.get(key_of(ids[2]), m) || !same(m, metrics_of(ids[2]));
+    }
+    remove_dir(dir);
+    return bad;
+}
+
+static int check_evict() {
+    const std::string dir = make_dir();
+    int bad = 0;
+    {
+        const uint64_t cap = 64 << 10;
+        SimCache c(dir, cap);
+        StepMetrics m;
+        c.put(key_of(0), metrics_of(0));
+        for (uint64_t i = 1; i < 3000; ++i) {
+            c.put(key_of(i), metrics_of(i));
+            if (i % 100 == 0) bad += !c.get(key_of(0), m);            // 계속 쓰는 항목
+            bad += c.bytes() > cap;
+        }
+        bad += !c.get(key_of(0), m) || !same(m, metrics_of(0));
+        bad += !c.get(key_of(2999), m) || c.get(key_of(1), m);
+        bad += c.entries() >= 3000;
+        SimCache r(dir, cap);
+        bad += r.entries() != c.entries() || r.bytes() != c.bytes();
+    }
+    remove_dir(dir);
+    return bad;
+}
+
+static int check_size(uint64_t n) {
+    const std::string dir = make_dir();
+    int bad = 0;
+    {
+        SimCache c(dir, 1ull << 30);
+        for (uint64_t i = 0; i < n; ++i) c.put(key_of(i), metrics_of(i));
+        int files = 0;
+        const uint64_t disk = dir_bytes(dir, &files);
+        std::cout << "  " << n << " entries: log " << c.bytes() << " B (" << std::fixed << std::setprecision(1)
+                  << (double)c.bytes() / n << " B/entry), disk " << disk / 1024 << " KB in " << files << " files\n";
+        bad += c.entries() != n || disk > n * 256 + SimCache::SHARDS * 4096;
+    }
+    remove_dir(dir);
+    return bad;
+}
+
+int main(int argc, char** argv) {
+    const uint64_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 6480;
+    int fails = 0, b;
+
+    report("hit / miss / trace round trip", b = check_hit_miss());      fails += b != 0;
+    report("key collision (1ulp, str boundary, shard)", b = check_collision()); fails += b != 0;
+    report("reopen / second instance", b = check_reopen());             fails += b != 0;
+    report("corrupt record / torn tail", b = check_corrupt());          fails += b != 0;
+    report("eviction under cap", b = check_evict());                     fails += b != 0;
+    b = check_size(n);
+    report("disk usage", b);                                             fails += b != 0;
+
+    std::cout << (fails ? "FAIL" : "OK") << "\n";
+    return fails ? 1 : 0;
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+// ============================================================
+//  유계 lock-free SPSC 링 (생산자 1 / 소비자 1)
+//  - 용량 2^k, head/tail 은 서로 다른 캐시 라인
+//  - 상대편 인덱스는 지역 캐시에 두고 부족할 때만 다시 읽음
+//    (배치당 원자적 load/store 한 번 → 라인 왕복 최소화)
+//  - push_n/pop_n : 가능한 만큼 옮기고 개수 반환 (0 = 가득/비어 있음)
+//  - push/pop     : 블로킹. 잠깐 스핀 후 yield (코어가 모자라도 진행)
+// ============================================================
+
+template <class T>
+class SpscQueue {
+public:
+    explicit SpscQueue(size_t capacity) {
+        size_t c = 2;
+        while (c < capacity) c <<= 1;
+        buf_.resize(c);
+        mask_ = c - 1;
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    size_t capacity() const { return mask_ + 1; }
+
+    // 생산자 전용
+    size_t push_n(const T* v, size_t n) {
+        const size_t t = tail_.load(std::memory_order_relaxed);
+        if (t + n - head_cache_ > capacity()) {
+            head_cache_ = head_.load(std::memory_order_acquire);
+            n = std::min(n, capacity() - (t - head_cache_));
+        }
+        for (size_t i = 0; i < n; ++i) buf_[(t + i) & mask_] = v[i];
+        if (n) tail_.store(t + n, std::memory_order_release);
+        return n;
+    }
+
+    // 소비자 전용
+    size_t pop_n(T* v, size_t max) {
+        const size_t h = head_.load(std::memory_order_relaxed);
+        if (tail_cache_ - h < max) {
+            tail_cache_ = tail_.load(std::memory_order_acquire);
+            max = std::min(max, tail_cache_ - h);
+        }
+        for (size_t i = 0; i < max; ++i) v[i] = buf_[(h + i) & mask_];
+        if (max) head_.store(h + max, std::memory_order_release);
+        return max;
+    }
+
+    void push(const T& v) {
+        for (int spin = 0; !push_n(&v, 1); ++spin) backoff(spin);
+    }
+
+    // 최소 1개를 받을 때까지 대기, 받은 개수 반환
+    size_t pop_wait(T* v, size_t max) {
+        size_t n;
+        for (int spin = 0; !(n = pop_n(v, max)); ++spin) backoff(spin);
+        return n;
+    }
+
+    T pop() {
+        T v;
+        pop_wait(&v, 1);
+        return v;
+    }
+
+    // spin 회차에 따른 대기: 처음엔 pause, 이후 yield
+    static void backoff(int spin) {
+        if (spin < 64) {
+#if defined(__x86_64__) || defined(__i386__)
+            __builtin_ia32_pause();
+#endif
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+private:
+    static constexpr size_t LINE = 64;
+
+    alignas(LINE) std::atomic<size_t> head_{ 0 };
+    size_t                            tail_cache_ = 0;   // 소비자 쪽
+    alignas(LINE) std::atomic<size_t> tail_{ 0 };
+    size_t                            head_cache_ = 0;   // 생산자 쪽
+    alignas(LINE) std::vector<T>      buf_;
+    size_t                            mask_ = 0;
+};
@@ -0,0 +1,127 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "pid_model.hpp"
+
+// ============================================================
+//  DeltaPid2TapAw::step_n 대 step() 반복 — 개루프 재생 벤치
+//  - 빌드: g++ -O2 -std=c++20 -fno-fast-math -ffp-contract=off step_n_bench.cpp
+//  - 사용: ./a.out [samples=1e8] [chunk=1048576]
+//  - 입력: 목표값 계단(0 / 100 / -150 / 300 rad/s, 포화 구간 포함) +
+//          spdcnt 양자화 x. chunk 길이 입력을 만들어 두고 samples 까지 반복 재생
+//          (상태는 chunk 경계를 넘어 이어짐)
+//  - 청크마다 y 가 비트 동일해야 하고, 끝 snapshot() 도 같아야 함
+//  - 가변 w / 고정 w(W_TGT) 두 오버로드, RoundNative / RoundVolatile 각각
+//  - 두 경로 모두 제어기를 참조로 받는 noinline 재생 함수 안에서 돈다 (실제 호출부 모양)
+// ============================================================
+
+using Clock = std::chrono::steady_clock;
+
+struct Stream {
+    std::vector<float> w, x;
+};
+
+static Stream make_stream(size_t n) {
+    static const float LEVELS[4] = { 0.0f, 100.0f, -150.0f, 300.0f };
+    Stream s;
+    s.w.resize(n);
+    s.x.resize(n);
+    uint32_t lcg = 12345u;
+    float v = 0.0f;                                          // 대충의 1차 응답 (x 생성용)
+    for (size_t i = 0; i < n; ++i) {
+        s.w[i] = LEVELS[(i / 2000) % 4];
+        v += 0.02f * (s.w[i] - v);
+        lcg = lcg * 1664525u + 1013904223u;
+        const int spdcnt = (int)(v / INT2RADS) + (int)(lcg >> 30) - 2;
+        s.x[i] = RoundVolatile::mul((float)spdcnt, INT2RADS);
+    }
+    return s;
+}
+
+static bool same_state(const DeltaPidState& a, const DeltaPidState& b) {
+    return std::memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+// 기존 재생 루프 모양: 제어기를 참조로 받아 y 배열에 쓴다 (호출부에서 보이는 그대로)
+template <class Rnd>
+[[gnu::noinline]] static void replay_step(DeltaPid2TapAw<Rnd>& c, const float* w, const float* x, float* y, size_t n) {
+    for (size_t i = 0; i < n; ++i) y[i] = c.step(w[i], x[i]);
+}
+
+template <class Rnd>
+[[gnu::noinline]] static void replay_step(DeltaPid2TapAw<Rnd>& c, float w, const float* x, float* y, size_t n) {
+    for (size_t i = 0; i < n; ++i) y[i] = c.step(w, x[i]);
+}
+
+template <class Rnd>
+[[gnu::noinline]] static void replay_step_n(DeltaPid2TapAw<Rnd>& c, const float* w, const float* x, float* y, size_t n) {
+    c.step_n(std::span(w, n), std::span(x, n), std::span(y, n));
+}
+
+template <class Rnd>
+[[gnu::noinline]] static void replay_step_n(DeltaPid2TapAw<Rnd>& c, float w, const float* x, float* y, size_t n) {
+    c.step_n(w, std::span(x, n), std::span(y, n));
+}
+
+// const_w 이면 W_TGT 고정 오버로드
+template <class Rnd>
+static bool run(const char* name, const Stream& in, long samples, bool const_w) {
+    DeltaPid2TapAw<Rnd> a(YSAT), b(YSAT);
+    const size_t chunk = in.x.size();
+    std::vector<float> ya(chunk), yb(chunk);
+    double ta = 0.0, tb = 0.0;
+    long bad = 0, sat = 0;
+
+    for (long done = 0; done < samples; ) {
+        const size_t n = (size_t)std::min<long>((long)chunk, samples - done);
+
+        auto t0 = Clock::now();
+        if (const_w) replay_step(a, W_TGT, in.x.data(), ya.data(), n);
+        else         replay_step(a, in.w.data(), in.x.data(), ya.data(), n);
+        auto t1 = Clock::now();
+        if (const_w) replay_step_n(b, W_TGT, in.x.data(), yb.data(), n);
+        else         replay_step_n(b, in.w.data(), in.x.data(), yb.data(), n);
+        auto t2 = Clock::now();
+
+        ta += std::chrono::duration<double>(t1 - t0).count();
+        tb += std::chrono::duration<double>(t2 - t1).count();
+        for (size_t i = 0; i < n; ++i) {
+            uint32_t u, v;
+            std::memcpy(&u, &ya[i], 4);
+            std::memcpy(&v, &yb[i], 4);
+            bad += (u != v);
+            sat += (std::fabs(ya[i]) >= YSAT);
+        }
+        done += (long)n;
+    }
+
+    const bool st = same_state(a.snapshot(), b.snapshot());
+    const bool ok = bad == 0 && st;
+    std::cout << std::left << std::setw(24) << name << std::right << std::fixed << std::setprecision(3)
+              << "  step " << std::setw(7) << ta / samples * 1e9 << " ns"
+              << "  step_n " << std::setw(7) << tb / samples * 1e9 << " ns"
+              << "  x" << std::setprecision(2) << ta / tb
+              << "  sat " << sat << "  mismatch " << bad << (st ? "" : "  state differs")
+              << (ok ? "  OK" : "  FAIL") << "\n";
+    return ok;
+}
+
+int main(int argc, char** argv) {
+    const long   samples = (argc > 1) ? (long)std::atof(argv[1]) : 100000000L;
+    const size_t chunk   = (argc > 2) ? (size_t)std::atol(argv[2]) : (size_t)1 << 20;
+
+    const Stream in = make_stream(chunk);
+    std::cout << "samples " << samples << ", chunk " << chunk << " (ns/sample)\n";
+
+    bool ok = true;
+    ok &= run<RoundNative>  ("RoundNative   w[n]",  in, samples, false);
+    ok &= run<RoundNative>  ("RoundNative   W_TGT", in, samples, true);
+    ok &= run<RoundVolatile>("RoundVolatile w[n]",  in, samples, false);
+    ok &= run<RoundVolatile>("RoundVolatile W_TGT", in, samples, true);
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,173 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+#include <vector>
+
+#include "loop_bank.hpp"
+
+// ============================================================
+//  시나리오 → 게이트별 평면 자극 표 (미리 컴파일)
+//  - 기술: StimScript 에 op 를 나열 (구간은 [g0, g1), g1 < 0 이면 끝까지)
+//        StimScript s(gates);
+//        s.step(0, 100.0f).ramp(2000, 2400, 100.0f, 40.0f).sine(3000, 4000, 5.0f, 2.0f)
+//         .load(5000, 6000, 30.0f).gain(7000, 1).fault(8000, 8050, STIM_ENC_LOSS);
+//      · step / ramp : 목표 기준값. 나중에 쓴 op 가 이김 (ramp 는 g1 이후 끝값 유지)
+//      · sine        : 기준값에 더함 (진폭, 주파수 [Hz])
+//      · load        : 부하 d [rad/s²] (LoadPlant), 겹치면 합
+//      · gain        : 계수 뱅크 번호 (0 = 시작 계수). 나중에 쓴 op 가 이김
+//      · fault       : StimFault 비트, 겹치면 OR
+//  - compile() → StimTable : w, d, flags, bank 게이트별 SoA 배열
+//    (op 마다 구간 채우기 → 게이트당 비용은 배열 읽기 4개)
+//  - eval(n) 은 같은 식을 게이트마다 op 목록을 훑어 계산하는 해석 기준
+//    (compile 과 비트 동일해야 함)
+//  - 적용: stim_gate() 가 게이트 하나를 진행. 고장 게이트도 ClosedLoop::step(w, GateFault)
+//    한 경로 (자극이 상수 목표뿐이면 ClosedLoop::run 과 비트 동일)
+//    계수 전환은 bank 가 바뀐 게이트에만 coeffs_at(bank) 호출
+// ============================================================
+
+enum StimFault : uint8_t {
+    STIM_ENC_LOSS = 1,   // 엔코더 펄스 유실: 제어기는 spdcnt = 0 (x = 0) 을 봄
+    STIM_PWM_OFF  = 2,   // 드라이버 비활성: 식물에 0 V (제어기는 계속 계산)
+};
+
+struct StimOp {
+    enum Kind : uint8_t { STEP, RAMP, SINE, LOAD, GAIN, FAULT };
+    Kind    kind;
+    uint8_t arg;         // GAIN: 뱅크, FAULT: 비트
+    long    g0, g1;
+    float   a, b;        // STEP: a, RAMP: a → b, SINE: 진폭 a / 주파수 b, LOAD: a
+};
+
+struct StimSample {
+    float   w, d;
+    uint8_t flags, bank;
+};
+
+struct StimTable {
+    long gates = 0;
+    std::vector<float>   w, d;
+    std::vector<uint8_t> flags, bank;
+
+    size_t bytes() const { return (size_t)gates * (2 * sizeof(float) + 2); }
+    StimSample at(long n) const { return { w[n], d[n], flags[n], bank[n] }; }
+};
+
+class StimScript {
+public:
+    explicit StimScript(long gates, float Ts = 0.005f) : gates_(gates), Ts_(Ts) {}
+
+    StimScript& step(long g, float w)                          { return add(StimOp::STEP, 0, g, -1, w, w); }
+    StimScript& ramp(long g0, long g1, float w0, float w1)     { return add(StimOp::RAMP, 0, g0, (g1 < 0) ? gates_ : g1, w0, w1); }
+    StimScript& sine(long g0, long g1, float amp, float hz)    { return add(StimOp::SINE, 0, g0, g1, amp, hz); }
+    StimScript& load(long g0, long g1, float d)                { return add(StimOp::LOAD, 0, g0, g1, d, 0.0f); }
+    StimScript& gain(long g, uint8_t bank)                     { return add(StimOp::GAIN, bank, g, -1, 0.0f, 0.0f); }
+    StimScript& fault(long g0, long g1, uint8_t mask)          { return add(StimOp::FAULT, mask, g0, g1, 0.0f, 0.0f); }
+
+    long gates() const { return gates_; }
+    const std::vector<StimOp>& ops() const { return ops_; }
+
+    // 해석 기준: 게이트 n 의 자극
+    StimSample eval(long n) const {
+        float w = 0.0f, d = 0.0f;
+        uint8_t flags = 0, bank = 0;
+        for (const StimOp& o : ops_) {
+            if (n < o.g0) continue;
+            switch (o.kind) {
+                case StimOp::STEP: w = o.a; break;
+                case StimOp::RAMP: w = (n < end(o)) ? ramp_at(o, n) : o.b; break;
+                case StimOp::GAIN: bank = o.arg; break;
+                default: break;
+            }
+        }
+        for (const StimOp& o : ops_) {
+            if (n < o.g0 || n >= end(o)) continue;
+            switch (o.kind) {
+                case StimOp::SINE:  w = w + sine_at(o, n); break;
+                case StimOp::LOAD:  d = d + o.a; break;
+                case StimOp::FAULT: flags |= o.arg; break;
+                default: break;
+            }
+        }
+        return { w, d, flags, bank };
+    }
+
+    // 구간 채우기 (eval 과 같은 순서/식)
+    StimTable compile() const {
+        StimTable t;
+        t.gates = gates_;
+        t.w.assign(gates_, 0.0f);
+        t.d.assign(gates_, 0.0f);
+        t.flags.assign(gates_, 0);
+        t.bank.assign(gates_, 0);
+        for (const StimOp& o : ops_) {
+            const long g0 = clip(o.g0), g1 = clip(end(o));
+            switch (o.kind) {
+                case StimOp::STEP: std::fill(t.w.begin() + g0, t.w.end(), o.a); break;
+                case StimOp::RAMP:
+                    for (long n = g0; n < g1; ++n) t.w[n] = ramp_at(o, n);
+                    std::fill(t.w.begin() + g1, t.w.end(), o.b);
+                    break;
+                case StimOp::GAIN: std::fill(t.bank.begin() + g0, t.bank.end(), o.arg); break;
+                default: break;
+            }
+        }
+        for (const StimOp& o : ops_) {
+            const long g0 = clip(o.g0), g1 = clip(end(o));
+            switch (o.kind) {
+                case StimOp::SINE:  for (long n = g0; n < g1; ++n) t.w[n] = t.w[n] + sine_at(o, n); break;
+                case StimOp::LOAD:  for (long n = g0; n < g1; ++n) t.d[n] = t.d[n] + o.a; break;
+                case StimOp::FAULT: for (long n = g0; n < g1; ++n) t.flags[n] |= o.arg; break;
+                default: break;
+            }
+        }
+        return t;
+    }
+
+private:
+    StimScript& add(StimOp::Kind k, uint8_t arg, long g0, long g1, float a, float b) {
+        ops_.push_back({ k, arg, g0, g1, a, b });
+        return *this;
+    }
+
+    long end(const StimOp& o) const { return (o.g1 < 0) ? gates_ : o.g1; }
+    long clip(long g) const { return std::clamp(g, 0L, gates_); }
+
+    static float ramp_at(const StimOp& o, long n) {
+        return (float)((double)o.a + ((double)o.b - (double)o.a) * (double)(n - o.g0) / (double)(o.g1 - o.g0));
+    }
+    float sine_at(const StimOp& o, long n) const {
+        return (float)((double)o.a * std::sin(2.0 * std::numbers::pi * (double)o.b * (double)Ts_ * (double)(n - o.g0)));
+    }
+
+    long  gates_;
+    float Ts_;
+    std::vector<StimOp> ops_;
+};
+
+// 게이트 하나 진행. prev_bank 와 다르면 coeffs_at(bank) 를 먼저 적용
+//  - 고장 없음: Loop::step(w), 고장 게이트: Loop::step(w, GateFault)
+template <class Loop, class CoeffsAt>
+inline GateSample stim_gate(Loop& L, const StimSample& s, uint8_t prev_bank, CoeffsAt&& coeffs_at) {
+    if (s.bank != prev_bank) L.controller().set_coeffs(coeffs_at(s.bank));
+    if constexpr (requires { L.plant().d; }) L.plant().d = s.d;
+    if (s.flags == 0) return L.step(s.w);
+    return L.step(s.w, GateFault{ (s.flags & STIM_ENC_LOSS) != 0, (s.flags & STIM_PWM_OFF) != 0 });
+}
+
+// 표의 n 번째 게이트 (전 게이트 bank 와 비교, 0 번은 뱅크 0 기준)
+template <class Loop, class CoeffsAt>
+inline GateSample stim_gate(Loop& L, const StimTable& t, long n, CoeffsAt&& coeffs_at) {
+    return stim_gate(L, t.at(n), n ? t.bank[n - 1] : (uint8_t)0, coeffs_at);
+}
+
+// 채널 묶음: table_of(ch) -> const StimTable&, coeffs_of(ch, bank) -> const DeltaCoeffs&
+// 여러 채널이 같은 표를 공유 (시간 블로킹이라 타일 구간이 블록 사이에서 캐시에 남음)
+template <class Loop, class TableOf, class CoeffsOf, class Sink>
+void stim_run(LoopBank<Loop>& bank, long gates, TableOf&& table_of, CoeffsOf&& coeffs_of, Sink&& sink) {
+    bank.run_with(0, gates, LoopBank<Loop>::tune(bank.size(), gates), [&](size_t c, long g, Loop& L) {
+        sink(c, g, stim_gate(L, table_of(c), g, [&](uint8_t b) -> const DeltaCoeffs& { return coeffs_of(c, b); }));
+    });
+}
@@ -0,0 +1,176 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "pid_coeffs.hpp"
+#include "stimulus.hpp"
+
+// ============================================================
+//  시나리오 컴파일 (stimulus.hpp) 검사 + 게이트당 자극 비용
+//  - 빌드: g++ -O2 -std=c++20 -fno-fast-math -ffp-contract=off stimulus_check.cpp
+//  - 사용: ./a.out [channels=4096] [gates=8000] [scripts=32]
+//  1) compile() == eval() : 스크립트별 w/d/flags/bank 배열 비트 동일
+//  2) 상수 목표 스크립트 + 뱅크 0 == DeltaClosedLoop::run (stim_gate 빠른 경로)
+//     고장 게이트: 엔코더 유실이면 x_meas = 0, y_applied() == 식물에 걸린 전압 (PWM 차단이면 0)
+//  3) 채널 묶음 (채널마다 게인 2 뱅크, 스크립트 공유):
+//     해석(게이트마다 eval) 대 컴파일 표 — 채널별 Σy 비트 동일 + ns/채널-게이트.
+//     바닥: 같은 묶음을 자극 없이 (LoopBank::run, 상수 목표)
+// ============================================================
+
+using Rnd  = RoundNative;
+using Loop = ClosedLoop<EncoderFloor, DeltaPid2TapAw, Rnd, LoadPlant>;
+
+static StimScript make_script(long gates, int i) {
+    const float w0 = 40.0f + 6.0f * (float)(i % 11);
+    const long  q  = gates / 8;
+    StimScript s(gates);
+    s.step(0, w0)
+     .ramp(2 * q, 2 * q + q / 2, w0, 0.5f * w0)
+     .sine(3 * q, 4 * q, 2.0f + (float)(i % 5), 1.0f + 0.5f * (float)(i % 4))
+     .load(4 * q + 10 * (i % 7), 5 * q, 20.0f + 5.0f * (float)(i % 3))
+     .load(4 * q + q / 2, 5 * q + q / 2, 10.0f)
+     .gain(5 * q + 3 * (i % 13), 1)
+     .fault(6 * q, 6 * q + 20 + i % 9, STIM_ENC_LOSS)
+     .fault(6 * q + 10, 6 * q + 40, (i % 2) ? STIM_PWM_OFF : 0)
+     .step(7 * q, (i % 3 == 0) ? -w0 : 0.8f * w0)
+     .gain(7 * q + q / 2, 0);
+    return s;
+}
+
+static bool check_compile(const std::vector<StimScript>& scripts, const std::vector<StimTable>& tables) {
+    long bad = 0, gates = 0;
+    for (size_t i = 0; i < scripts.size(); ++i) {
+        for (long n = 0; n < scripts[i].gates(); ++n, ++gates) {
+            const StimSample a = scripts[i].eval(n), b = tables[i].at(n);
+            bad += f32_to_hex(a.w) != f32_to_hex(b.w) || f32_to_hex(a.d) != f32_to_hex(b.d)
+                || a.flags != b.flags || a.bank != b.bank;
+        }
+    }
+    std::cout << "compile vs eval: " << scripts.size() << " scripts, " << gates << " gates, mismatches " << bad
+              << (bad ? "  FAIL" : "  OK") << "\n";
+    return bad == 0;
+}
+
+static Loop make_loop(size_t c, float Ts, const DeltaCoeffs& k0) {
+    return Loop(EncoderFloor<Rnd>(Ts), DeltaPid2TapAw<Rnd>(YSAT, k0),
+                LoadPlant<Rnd>(40.0f + (float)(c % 31), 4.0f + 0.05f * (float)(c % 41), Ts));
+}
+
+static bool check_const(long gates, float Ts) {
+    StimScript s(gates);
+    s.step(0, W_TGT);
+    const StimTable t = s.compile();
+    Loop a = make_loop(0, Ts, COEFFS_HEX);
+    DeltaClosedLoop<Rnd> ref(EncoderFloor<Rnd>(Ts), DeltaPid2TapAw<Rnd>(YSAT), FirstOrderPlant<Rnd>(40.0f, 4.0f, Ts));
+    long bad = 0;
+    for (long n = 0; n < gates; ++n) {
+        const GateSample x = stim_gate(a, t, n, [](uint8_t) -> const DeltaCoeffs& { return COEFFS_HEX; });
+        bad += f32_to_hex(x.y) != f32_to_hex(ref.step(W_TGT).y);
+    }
+    std::cout << "constant-w table vs DeltaClosedLoop: " << gates << " gates, y mismatches " << bad
+              << (bad ? "  FAIL" : "  OK") << "\n";
+    return bad == 0;
+}
+
+static bool check_fault(long gates, float Ts) {
+    const StimTable t = make_script(gates, 1).compile();
+    Loop a = make_loop(0, Ts, COEFFS_HEX);
+    long bad = 0, faulted = 0;
+    for (long n = 0; n < gates; ++n) {
+        const GateSample x = stim_gate(a, t, n, [](uint8_t) -> const DeltaCoeffs& { return COEFFS_HEX; });
+        const uint8_t f = t.flags[n];
+        faulted += f != 0;
+        if ((f & STIM_ENC_LOSS) && (x.spdcnt != 0 || x.x_meas != 0.0f)) ++bad;
+        const float applied = (f & STIM_PWM_OFF) ? 0.0f : x.y;
+        bad += f32_to_hex(a.y_applied()) != f32_to_hex(applied);
+    }
+    std::cout << "fault gates: " << faulted << " faulted, x_meas / y_applied mismatches " << bad
+              << (bad ? "  FAIL" : "  OK") << "\n";
+    return bad == 0;
+}
+
+int main(int argc, char** argv) {
+    const size_t N     = (argc > 1) ? (size_t)std::atol(argv[1]) : 4096;
+    const long   gates = (argc > 2) ? std::atol(argv[2]) : 8000;
+    const int    K     = (argc > 3) ? std::atoi(argv[3]) : 32;
+    const float  Ts    = 0.005f;
+
+    std::vector<StimScript> scripts;
+    for (int i = 0; i < K; ++i) scripts.push_back(make_script(gates, i));
+    const auto tc0 = std::chrono::steady_clock::now();
+    std::vector<StimTable> tables;
+    for (const StimScript& s : scripts) tables.push_back(s.compile());
+    const double t_comp = std::chrono::duration<double>(std::chrono::steady_clock::now() - tc0).count();
+    size_t bytes = 0;
+    for (const StimTable& t : tables) bytes += t.bytes();
+
+    bool ok = check_compile(scripts, tables);
+    ok &= check_const(gates, Ts);
+    ok &= check_fault(gates, Ts);
+
+    // 채널마다 게인 2 뱅크 (뱅크 1 = Kp·Ki 배율)
+    std::vector<DeltaCoeffs> banks(2 * N);
+    for (size_t c = 0; c < N; ++c) {
+        PidGains g = DEFAULT_GAINS;
+        g.Kp *= 0.6 + 0.8 * (double)(c % 17) / 16.0;
+        banks[2 * c] = compute_coeffs(g, Ts);
+        g.Kp *= 1.3;  g.Ki *= 1.5;
+        banks[2 * c + 1] = compute_coeffs(g, Ts);
+    }
+    auto coeffs_of = [&](size_t c, uint8_t b) -> const DeltaCoeffs& { return banks[2 * c + b]; };
+    auto build = [&](LoopBank<Loop>& bank) { for (size_t c = 0; c < N; ++c) bank.add(make_loop(c, Ts, banks[2 * c])); };
+
+    auto time_it = [](auto&& f) {
+        const auto t0 = std::chrono::steady_clock::now();
+        f();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+    };
+
+    // 해석: 게이트마다 eval, 전 게이트 뱅크는 채널별로 기억
+    std::vector<double> sum_i(N, 0.0), sum_c(N, 0.0), sum_0(N, 0.0);
+    double t_int, t_tab, t_base;
+    {
+        LoopBank<Loop> bank(N);
+        build(bank);
+        std::vector<uint8_t> prev(N, 0);
+        t_int = time_it([&] {
+            bank.run_with(0, gates, LoopBank<Loop>::tune(N, gates), [&](size_t c, long g, Loop& L) {
+                const StimSample s = scripts[c % K].eval(g);
+                sum_i[c] += stim_gate(L, s, prev[c], [&](uint8_t b) -> const DeltaCoeffs& { return coeffs_of(c, b); }).y;
+                prev[c] = s.bank;
+            });
+        });
+    }
+    {
+        LoopBank<Loop> bank(N);
+        build(bank);
+        t_tab = time_it([&] {
+            stim_run(bank, gates, [&](size_t c) -> const StimTable& { return tables[c % K]; }, coeffs_of,
+                     [&](size_t c, long, const GateSample& s) { sum_c[c] += s.y; });
+        });
+    }
+    {
+        LoopBank<Loop> bank(N);
+        build(bank);
+        t_base = time_it([&] {
+            bank.run(gates, [](size_t, long) { return W_TGT; }, [&](size_t c, long, const GateSample& s) { sum_0[c] += s.y; });
+        });
+    }
+    long diff = 0;
+    for (size_t c = 0; c < N; ++c) diff += sum_i[c] != sum_c[c];
+    ok &= diff == 0;
+
+    const double lg = (double)N * (double)gates;
+    std::cout << "channels=" << N << "  gates=" << gates << "  scripts=" << K << "  ops/script="
+              << scripts[0].ops().size() << "\n" << std::fixed << std::setprecision(2)
+              << "tables: " << (double)bytes / 1024.0 << " KB, compile " << t_comp * 1e3 << " ms ("
+              << 1e9 * t_comp / ((double)K * (double)gates) << " ns/gate)\n"
+              << "ns/channel-gate: interpreted " << 1e9 * t_int / lg << "  compiled " << 1e9 * t_tab / lg
+              << "  no stimulus " << 1e9 * t_base / lg << "\n"
+              << "per-channel Σy interpreted vs compiled: " << (diff ? "DIFF " : "bit-identical ") << diff
+              << (ok ? "  OK" : "  FAIL") << "\n";
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,146 @@
+#include <iostream>
+#include <iomanip>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "closed_loop.hpp"
+#include "pid_cycle_model.hpp"
+
+extern "C" {
+#include "../../SW Driver/mc_regs.h"
+#include "../../SW Driver/mc_swpid.h"
+}
+
+// ============================================================
+//  PS 소프트웨어 Δ-form 경로 (SW Driver/mc_swpid.c) 호스트 검증
+//  - 빌드: gcc -O2 -std=gnu99 -DMC_HOST -c "../../SW Driver/mc_swpid.c" -o mc_swpid.o   (곱 라운딩은 mc_delta_pid.h 가 volatile 로 확정, 빌드 옵션 무관)
+//          g++ -O2 -std=c++20 -fno-fast-math -ffp-contract=off -DMC_HOST sw_fallback_check.cpp mc_swpid.o
+//  - 사용: ./a.out [gates] [random_steps]
+//  1) 커널: mc_delta_pid_step 대 DeltaPid2TapAw<RoundVolatile> — 무작위 계수/입력
+//     (포화 포함) 에서 비트 동일
+//  2) 폐루프: MMIO 스탠드인(REG_STATUS13 = {gate_seq, spdcnt}, REG_Y_SW 쓰기 →
+//     식물 갱신 → 다음 게이트) 위에서 드라이버 경로 그대로 실행, y 열이
+//     DeltaClosedLoop(FPGA 모델)과 비트 동일한지 + 샘플당 지연 비교
+//  3) gate_seq 가 멈춘 보드: mc_swpid_step 이 MC_SWPID_WAIT_GATES 게이트 뒤 TIMEOUT (무한 대기 없음)
+// ============================================================
+
+// ---- MMIO 스탠드인: 레지스터 파일 + 엔코더/식물 (게이트 = REG_Y_SW 쓰기로 진행) ----
+struct HostBoard {
+    EncoderFloor<RoundVolatile>    enc;
+    FirstOrderPlant<RoundVolatile> plant;
+    uint32_t reg[16] = {};
+    uint16_t seq = 0;
+    int      spdcnt = 0;
+    std::vector<float> y;
+
+    HostBoard(float Ts) : enc(Ts), plant(50.0f, 5.0f, Ts) {}
+
+    void next_gate() {
+        float x_meas;
+        enc.sample(plant.speed(), spdcnt, x_meas);
+        ++seq;                                             // delta_valid
+    }
+};
+
+static HostBoard* g_board = nullptr;
+
+extern "C" uint32_t mc_host_rd32(uint32_t off) {
+    if (off == REG_STATUS13) return ((uint32_t)g_board->seq << 16) | (uint16_t)(int16_t)g_board->spdcnt;
+    return g_board->reg[off / 4];
+}
+
+extern "C" void mc_host_wr32(uint32_t off, uint32_t v) {
+    g_board->reg[off / 4] = v;
+    if (off == REG_Y_SW && (g_board->reg[REG_CTRL / 4] & CTRL_SW_MODE)) {
+        const float y = f32_from_hex(v);
+        g_board->y.push_back(y);
+        g_board->plant.update(y);
+        g_board->next_gate();
+    }
+}
+
+static bool check_kernel(long steps) {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> uc(-1.5f, 1.5f), uw(-150.0f, 150.0f);
+    long bad = 0, sat = 0;
+    for (int set = 0; set < 50; ++set) {
+        DeltaCoeffs k = COEFFS_HEX;                          // 0번은 Verilog 계수
+        if (set) k = DeltaCoeffs{ uc(rng), uc(rng), uc(rng), uc(rng), uc(rng),          // 중괄호 안은 왼쪽부터 평가
+                                  uc(rng), uc(rng), uc(rng), uc(rng) };
+        DeltaPid2TapAw<RoundVolatile> ref(YSAT, k);
+        mc_delta_pid_t c;
+        const float kc[9] = { k.c0, k.c1, k.c2, k.c3, k.c4, k.c5, k.c6, k.c7a, k.c7b };
+        mc_delta_pid_init(&c, kc, YSAT);
+        for (long n = 0; n < steps / 50; ++n) {
+            const float w = (n % 500 < 250) ? uw(rng) : 0.0f;
+            const float x = mc_spdcnt_to_x((int16_t)(rng() % 400) - 200);
+            const float a = ref.step(w, x), b = mc_delta_pid_step(&c, w, x);
+            if (f32_to_hex(a) != f32_to_hex(b)) ++bad;
+            if (std::fabs(a) >= YSAT) ++sat;
+        }
+    }
+    std::cout << "kernel: " << steps << " steps, saturated " << sat << ", mismatches " << bad
+              << (bad ? "  FAIL" : "  OK") << "\n";
+    return bad == 0;
+}
+
+int main(int argc, char** argv) {
+    const long gates = (argc > 1) ? std::atol(argv[1]) : 20000;
+    const long steps = (argc > 2) ? std::atol(argv[2]) : 2000000;
+    const float Ts = 0.005f;
+
+    bool ok = check_kernel(steps);
+
+    // FPGA 모델 (PID_MY_DIGIT 과 같은 조합)
+    DeltaClosedLoop<RoundVolatile> fpga(EncoderFloor<RoundVolatile>(Ts), DeltaPid2TapAw<RoundVolatile>(YSAT),
+                                        FirstOrderPlant<RoundVolatile>(50.0f, 5.0f, Ts));
+    std::vector<float> y_fpga;
+    fpga.run(gates, W_TGT, [&](long, const GateSample& s) { y_fpga.push_back(s.y); });
+
+    // 드라이버 PS 경로 (스탠드인 위)
+    HostBoard board(Ts);
+    g_board = &board;
+    const float k[9] = { C0, C1, C2, C3, C4, C5, C6, C7A, C7B };
+    mc_swpid_t sw;
+    mc_swpid_sample_t smp;
+    const uint32_t gate_us = (uint32_t)(Ts * 1e6f + 0.5f);
+    mc_swpid_start(&sw, k, YSAT, W_TGT, gate_us);
+    board.next_gate();                                       // 첫 게이트는 PS 경로 시작 후
+    for (long n = 0; n < gates; ++n) mc_swpid_step(&sw, &smp);
+    mc_swpid_stop(&sw);
+
+    long bad = 0, first = -1;
+    for (long n = 0; n < gates; ++n)
+        if (f32_to_hex(board.y[n]) != f32_to_hex(y_fpga[n])) { if (first < 0) first = n; ++bad; }
+    std::cout << "closed loop: " << gates << " gates, y mismatches vs FPGA model " << bad;
+    if (first >= 0) std::cout << " (first at gate " << first << ")";
+    std::cout << (bad ? "  FAIL" : "  OK") << "  missed=" << sw.missed << "\n";
+    ok = ok && bad == 0 && sw.missed == 0;
+
+    // 지연: PS 경로 (호스트 스탠드인이라 MMIO 가 함수 호출) 대 RTL 사이클 모델
+    const RtlParams rtl;
+    const double us = 1e6 / mc_swpid_ticks_per_sec();
+    std::cout << std::fixed << std::setprecision(3);
+    std::cout << "latency [us]: PS path mean " << (double)sw.lat_sum / (double)sw.gates * us
+              << "  min " << (double)sw.lat_min * us << "  max " << (double)sw.lat_max * us
+              << "   FPGA core+PWM (cycle model) " << cycle_model_latency(rtl) * 1e6 << "\n";
+    std::cout << "  (호스트 값은 스탠드인 식물 갱신 포함, 보드에서는 AXI 읽기/쓰기가 더해진다)\n";
+
+    // 3) 멈춘 gate_seq
+    {
+        mc_swpid_start(&sw, k, YSAT, W_TGT, gate_us);
+        const size_t ny = board.y.size();
+        const uint64_t t0 = mc_swpid_now();
+        const int rc = mc_swpid_step(&sw, &smp);
+        const double ms = (double)(mc_swpid_now() - t0) / mc_swpid_ticks_per_sec() * 1e3;
+        mc_swpid_stop(&sw);
+        const double lim = MC_SWPID_WAIT_GATES * gate_us * 1e-3;
+        const bool r = rc == MC_SWPID_TIMEOUT && board.y.size() == ny && ms >= lim && ms < lim + 100.0;
+        std::cout << "stalled gate_seq: rc " << rc << " after " << ms << " ms (limit " << lim << " ms), no Y_SW write"
+                  << (r ? "  OK" : "  FAIL") << "\n";
+        ok = ok && r;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include "jit_kernel.hpp"
+#include "loop_metrics.hpp"
+#include "pid_coeffs.hpp"
+#include "sim_cache.hpp"
+
+// ============================================================
+//  게인/식물 파라미터 스윕 공간
+//  - 파라미터 9개 고정 순서: Kp Ki Kd N b c Kb Ku lam  (n=1 축은 상수)
+//  - 점 번호 idx → 혼합 진법(마지막 축이 가장 빠름)으로 좌표
+//  - 샤드 = 연속 점 번호 [s*shard_size, (s+1)*shard_size) — 프로세스 수와 무관
+//  - hash() : 축 정의(비트 단위)로 만든 FNV-1a, 로그 호환성 확인용
+// ============================================================
+
+struct SweepAxis {
+    double lo, hi;
+    int    n;
+    bool   log;     // 로그 간격
+
+    double value(int i) const {
+        if (n <= 1) return lo;
+        const double t = (double)i / (double)(n - 1);
+        return log ? lo * std::pow(hi / lo, t) : lo + (hi - lo) * t;
+    }
+};
+
+struct SweepPoint {
+    PidGains g;
+    double   Ku, lam;
+};
+
+// 스윕 한 점의 평가 조건
+struct SweepEval {
+    double Ts    = 0.005;
+    long   gates = 2000;
+    float  w     = W_TGT;
+};
+
+// 한 점 평가: compute_coeffs → DeltaClosedLoop(RoundNative) 계단 응답
+// (컨트롤러는 JitDeltaPid2TapAw: ev.gates 가 측정된 손익분기를 넘을 때만 JIT, 결과는 비트 동일)
+static inline StepMetrics evaluate_point(const SweepPoint& p, const SweepEval& ev) {
+    const float Ts = (float)ev.Ts;
+    ClosedLoop<EncoderFloor, JitDeltaPid2TapAw, RoundNative, FirstOrderPlant> loop(
+        EncoderFloor<RoundNative>(Ts),
+        JitDeltaPid2TapAw<RoundNative>(YSAT, compute_coeffs(p.g, ev.Ts)),
+        FirstOrderPlant<RoundNative>((float)p.Ku, (float)p.lam, Ts));
+    StepMetricsAcc acc(Ts, YSAT, ev.gates);
+    loop.run(ev.gates, ev.w, [&](long, const GateSample& s) { acc.feed(s); });
+    return acc.finish();
+}
+
+// 캐시 키: 게인이 아닌 실제 FP32 계수/식물/시나리오/정책 비트 기준
+static inline CacheKey sim_key(const SweepPoint& p, const SweepEval& ev) {
+    CacheKey k;
+    k.str("step/v1").str("EncoderFloor").str("DeltaPid2TapAw").str("RoundNative").str("FirstOrderPlant");
+    k.coeffs(compute_coeffs(p.g, ev.Ts)).f32(YSAT);
+    k.f32((float)p.Ku).f32((float)p.lam).f32((float)ev.Ts);
+    k.u64((uint64_t)ev.gates).f32(ev.w);
+    return k;
+}
+
+// 캐시가 있으면 먼저 조회
+static inline StepMetrics evaluate_point(const SweepPoint& p, const SweepEval& ev, SimCache* cache) {
+    if (!cache) return evaluate_point(p, ev);
+    return cache->get_or_compute(sim_key(p, ev), [&] { return evaluate_point(p, ev); });
+}
+
+class SweepSpace {
+public:
+    static constexpr int NP = 9;
+    static constexpr const char* NAMES[NP] = { "Kp", "Ki", "Kd", "N", "b", "c", "Kb", "Ku", "lam" };
+
+    SweepSpace(const SweepAxis (&axes)[NP], uint32_t shard_size, const SweepEval& ev = SweepEval())
+        : shard_size_(shard_size), ev_(ev)
+    {
+        std::memcpy(ax_, axes, sizeof(ax_));
+        n_ = 1;
+        for (const SweepAxis& a : ax_) n_ *= (uint64_t)std::max(1, a.n);
+    }
+
+    uint64_t size()       const { return n_; }
+    uint32_t shard_size() const { return shard_size_; }
+    uint64_t shards()     const { return (n_ + shard_size_ - 1) / shard_size_; }
+    uint64_t shard_begin(uint64_t s) const { return s * shard_size_; }
+    uint64_t shard_end(uint64_t s)   const { return std::min<uint64_t>(n_, (s + 1) * shard_size_); }
+    const SweepEval& eval() const { return ev_; }
+
+    void params(uint64_t idx, double* p) const {
+        for (int k = NP - 1; k >= 0; --k) {
+            const uint64_t n = (uint64_t)std::max(1, ax_[k].n);
+            p[k] = ax_[k].value((int)(idx % n));
+            idx /= n;
+        }
+    }
+
+    static SweepPoint point_of(const double* p) {
+        return SweepPoint{ PidGains{ p[0], p[1], p[2], p[3], p[4], p[5], p[6] }, p[7], p[8] };
+    }
+
+    uint64_t hash() const {
+        uint64_t h = 1469598103934665603ull;
+        auto mix = [&](const void* d, size_t len) {
+            const uint8_t* b = (const uint8_t*)d;
+            for (size_t i = 0; i < len; ++i) { h ^= b[i]; h *= 1099511628211ull; }
+        };
+        for (const SweepAxis& a : ax_) {
+            mix(&a.lo, 8);  mix(&a.hi, 8);
+            const int32_t n = a.n;  const uint8_t l = a.log;
+            mix(&n, 4);     mix(&l, 1);
+        }
+        mix(&shard_size_, 4);
+        mix(&ev_.Ts, 8);  mix(&ev_.gates, sizeof(ev_.gates));  mix(&ev_.w, 4);
+        return h;
+    }
+
+private:
+    SweepAxis ax_[NP];
+    uint64_t  n_ = 0;
+    uint32_t  shard_size_;
+    SweepEval ev_;
+};
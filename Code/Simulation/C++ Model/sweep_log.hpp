@@ -0,0 +1,255 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// ============================================================
+//  스윕 결과 로그 (append-only, 레코드별 CRC32)
+//  - 파일 = 헤더 1개 + 레코드 열
+//      헤더   : "PIDSWEEP" | ver u32 | n_params u32 | n_metrics u32 | shard_size u32
+//               | n_points u64 | space_hash u64 | crc u32
+//      레코드 : magic u32 | type u16 | len u16 | payload[len] | crc u32 (magic~payload)
+//      POINT      payload : shard u32 | index u64 | params f64[np] | metrics f32[nm]
+//      SHARD_DONE payload : shard u32 | count u64
+//  - 쓰기는 O_APPEND write() 한 번에 레코드 하나 → 프로세스가 죽어도 앞 레코드는 온전
+//  - 샤드 완료 시 fdatasync (전원 손실 시 잃는 것은 최대 샤드 하나)
+//  - 열 때 마지막 유효 레코드 뒤(찢어진 꼬리)는 잘라낸다
+//  - 리틀 엔디언 호스트 가정 (x86-64/ARM)
+// ============================================================
+
+// slicing-by-8 (8바이트당 테이블 8회 조회, 결과는 바이트 단위 구현과 동일)
+static inline uint32_t crc32_ieee(const void* data, size_t len, uint32_t crc = 0) {
+    static uint32_t table[8][256];
+    static bool init = false;
+    if (!init) {
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t c = i;
+            for (int k = 0; k < 8; ++k) c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            table[0][i] = c;
+        }
+        for (uint32_t i = 0; i < 256; ++i)
+            for (int t = 1; t < 8; ++t) table[t][i] = table[0][table[t - 1][i] & 0xFF] ^ (table[t - 1][i] >> 8);
+        init = true;
+    }
+    const uint8_t* p = (const uint8_t*)data;
+    crc = ~crc;
+    for (; len >= 8; len -= 8, p += 8) {
+        uint32_t lo, hi;
+        std::memcpy(&lo, p, 4);
+        std::memcpy(&hi, p + 4, 4);
+        lo ^= crc;
+        crc = table[7][lo & 0xFF] ^ table[6][(lo >> 8) & 0xFF] ^ table[5][(lo >> 16) & 0xFF] ^ table[4][lo >> 24]
+            ^ table[3][hi & 0xFF] ^ table[2][(hi >> 8) & 0xFF] ^ table[1][(hi >> 16) & 0xFF] ^ table[0][hi >> 24];
+    }
+    for (; len; --len) crc = table[0][(crc ^ *p++) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+struct SweepLogHeader {
+    char     magic[8];
+    uint32_t version;
+    uint32_t n_params;
+    uint32_t n_metrics;
+    uint32_t shard_size;
+    uint64_t n_points;
+    uint64_t space_hash;
+    uint32_t crc;
+
+    static constexpr uint32_t VERSION = 1;
+    static constexpr size_t   BYTES   = 8 + 4 * 4 + 8 * 2 + 4;
+
+    bool compatible(const SweepLogHeader& o) const {
+        return version == o.version && n_params == o.n_params && n_metrics == o.n_metrics
+            && shard_size == o.shard_size && n_points == o.n_points && space_hash == o.space_hash;
+    }
+
+    void encode(uint8_t* b) const {
+        std::memcpy(b, "PIDSWEEP", 8);
+        std::memcpy(b + 8,  &version, 4);    std::memcpy(b + 12, &n_params, 4);
+        std::memcpy(b + 16, &n_metrics, 4);  std::memcpy(b + 20, &shard_size, 4);
+        std::memcpy(b + 24, &n_points, 8);   std::memcpy(b + 32, &space_hash, 8);
+        const uint32_t c = crc32_ieee(b, 40);
+        std::memcpy(b + 40, &c, 4);
+    }
+
+    bool decode(const uint8_t* b) {
+        if (std::memcmp(b, "PIDSWEEP", 8) != 0) return false;
+        std::memcpy(&crc, b + 40, 4);
+        if (crc != crc32_ieee(b, 40)) return false;
+        std::memcpy(magic, b, 8);
+        std::memcpy(&version, b + 8, 4);     std::memcpy(&n_params, b + 12, 4);
+        std::memcpy(&n_metrics, b + 16, 4);  std::memcpy(&shard_size, b + 20, 4);
+        std::memcpy(&n_points, b + 24, 8);   std::memcpy(&space_hash, b + 32, 8);
+        return true;
+    }
+};
+
+struct SweepRecord {
+    enum Type : uint16_t { POINT = 1, SHARD_DONE = 2 };
+
+    uint16_t            type  = POINT;
+    uint32_t            shard = 0;
+    uint64_t            index = 0;      // POINT: 점 번호, SHARD_DONE: 점 개수
+    std::vector<double> params;
+    std::vector<float>  metrics;
+};
+
+class SweepLog {
+public:
+    static constexpr uint32_t REC_MAGIC = 0x52575350;   // "PSWR"
+
+    // 파일 전체 읽기. 반환: 마지막 유효 레코드 끝 오프셋 (헤더 불량이면 0)
+    // on_rec(const SweepRecord&) 는 유효 레코드마다 호출
+    template <class F>
+    static size_t scan(const std::string& path, SweepLogHeader& hdr, F&& on_rec) {
+        std::vector<uint8_t> buf;
+        if (!read_all(path, buf) || buf.size() < SweepLogHeader::BYTES) return 0;
+        if (!hdr.decode(buf.data())) return 0;
+
+        size_t off = SweepLogHeader::BYTES;
+        SweepRecord r;
+        while (off + 12 <= buf.size()) {
+            uint32_t magic; uint16_t type, len;
+            std::memcpy(&magic, &buf[off], 4);
+            std::memcpy(&type, &buf[off + 4], 2);
+            std::memcpy(&len, &buf[off + 6], 2);
+            if (magic != REC_MAGIC || off + 8 + len + 4 > buf.size()) break;
+            uint32_t crc;
+            std::memcpy(&crc, &buf[off + 8 + len], 4);
+            if (crc != crc32_ieee(&buf[off], 8 + len)) break;
+            if (!decode(hdr, type, &buf[off + 8], len, r)) break;
+            on_rec(r);
+            off += 8 + len + 4;
+        }
+        return off;
+    }
+
+    SweepLog() = default;
+    SweepLog(const SweepLog&) = delete;
+    SweepLog& operator=(const SweepLog&) = delete;
+    ~SweepLog() { close(); }
+
+    // 없으면 만들고, 있으면 헤더 호환 확인 + 찢어진 꼬리 절단
+    bool open(const std::string& path, const SweepLogHeader& hdr, std::string* err = nullptr) {
+        close();
+        hdr_ = hdr;
+        SweepLogHeader old{};
+        const size_t valid = scan(path, old, [](const SweepRecord&) {});
+        struct stat st;
+        const bool exists = ::stat(path.c_str(), &st) == 0 && st.st_size > 0;
+
+        if (exists && valid == 0) return fail(err, path + ": 헤더 손상 또는 스윕 로그 아님");
+        if (exists && !old.compatible(hdr)) return fail(err, path + ": 다른 스윕 공간의 로그");
+
+        fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+        if (fd_ < 0) return fail(err, path + ": open 실패");
+        if (exists) {
+            if ((off_t)valid < st.st_size && ::ftruncate(fd_, (off_t)valid) != 0)
+                return fail(err, path + ": 꼬리 절단 실패");
+            truncated_ = (size_t)st.st_size - valid;
+        } else {
+            uint8_t b[SweepLogHeader::BYTES];
+            hdr_.encode(b);
+            if (!write_all(b, sizeof(b)) || ::fdatasync(fd_) != 0) return fail(err, path + ": 헤더 쓰기 실패");
+        }
+        return true;
+    }
+
+    bool append_point(uint32_t shard, uint64_t index, const double* params, const float* metrics) {
+        const uint16_t len = (uint16_t)(4 + 8 + 8 * hdr_.n_params + 4 * hdr_.n_metrics);
+        uint8_t* p = begin(SweepRecord::POINT, len);
+        std::memcpy(p, &shard, 4);
+        std::memcpy(p + 4, &index, 8);
+        std::memcpy(p + 12, params, 8 * hdr_.n_params);
+        std::memcpy(p + 12 + 8 * hdr_.n_params, metrics, 4 * hdr_.n_metrics);
+        return commit(len);
+    }
+
+    bool append_shard_done(uint32_t shard, uint64_t count) {
+        uint8_t* p = begin(SweepRecord::SHARD_DONE, 12);
+        std::memcpy(p, &shard, 4);
+        std::memcpy(p + 4, &count, 8);
+        return commit(12) && ::fdatasync(fd_) == 0;
+    }
+
+    size_t truncated_bytes() const { return truncated_; }
+
+    void close() {
+        if (fd_ >= 0) { ::fdatasync(fd_); ::close(fd_); }
+        fd_ = -1;
+    }
+
+private:
+    static bool decode(const SweepLogHeader& h, uint16_t type, const uint8_t* p, uint16_t len, SweepRecord& r) {
+        r.type = type;
+        if (type == SweepRecord::POINT) {
+            if (len != 12 + 8 * h.n_params + 4 * h.n_metrics) return false;
+            std::memcpy(&r.shard, p, 4);
+            std::memcpy(&r.index, p + 4, 8);
+            r.params.resize(h.n_params);
+            r.metrics.resize(h.n_metrics);
+            std::memcpy(r.params.data(), p + 12, 8 * h.n_params);
+            std::memcpy(r.metrics.data(), p + 12 + 8 * h.n_params, 4 * h.n_metrics);
+            return true;
+        }
+        if (type == SweepRecord::SHARD_DONE) {
+            if (len != 12) return false;
+            std::memcpy(&r.shard, p, 4);
+            std::memcpy(&r.index, p + 4, 8);
+            return true;
+        }
+        return false;
+    }
+
+    static bool read_all(const std::string& path, std::vector<uint8_t>& buf) {
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        uint8_t tmp[1 << 16];
+        for (;;) {
+            const ssize_t n = ::read(fd, tmp, sizeof(tmp));
+            if (n <= 0) break;
+            buf.insert(buf.end(), tmp, tmp + n);
+        }
+        ::close(fd);
+        return true;
+    }
+
+    uint8_t* begin(uint16_t type, uint16_t len) {
+        rec_.resize(8 + (size_t)len + 4);
+        std::memcpy(&rec_[0], &REC_MAGIC, 4);
+        std::memcpy(&rec_[4], &type, 2);
+        std::memcpy(&rec_[6], &len, 2);
+        return &rec_[8];
+    }
+
+    bool commit(uint16_t len) {
+        const uint32_t crc = crc32_ieee(rec_.data(), 8 + len);
+        std::memcpy(&rec_[8 + len], &crc, 4);
+        return write_all(rec_.data(), rec_.size());
+    }
+
+    bool write_all(const uint8_t* p, size_t n) {
+        while (n > 0) {
+            const ssize_t w = ::write(fd_, p, n);
+            if (w <= 0) return false;
+            p += w;  n -= (size_t)w;
+        }
+        return true;
+    }
+
+    static bool fail(std::string* err, const std::string& msg) {
+        if (err) *err = msg;
+        return false;
+    }
+
+    SweepLogHeader       hdr_{};
+    int                  fd_ = -1;
+    size_t               truncated_ = 0;
+    std::vector<uint8_t> rec_;
+};
@@ -0,0 +1,116 @@
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <sys/stat.h>
+
+#include "sweep.hpp"
+#include "sweep_log.hpp"
+
+// ============================================================
+//  스윕 로그 병합
+//  - 입력 로그를 검증(헤더 호환/CRC)하고 점 번호로 중복 제거 (먼저 나온 것 채택)
+//  - 출력: 점 번호 순 새 로그 (+ 모든 점이 있는 샤드는 SHARD_DONE), 선택적으로 CSV
+//  - 출력은 <out>.tmp 에 쓴 뒤 rename (중단돼도 기존 out 보존)
+//  - 빌드: g++ -O2 -std=c++20 sweep_merge.cpp -o sweep_merge
+//  - 사용: ./sweep_merge <out.log> <in.log>... [--csv out.csv]
+// ============================================================
+
+int main(int argc, char** argv) {
+    std::string out, csv;
+    std::vector<std::string> in;
+    for (int i = 1; i < argc; ++i) {
+        const std::string a = argv[i];
+        if (a == "--csv" && i + 1 < argc) csv = argv[++i];
+        else if (out.empty()) out = a;
+        else in.push_back(a);
+    }
+    if (out.empty() || in.empty()) {
+        std::cerr << "usage: " << argv[0] << " <out.log> <in.log>... [--csv out.csv]\n";
+        return 1;
+    }
+
+    SweepLogHeader hdr{};
+    bool have_hdr = false;
+    std::map<uint64_t, SweepRecord> pts;
+    long n_rec = 0, dup = 0, conflict = 0, skipped_files = 0;
+    size_t torn = 0;
+
+    for (const std::string& f : in) {
+        SweepLogHeader h{};
+        std::vector<SweepRecord> recs;
+        const size_t valid = SweepLog::scan(f, h, [&](const SweepRecord& r) {
+            if (r.type == SweepRecord::POINT) recs.push_back(r);
+        });
+        if (valid == 0) { std::cerr << f << ": 헤더 불량 — 건너뜀\n"; ++skipped_files; continue; }
+        if (!have_hdr) { hdr = h; have_hdr = true; }
+        else if (!hdr.compatible(h)) { std::cerr << f << ": 다른 스윕 공간 — 건너뜀\n"; ++skipped_files; continue; }
+
+        struct stat st;
+        if (::stat(f.c_str(), &st) == 0 && (size_t)st.st_size > valid) torn += (size_t)st.st_size - valid;
+
+        for (SweepRecord& r : recs) {
+            ++n_rec;
+            auto it = pts.find(r.index);
+            if (it == pts.end()) { pts.emplace(r.index, std::move(r)); continue; }
+            ++dup;
+            if (std::memcmp(it->second.metrics.data(), r.metrics.data(), 4 * r.metrics.size()) != 0) ++conflict;
+        }
+    }
+    if (!have_hdr) { std::cerr << "유효한 입력 없음\n"; return 1; }
+
+    // 점 번호 순 기록 + 완전한 샤드 표시
+    const std::string tmp = out + ".tmp";
+    std::remove(tmp.c_str());
+    long complete = 0;
+    {
+        SweepLog log;
+        std::string err;
+        if (!log.open(tmp, hdr, &err)) { std::cerr << err << "\n"; return 1; }
+        const uint64_t shards = (hdr.n_points + hdr.shard_size - 1) / hdr.shard_size;
+        auto it = pts.begin();
+        for (uint64_t s = 0; s < shards; ++s) {
+            const uint64_t b = s * hdr.shard_size;
+            const uint64_t e = std::min<uint64_t>(hdr.n_points, b + hdr.shard_size);
+            uint64_t n = 0;
+            for (; it != pts.end() && it->first < e; ++it, ++n) {
+                const SweepRecord& r = it->second;
+                if (!log.append_point(r.shard, r.index, r.params.data(), r.metrics.data())) { std::cerr << "write 실패\n"; return 1; }
+            }
+            if (n == e - b) {
+                if (!log.append_shard_done((uint32_t)s, n)) { std::cerr << "write 실패\n"; return 1; }
+                ++complete;
+            }
+        }
+    }
+    if (std::rename(tmp.c_str(), out.c_str()) != 0) { std::perror("rename"); return 1; }
+
+    if (!csv.empty()) {
+        FILE* f = std::fopen(csv.c_str(), "w");
+        if (!f) { std::perror("csv"); return 1; }
+        std::fprintf(f, "index");
+        for (uint32_t k = 0; k < hdr.n_params; ++k)
+            if (hdr.n_params == (uint32_t)SweepSpace::NP) std::fprintf(f, ",%s", SweepSpace::NAMES[k]);
+            else std::fprintf(f, ",p%u", k);
+        for (uint32_t k = 0; k < hdr.n_metrics; ++k)
+            if (hdr.n_metrics == (uint32_t)StepMetrics::N_FIELDS) std::fprintf(f, ",%s", StepMetrics::NAMES[k]);
+            else std::fprintf(f, ",m%u", k);
+        std::fprintf(f, "\n");
+        for (const auto& kv : pts) {
+            std::fprintf(f, "%llu", (unsigned long long)kv.first);
+            for (double v : kv.second.params)  std::fprintf(f, ",%.17g", v);
+            for (float  v : kv.second.metrics) std::fprintf(f, ",%.9g", (double)v);
+            std::fprintf(f, "\n");
+        }
+        std::fclose(f);
+    }
+
+    std::cerr << "records=" << n_rec << " unique=" << pts.size() << "/" << hdr.n_points
+              << " duplicates=" << dup << " conflicts=" << conflict
+              << " complete_shards=" << complete << " torn_bytes=" << torn
+              << " skipped_files=" << skipped_files << "\n";
+    return conflict ? 2 : 0;
+}
@@ -0,0 +1,155 @@
+#include <iostream>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <dirent.h>
+#include <sys/prctl.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "sweep.hpp"
+#include "sweep_log.hpp"
+
+// ============================================================
+//  샤드 단위 재시작 가능 스윕 (한 머신, 여러 프로세스)
+//  - 워커 p 는 샤드 s ≡ p (mod procs) 를 맡고 <dir>/part-<p>.log 에만 쓴다
+//  - 시작 시 <dir>/part-*.log 전부를 읽어 완료 샤드/점을 건너뜀
+//    (procs 를 바꿔 재시작해도 이미 계산한 점은 다시 계산하지 않는다)
+//  - 빌드: g++ -O2 -std=c++20 -fno-fast-math -ffp-contract=off sweep_run.cpp -o sweep_run
+//  - 사용: ./sweep_run <dir> [procs] [gates] [cache_dir]
+//          cache_dir 를 주면 같은 (계수, 식물, 시나리오) 는 SimCache 에서 재사용
+//          중단(Ctrl-C/kill) 후 같은 명령으로 재실행하면 이어서 진행
+//          결과 합치기: sweep_merge
+// ============================================================
+
+static SweepSpace default_space(long gates) {
+    const SweepAxis ax[SweepSpace::NP] = {
+        { 0.02, 0.5,   12, true  },   // Kp
+        { 0.01, 1.0,   12, true  },   // Ki
+        { 0.0,  0.004,  5, false },   // Kd
+        { 120,  120,    1, false },   // N
+        { 1.0,  1.0,    1, false },   // b
+        { 0.0,  0.0,    1, false },   // c
+        { 12.0, 12.0,   1, false },   // Kb
+        { 30.0, 80.0,   3, false },   // Ku
+        { 3.0,  8.0,    3, false },   // lam
+    };
+    SweepEval ev;
+    ev.gates = gates;
+    return SweepSpace(ax, 64, ev);
+}
+
+static SweepLogHeader header_of(const SweepSpace& sp) {
+    SweepLogHeader h{};
+    h.version    = SweepLogHeader::VERSION;
+    h.n_params   = SweepSpace::NP;
+    h.n_metrics  = StepMetrics::N_FIELDS;
+    h.shard_size = sp.shard_size();
+    h.n_points   = sp.size();
+    h.space_hash = sp.hash();
+    return h;
+}
+
+static std::vector<std::string> list_parts(const std::string& dir) {
+    std::vector<std::string> out;
+    if (DIR* d = opendir(dir.c_str())) {
+        while (dirent* e = readdir(d)) {
+            const std::string n = e->d_name;
+            if (n.rfind("part-", 0) == 0 && n.size() > 4 && n.substr(n.size() - 4) == ".log")
+                out.push_back(dir + "/" + n);
+        }
+        closedir(d);
+    }
+    return out;
+}
+
+static int worker(const std::string& dir, const SweepSpace& sp, unsigned p, unsigned procs,
+                  const std::string& cache_dir) {
+    const SweepLogHeader hdr = header_of(sp);
+    std::unique_ptr<SimCache> cache;
+    if (!cache_dir.empty()) cache.reset(new SimCache(cache_dir, 256ull << 20));
+
+    // 기존 로그 → 완료 점/샤드
+    std::vector<uint8_t> point_done(sp.size(), 0), shard_done(sp.shards(), 0);
+    for (const std::string& f : list_parts(dir)) {
+        SweepLogHeader h{};
+        SweepLog::scan(f, h, [&](const SweepRecord& r) {
+            if (r.type == SweepRecord::POINT && r.index < sp.size()) point_done[r.index] = 1;
+            if (r.type == SweepRecord::SHARD_DONE && r.shard < sp.shards()) shard_done[r.shard] = 1;
+        });
+        if (h.n_points != 0 && !h.compatible(hdr)) {
+            std::cerr << f << ": 다른 스윕 공간의 로그 (출력 디렉터리를 분리하세요)\n";
+            return 2;
+        }
+    }
+
+    SweepLog log;
+    std::string err;
+    if (!log.open(dir + "/part-" + std::to_string(p) + ".log", hdr, &err)) {
+        std::cerr << "worker " << p << ": " << err << "\n";
+        return 1;
+    }
+
+    long run = 0, skipped = 0, evaluated = 0, reused = 0;
+    double params[SweepSpace::NP];
+    for (uint64_t s = p; s < sp.shards(); s += procs) {
+        if (shard_done[s]) { ++skipped; continue; }
+        uint64_t count = 0;
+        for (uint64_t idx = sp.shard_begin(s); idx < sp.shard_end(s); ++idx, ++count) {
+            if (point_done[idx]) { ++reused; continue; }
+            sp.params(idx, params);
+            const StepMetrics m = evaluate_point(SweepSpace::point_of(params), sp.eval(), cache.get());
+            if (!log.append_point((uint32_t)s, idx, params, m.data())) { std::cerr << "write 실패\n"; return 1; }
+            ++evaluated;
+        }
+        if (!log.append_shard_done((uint32_t)s, count)) { std::cerr << "write 실패\n"; return 1; }
+        ++run;
+    }
+    std::fprintf(stderr, "worker %u: shards run=%ld skipped=%ld  points evaluated=%ld reused=%ld  (torn tail %zu B)",
+                 p, run, skipped, evaluated, reused, log.truncated_bytes());
+    if (cache) std::fprintf(stderr, "  cache hit=%llu miss=%llu",
+                            (unsigned long long)cache->hits(), (unsigned long long)cache->misses());
+    std::fprintf(stderr, "\n");
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " <dir> [procs] [gates] [cache_dir]\n";
+        return 1;
+    }
+    const std::string dir   = argv[1];
+    const unsigned    procs = (argc > 2) ? (unsigned)std::atoi(argv[2]) : 4;
+    const long        gates = (argc > 3) ? std::atol(argv[3]) : 2000;
+    const std::string cache = (argc > 4) ? argv[4] : "";
+    ::mkdir(dir.c_str(), 0755);
+
+    const SweepSpace sp = default_space(gates);
+    std::cerr << "# points=" << sp.size() << " shards=" << sp.shards()
+              << " shard_size=" << sp.shard_size() << " procs=" << procs
+              << " hash=" << std::hex << sp.hash() << std::dec << "\n";
+
+    std::vector<pid_t> kids;
+    for (unsigned p = 0; p < procs; ++p) {
+        const pid_t pid = fork();
+        if (pid == 0) {
+            prctl(PR_SET_PDEATHSIG, SIGKILL);       // 부모가 죽으면 워커도 종료
+            if (getppid() == 1) std::_Exit(1);
+            std::_Exit(worker(dir, sp, p, procs, cache));
+        }
+        if (pid < 0) { std::perror("fork"); return 1; }
+        kids.push_back(pid);
+    }
+    int rc = 0;
+    for (pid_t k : kids) {
+        int st = 0;
+        waitpid(k, &st, 0);
+        if (!WIFEXITED(st) || WEXITSTATUS(st) != 0) rc = 1;
+    }
+    return rc;
+}
@@ -0,0 +1,158 @@
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "async_writer.hpp"
+#include "loop_bank.hpp"
+#include "sweep_log.hpp"   // crc32_ieee
+
+// ============================================================
+//  전 채널·전 게이트 트레이스 기록: 블로킹 write() 대 AsyncWriter
+//  - 빌드: g++ -O2 -std=c++20 -fno-fast-math -ffp-contract=off -pthread trace_writer_bench.cpp
+//  - 사용: ./a.out <out_dir> [channels] [gates] [buf_KB]
+//  - 레코드 = ch u32 | gate u32 | x_meas f32 | y f32 (16 B), LoopBank 블록 순서
+//  - 모드: none(기록 없음) / write(시뮬레이션 스레드에서 write) / thread / io_uring
+//          / io_uring+O_DIRECT. 시뮬레이션 스레드 시간과 close(모두 완료) 시간을 분리
+//  - 모든 모드의 파일 CRC 가 같아야 함
+// ============================================================
+
+using Loop = DeltaClosedLoop<RoundNative>;
+
+struct TraceRec {
+    uint32_t ch, gate;
+    float    x_meas, y;
+};
+
+// 기존 방식: 버퍼가 차면 그 자리에서 write()
+class BlockingWriter {
+public:
+    bool open(const std::string& path, size_t buf) {
+        fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        b_.resize(buf);
+        return fd_ >= 0;
+    }
+    void append(const void* p, size_t n) {
+        if (n_ + n > b_.size()) flush();
+        std::memcpy(b_.data() + n_, p, n);
+        n_ += n;
+    }
+    void close() { flush(); ::close(fd_); }
+    double worst_s = 0.0;
+
+private:
+    void flush() {
+        const auto t0 = std::chrono::steady_clock::now();
+        for (size_t off = 0; off < n_; ) {
+            const ssize_t w = ::write(fd_, b_.data() + off, n_ - off);
+            if (w <= 0) break;
+            off += (size_t)w;
+        }
+        n_ = 0;
+        worst_s = std::max(worst_s, std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count());
+    }
+    int fd_ = -1;
+    std::vector<uint8_t> b_;
+    size_t n_ = 0;
+};
+
+template <class Out>
+static void simulate(size_t channels, long gates, Out&& out) {
+    const float Ts = 0.005f;
+    LoopBank<Loop> bank(channels);
+    for (size_t i = 0; i < channels; ++i)
+        bank.add(Loop(EncoderFloor<RoundNative>(Ts), DeltaPid2TapAw<RoundNative>(YSAT),
+                      FirstOrderPlant<RoundNative>(30.0f + (float)(i % 53), 3.0f + 0.1f * (float)(i % 29), Ts)));
+    bank.run(gates,
+             [&](size_t c, long g) { return (g < gates / 2 ? W_TGT : 0.4f * W_TGT) * (0.5f + (float)(c % 97) / 97.0f); },
+             [&](size_t c, long g, const GateSample& s) { out(TraceRec{ (uint32_t)c, (uint32_t)g, s.x_meas, s.y }); });
+}
+
+static uint32_t file_crc(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return 0;
+    std::vector<uint8_t> b(1 << 20);
+    uint32_t crc = 0;
+    for (ssize_t n; (n = ::read(fd, b.data(), b.size())) > 0; ) crc = crc32_ieee(b.data(), (size_t)n, crc);
+    ::close(fd);
+    return crc;
+}
+
+static double since(std::chrono::steady_clock::time_point t0) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+int main(int argc, char** argv) {
+    if (argc < 2) { std::cerr << "usage: " << argv[0] << " <out_dir> [channels] [gates] [buf_KB]\n"; return 2; }
+    const std::string dir = argv[1];
+    const size_t channels = (argc > 2) ? (size_t)std::atol(argv[2]) : 256;
+    const long   gates    = (argc > 3) ? std::atol(argv[3]) : 20000;
+    AsyncWriter::Options opt;
+    if (argc > 4) opt.buf_bytes = (size_t)std::atol(argv[4]) * 1024;
+    const double mb = (double)channels * (double)gates * sizeof(TraceRec) / 1e6;
+
+    std::cout << channels << " ch x " << gates << " gates = " << std::fixed << std::setprecision(1) << mb
+              << " MB, buffer " << opt.buf_bytes / 1024 << " KB\n";
+    std::cout << "  mode              sim[s]  close[s]  worst hand-off[ms]  stall[s]  bufs   crc\n";
+
+    auto row = [&](const char* name, double sim, double cl, double worst, double stall, size_t bufs, uint32_t crc) {
+        std::cout << "  " << std::left << std::setw(17) << name << std::right << std::setprecision(3)
+                  << std::setw(7) << sim << std::setw(10) << cl << std::setw(20) << worst * 1e3
+                  << std::setw(10) << stall << std::setw(6) << bufs << "  " << std::hex << crc << std::dec << "\n";
+    };
+
+    {
+        double acc = 0.0;
+        const auto t0 = std::chrono::steady_clock::now();
+        simulate(channels, gates, [&](const TraceRec& r) { acc += r.y; });
+        row("none", since(t0), 0.0, 0.0, 0.0, 0, 0);
+        if (acc == 1.2345) std::cout << "";   // 최적화로 시뮬레이션이 사라지지 않게
+    }
+
+    uint32_t ref = 0;
+    bool     ok  = true;
+    {
+        const std::string path = dir + "/trace_write.bin";
+        BlockingWriter w;
+        if (!w.open(path, opt.buf_bytes)) { std::cerr << path << ": open 실패\n"; return 1; }
+        const auto t0 = std::chrono::steady_clock::now();
+        simulate(channels, gates, [&](const TraceRec& r) { w.append(&r, sizeof(r)); });
+        const double sim = since(t0);
+        const auto t1 = std::chrono::steady_clock::now();
+        w.close();
+        ref = file_crc(path);
+        row("write", sim, since(t1), w.worst_s, 0.0, 1, ref);
+        std::remove(path.c_str());
+    }
+
+    struct Mode { const char* name; AsyncWriter::Backend b; bool direct; };
+    for (const Mode m : { Mode{ "thread", AsyncWriter::Backend::THREAD, false },
+                          Mode{ "io_uring", AsyncWriter::Backend::URING, false },
+                          Mode{ "io_uring+direct", AsyncWriter::Backend::URING, true } }) {
+        const std::string path = dir + "/trace_" + m.name + ".bin";
+        AsyncWriter::Options o = opt;
+        o.backend = m.b;
+        o.direct  = m.direct;
+        AsyncWriter w;
+        std::string err;
+        if (!w.open(path, o, &err)) { std::cout << "  " << std::left << std::setw(17) << m.name << "skip: " << err << "\n"; continue; }
+        const auto t0 = std::chrono::steady_clock::now();
+        simulate(channels, gates, [&](const TraceRec& r) { w.put(r); });
+        const double sim = since(t0);
+        const auto t1 = std::chrono::steady_clock::now();
+        const bool closed = w.close();
+        const double cl = since(t1);
+        const AsyncWriter::Stats& s = w.stats();
+        const uint32_t crc = file_crc(path);
+        std::string name = s.backend;
+        if (m.direct) name += s.direct ? "+direct" : "(no direct)";
+        row(name.c_str(), sim, cl, s.handoff_max_s, s.stall_s, s.buffers, crc);
+        if (!closed || crc != ref) { ok = false; std::cout << "    -> MISMATCH (errno " << s.error << ")\n"; }
+        std::remove(path.c_str());
+    }
+    std::cout << (ok ? "all outputs identical\n" : "output mismatch\n");
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,294 @@
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <vector>
+
+#include "closed_loop.hpp"
+#include "coeff_synth.hpp"
+
+extern "C" {
+#include "../../SW Driver/mc_regs.h"
+#include "../../SW Driver/mc_pidstate.h"
+}
+
+// ============================================================
+//  PID 이력 읽기/프리로드 (REG_HIST0..8 + REG_CTRL.FREEZE) warm restart 검증
+//  - 빌드: gcc -O2 -std=gnu99 -ffp-contract=off -DMC_HOST -c "../../SW Driver/mc_pidstate.c" -o mc_pidstate.o
+//          g++ -O2 -std=c++20 -fno-fast-math -ffp-contract=off -DMC_HOST warm_restart_check.cpp mc_pidstate.o
+//  - 사용: ./a.out [gates_per_segment=1500] [gap_gates=40]
+//  MMIO 스탠드인: 레지스터 파일 + pid_controller (FREEZE/IDLE, 이력 R/W) + 엔코더/식물
+//  + 계수 합성 (REG_SYNTH 스트로브 → CoeffSynth, 즉시 활성 뱅크 커밋).
+//  "reload" = 새 비트스트림: 레지스터/이력/활성 뱅크 0, 식물은 그대로 돌고 있음
+//  1) 무중단 실행이 DeltaClosedLoop 과 비트 동일 (스탠드인 자체 검사)
+//  2) save → reload → restore (게이트 사이): 무중단과 비트 동일 (여러 저장 시점, 포화 포함)
+//     합성 계수 (CTRL_COEF_SYNTH, REG_A0.. 는 0 인 채) 로 돌던 보드도 같은 검사
+//  3) 블롭 손상 → BAD_BLOB, frozen 아닐 때 이력 쓰기 무시, 저장 워드 == snapshot(),
+//     PS 경로 (CTRL_SW_MODE) 는 저장/복원 안 함, mc_pidstate_store/load 왕복
+//  4) cold restart (계수/목표만 다시 씀) 의 과도: max|Δy|, max|Δx|, IAE 증가
+//  5) gap_gates 동안 정지 (PWM 유지) 후 재개: warm 대 cold 비교
+// ============================================================
+
+using Rnd = RoundVolatile;
+
+static const float W_SEG[3] = { 100.0f, 60.0f, 110.0f };       // rad/s (110 은 포화 근처)
+
+// ---- MMIO 스탠드인 ----
+struct HostBoard {
+    EncoderFloor<Rnd>    enc;
+    FirstOrderPlant<Rnd> plant;
+    uint32_t      reg[64] = {};
+    uint32_t      act[9]  = {};                                // 합성 활성 뱅크 (act_c0..c7b)
+    DeltaPidState st{};                                        // pid_controller 이력 레지스터
+    float         y_out = 0.0f;                                // y_out_reg → PWM
+    std::vector<float> y, x;
+
+    HostBoard(float Ts) : enc(Ts), plant(50.0f, 5.0f, Ts) {}
+
+    bool frozen() const { return reg[REG_CTRL / 4] & CTRL_FREEZE; }   // 게이트 사이 = 항상 IDLE
+
+    // pid_top: coef_src ? 활성 뱅크 : REG_A0..C8
+    DeltaCoeffs coeffs() const {
+        const uint32_t* c = (reg[REG_CTRL / 4] & CTRL_COEF_SYNTH) ? act : reg;
+        auto f = [c](int i) { return f32_from_hex(c[i]); };
+        return { f(0), f(1), f(2), f(3), f(4), f(5), f(6), f(7), f(8) };
+    }
+
+    void synth() {
+        auto f = [this](uint32_t off) { return f32_from_hex(reg[off / 4]); };
+        const CoeffSynthResult r = CoeffSynth::run({ f(REG_KP), f(REG_KI), f(REG_KD), f(REG_N),
+                                                     f(REG_B),  f(REG_C),  f(REG_KB), f(REG_TS) });
+        if (r.err) return;
+        const float k[9] = { r.k.c0, r.k.c1, r.k.c2, r.k.c3, r.k.c4, r.k.c5, r.k.c6, r.k.c7a, r.k.c7b };
+        for (int i = 0; i < 9; ++i) act[i] = f32_to_hex(k[i]);
+    }
+
+    // 한 게이트: 정지 중이면 새 샘플을 무시하고 PWM 은 마지막 전압 유지
+    void gate() {
+        int spdcnt;
+        float x_meas;
+        x.push_back(plant.speed());
+        enc.sample(plant.speed(), spdcnt, x_meas);
+        if (!frozen()) {
+            DeltaPid2TapAw<Rnd> pid(f32_from_hex(reg[REG_YSAT / 4]), coeffs());
+            pid.restore(st);
+            y_out = pid.step(f32_from_hex(reg[REG_W_TARGET / 4]), x_meas);
+            st = pid.snapshot();
+        }
+        y.push_back(y_out);
+        plant.update(y_out);
+    }
+
+    // 새 비트스트림: PL 레지스터 전부 리셋 (식물/엔코더는 물리계라 유지)
+    void reload() {
+        std::fill(std::begin(reg), std::end(reg), 0u);
+        std::fill(std::begin(act), std::end(act), 0u);
+        st = DeltaPidState{};
+        y_out = 0.0f;
+    }
+};
+
+static HostBoard* g_board = nullptr;
+
+extern "C" uint32_t mc_host_rd32(uint32_t off) {
+    HostBoard& b = *g_board;
+    if (off == REG_PID_STATUS) return b.frozen() ? PID_STATUS_FROZEN : 0u;
+    if (off >= REG_HIST0 && off < REG_HIST(MC_HIST_WORDS)) {
+        uint32_t w[DELTA_PID_STATE_WORDS];
+        state_to_words(b.st, w);
+        return w[(off - REG_HIST0) / 4];
+    }
+    if (off >= REG_SYNTH_K0 && off < REG_SYNTH_K(9)) return b.act[(off - REG_SYNTH_K0) / 4];
+    return b.reg[off / 4];
+}
+
+extern "C" void mc_host_wr32(uint32_t off, uint32_t v) {
+    HostBoard& b = *g_board;
+    if (off >= REG_HIST0 && off < REG_HIST(MC_HIST_WORDS)) {
+        if (!b.frozen()) return;                               // RTL: frozen 일 때만 반영
+        uint32_t w[DELTA_PID_STATE_WORDS];
+        state_to_words(b.st, w);
+        const uint32_t i = (off - REG_HIST0) / 4;
+        w[i] = v;
+        b.st = state_from_words(w);
+        if (i == 7) b.y_out = f32_from_hex(v);                 // idx 7 은 y_out_reg 도 갱신
+        return;
+    }
+    if (off == REG_SYNTH) { b.synth(); return; }
+    b.reg[off / 4] = v;
+}
+
+// 앱이 부팅 때 하는 설정 (app.c 의 PS 계산 경로와 같은 레지스터)
+//  synth: 게인만 쓰고 합성 계수 사용 (REG_A0.. 는 0 그대로)
+static void program(float w, bool synth = false) {
+    if (synth) {
+        const CoeffSynthGains g = to_synth_gains(DEFAULT_GAINS, 0.005);
+        const float v[8] = { g.Kp, g.Ki, g.Kd, g.N, g.b, g.c, g.Kb, g.Ts };
+        static const uint32_t regs[8] = { REG_KP, REG_KI, REG_KD, REG_N, REG_B, REG_C, REG_KB, REG_TS };
+        for (int i = 0; i < 8; ++i) mc_wr32(regs[i], f32_to_hex(v[i]));
+        mc_wr32(REG_SYNTH, 1);
+    } else {
+        const float k[9] = { C0, C1, C2, C3, C4, C5, C6, C7A, C7B };
+        static const uint32_t regs[9] = { REG_A0, REG_C1, REG_C2, REG_C3, REG_C4, REG_C5, REG_C6, REG_C7, REG_C8 };
+        for (int i = 0; i < 9; ++i) mc_wr32(regs[i], f32_to_hex(k[i]));
+    }
+    mc_wr32(REG_YSAT,       f32_to_hex(YSAT));
+    mc_wr32(REG_RECIP_YSAT, f32_to_hex(RECIP_YSAT));
+    mc_wr32(REG_W_TARGET,   f32_to_hex(w));
+    mc_wr32(REG_CTRL,       synth ? CTRL_COEF_SYNTH : 0);
+}
+
+enum class Restart { None, Warm, Cold };
+
+// 3 구간 실행, at 게이트 직전에 (gap 만큼 정지 후) 재시작
+static HostBoard run(long seg, float Ts, Restart mode, long at, long gap, int* rc = nullptr, bool synth = false) {
+    HostBoard b(Ts);
+    g_board = &b;
+    program(W_SEG[0], synth);
+    for (long n = 0; n < 3 * seg; ++n) {
+        if (n % seg == 0) mc_wr32(REG_W_TARGET, f32_to_hex(W_SEG[n / seg]));
+        if (n == at && mode != Restart::None) {
+            mc_pidstate_t s;
+            int r = mc_pidstate_save(&s, 1);
+            for (long g = 0; g < gap; ++g) b.gate();           // 정지 상태로 게이트 통과 (PWM 유지)
+            b.reload();
+            if (mode == Restart::Warm) {
+                if (r == MC_PIDSTATE_OK) r = mc_pidstate_restore(&s);
+            } else {
+                program(f32_from_hex(s.w_target), synth);
+            }
+            if (rc) *rc = r;
+        }
+        b.gate();
+    }
+    return b;
+}
+
+struct Diff {
+    long   first = -1, bad = 0;
+    double dy = 0.0, dx = 0.0, iae_excess = 0.0;
+};
+
+// gap 이 있으면 재시작 쪽이 gap 게이트만큼 길다 → at 이후는 gap 만큼 밀어서 비교
+static Diff compare(const HostBoard& a, const HostBoard& b, long seg, float Ts, long at, long gap) {
+    Diff d;
+    for (long n = 0; n < 3 * seg; ++n) {
+        const long m = (n < at) ? n : n + gap;
+        if (f32_to_hex(a.y[n]) != f32_to_hex(b.y[m])) { if (d.first < 0) d.first = n; ++d.bad; }
+        if (n < at) continue;
+        d.dy = std::max(d.dy, (double)std::fabs(a.y[n] - b.y[m]));
+        d.dx = std::max(d.dx, (double)std::fabs(a.x[n] - b.x[m]));
+        const float w = W_SEG[n / seg];
+        d.iae_excess += (std::fabs(w - b.x[m]) - std::fabs(w - a.x[n])) * Ts;
+    }
+    return d;
+}
+
+static bool check_blob(float Ts) {
+    HostBoard b(Ts);
+    g_board = &b;
+    program(W_TGT);
+    DeltaClosedLoop<Rnd> ref(EncoderFloor<Rnd>(Ts), DeltaPid2TapAw<Rnd>(YSAT), FirstOrderPlant<Rnd>(50.0f, 5.0f, Ts));
+    for (int n = 0; n < 300; ++n) { b.gate(); ref.step(W_TGT); }
+
+    int bad = 0;
+    mc_pidstate_t s;
+    bad += mc_pidstate_save(&s, 0) != MC_PIDSTATE_OK;
+    uint32_t w[DELTA_PID_STATE_WORDS];
+    state_to_words(ref.controller().snapshot(), w);
+    for (int i = 0; i < MC_HIST_WORDS; ++i) bad += s.hist[i] != w[i];          // 워드 순서 == snapshot()
+
+    const DeltaPidState before = b.st;
+    mc_wr32(REG_HIST(0), 0x12345678u);                                          // 동작 중 쓰기는 무시
+    bad += std::memcmp(&before, &b.st, sizeof(before)) != 0;
+
+    mc_pidstate_t t = s;
+    t.hist[3] ^= 1u;                                                            // 1 비트 손상
+    bad += mc_pidstate_restore(&t) != MC_PIDSTATE_BAD_BLOB;
+    bad += b.frozen();                                                          // 거부 시 정지 안 함
+    t = s;
+    t.magic = 0;
+    bad += mc_pidstate_restore(&t) != MC_PIDSTATE_BAD_BLOB;
+
+    // PS 경로 (SW_MODE) 중 저장 → 블롭/복원 모두 FPGA PID 경로
+    mc_wr32(REG_CTRL, CTRL_SW_MODE | CTRL_MANUAL);
+    bad += mc_pidstate_save(&s, 0) != MC_PIDSTATE_OK;
+    bad += s.ctrl != CTRL_MANUAL;
+    t = s;
+    t.ctrl |= CTRL_SW_MODE;
+    t.crc = 0;
+    mc_pidstate_store(&s);
+    bad += mc_pidstate_load(&t) != MC_PIDSTATE_OK || std::memcmp(&t, &s, sizeof(s)) != 0;   // 보관 왕복
+    mc_wr32(REG_CTRL, CTRL_SW_MODE);
+    bad += mc_pidstate_restore(&t) != MC_PIDSTATE_OK;
+    bad += mc_rd32(REG_CTRL) != CTRL_MANUAL;
+    t.hist[0] ^= 1u;
+    mc_pidstate_store(&t);
+    bad += mc_pidstate_load(&t) != MC_PIDSTATE_BAD_BLOB;
+
+    std::cout << "blob: hist words == snapshot(), running-write ignored, corrupt/magic rejected,"
+                 " SW_MODE not saved/restored, store/load round trip"
+              << (bad ? "  FAIL" : "  OK") << "\n";
+    return bad == 0;
+}
+
+int main(int argc, char** argv) {
+    const long seg = (argc > 1) ? std::atol(argv[1]) : 1500;
+    const long gap = (argc > 2) ? std::atol(argv[2]) : 40;
+    const float Ts = 0.005f;
+    bool ok = true;
+
+    // 1) 스탠드인 == FPGA 모델
+    const HostBoard base = run(seg, Ts, Restart::None, -1, 0);
+    {
+        DeltaClosedLoop<Rnd> ref(EncoderFloor<Rnd>(Ts), DeltaPid2TapAw<Rnd>(YSAT), FirstOrderPlant<Rnd>(50.0f, 5.0f, Ts));
+        long bad = 0;
+        for (long n = 0; n < 3 * seg; ++n) bad += f32_to_hex(ref.step(W_SEG[n / seg]).y) != f32_to_hex(base.y[n]);
+        std::cout << "stand-in vs DeltaClosedLoop: " << 3 * seg << " gates, y mismatches " << bad
+                  << (bad ? "  FAIL" : "  OK") << "\n";
+        ok &= bad == 0;
+    }
+
+    // 2) warm restart 게이트 사이 = 무중단 (PS 계수 / 합성 계수)
+    const long points[] = { 3, 20, 80, seg / 2, seg + 5, 2 * seg + 10, 3 * seg - 1 };
+    for (bool synth : { false, true }) {
+        const HostBoard ref = synth ? run(seg, Ts, Restart::None, -1, 0, nullptr, true) : base;
+        long fails = 0;
+        for (long at : points) {
+            int rc = 0;
+            const HostBoard w = run(seg, Ts, Restart::Warm, at, 0, &rc, synth);
+            const Diff d = compare(ref, w, seg, Ts, at, 0);
+            if (rc != MC_PIDSTATE_OK || d.bad) {
+                std::cout << "  warm @" << at << ": rc " << rc << ", mismatches " << d.bad << " (first " << d.first << ")\n";
+                ++fails;
+            }
+        }
+        std::cout << "warm restart (save → reload → restore" << (synth ? ", COEF_SYNTH" : "") << ") at "
+                  << std::size(points) << " points incl. saturation: bit-identical to uninterrupted"
+                  << (fails ? "  FAIL" : "  OK") << "\n";
+        ok &= fails == 0;
+    }
+
+    ok &= check_blob(Ts);
+
+    // 4), 5) 과도 비교
+    std::cout << "\n" << std::setw(9) << "restart" << std::setw(7) << "at" << std::setw(6) << "gap"
+              << std::setw(12) << "max|dy|V" << std::setw(13) << "max|dx|r/s" << std::setw(14) << "IAE+ [rad]" << "\n";
+    for (long at : { 80L, seg / 2, seg + seg / 2 }) {
+        for (long g : { 0L, gap }) {
+            for (Restart m : { Restart::Warm, Restart::Cold }) {
+                const HostBoard r = run(seg, Ts, m, at, g);
+                const Diff d = compare(base, r, seg, Ts, at, g);
+                std::cout << std::setw(9) << (m == Restart::Warm ? "warm" : "cold") << std::setw(7) << at
+                          << std::setw(6) << g << std::fixed << std::setprecision(4)
+                          << std::setw(12) << d.dy << std::setw(13) << d.dx << std::setw(14) << d.iae_excess << "\n";
+            }
+        }
+    }
+    std::cout << "  (gap > 0: 정지 중 PWM 유지 후 재개, 비교는 gap 만큼 민 무중단 궤적 기준)\n";
+    return ok ? 0 : 1;
+}
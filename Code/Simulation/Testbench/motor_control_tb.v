@@ -89,6 +89,19 @@ module motor_control_tb;
         .c7_in           (c7a_in), .c8_in(c7b_in),
         .ysat_in         (ysat_in),
         .recip_ysat_in   (recip_ysat_in),
+        .sw_mode_in      (1'b0),
+        .y_sw_in         (32'h0),
+        .y_sw_valid_in   (1'b0),
+        .kp_in(32'h0), .ki_in(32'h0), .kd_in(32'h0), .n_in(32'h0),
+        .b_in(32'h0),  .c_in(32'h0),  .kb_in(32'h0), .ts_in(32'h0),
+        .synth_start_in  (1'b0),
+        .coef_src_in     (1'b0),
+        .freeze_in       (1'b0),
+        .hist_wr_en_in   (1'b0),
+        .hist_wr_idx_in  (4'd0),
+        .hist_wr_data_in (32'h0),
+        .manual_in       (1'b0),
+        .y_man_in        (32'h0),
         .rpwm            (rpwm),
         .lpwm            (lpwm),
         .r_en            (r_en),
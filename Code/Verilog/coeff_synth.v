@@ -0,0 +1,288 @@
+`timescale 1ns / 1ps
+
+// ============================================================
+//  물리 게인 → Δ-form 계수 합성 (c0..c7b)
+//  - start_in 에서 Kp, Ki, Kd, N, b, c, Kb, Ts 를 래치하고 ROM 의 op 를
+//    하나씩 FMA(a*b±c) / 나눗셈 / 비교 IP 에 넣어 레지스터 파일에서 계산
+//  - 끝나면 9개 계수를 섀도 뱅크(c*_out)에 한 사이클에 갱신 + done_out 펄스
+//  - Kp, N, Ts 가 0 이하(또는 NaN)면 err_out=1, 섀도 뱅크는 그대로
+//  - ROM 순서/라운딩은 C++ Model/coeff_synth.hpp (COEFF_SYNTH_ROM) 와 동일
+// ============================================================
+module coeff_synth (
+    input  wire         aclk,
+    input  wire         rst_n,
+
+    input  wire         start_in,      // 1사이클 스트로브 (busy 중에는 무시)
+    input  wire [31:0]  kp_in, ki_in, kd_in, n_in,
+    input  wire [31:0]  b_in,  c_in,  kb_in, ts_in,
+
+    // 섀도 뱅크
+    output reg  [31:0]  c0_out,
+    output reg  [31:0]  c1_out, c2_out, c3_out,
+    output reg  [31:0]  c4_out, c5_out, c6_out,
+    output reg  [31:0]  c7a_out, c7b_out,
+
+    output wire         busy,
+    output reg          done_out,      // 1사이클 (err 여도 발생)
+    output reg          err_out        // done_out 과 함께 갱신, 다음 done 까지 유지
+);
+
+    // --- FSM 상태 ---
+    localparam S_IDLE      = 3'd0;
+    localparam S_ISSUE     = 3'd1;
+    localparam S_FMA_WAIT  = 3'd2;
+    localparam S_DIV_WAIT  = 3'd3;
+    localparam S_CMP_WAIT  = 3'd4;
+    localparam S_NEXT      = 3'd5;
+    localparam S_DONE      = 3'd6;
+
+    reg [2:0] state, next_state;
+
+    // --- op 종류 ---
+    localparam [1:0] K_FMA = 2'd0;   // dst = a*b + c
+    localparam [1:0] K_FMS = 2'd1;   // dst = a*b - c
+    localparam [1:0] K_DIV = 2'd2;   // dst = a / b
+    localparam [1:0] K_CHK = 2'd3;   // err |= !(a > 0)
+
+    // --- 레지스터 파일 번호 ---
+    localparam [4:0] R_ZERO = 5'd0,  R_ONE = 5'd1,  R_TWO = 5'd2;
+    localparam [4:0] R_KP   = 5'd3,  R_KI  = 5'd4,  R_KD  = 5'd5,  R_N   = 5'd6;
+    localparam [4:0] R_B    = 5'd7,  R_C   = 5'd8,  R_KB  = 5'd9,  R_TS  = 5'd10;
+    localparam [4:0] R_C0   = 5'd11, R_C1  = 5'd12, R_C2  = 5'd13, R_C3  = 5'd14;
+    localparam [4:0] R_C4   = 5'd15, R_C5  = 5'd16, R_C6  = 5'd17, R_C7A = 5'd18, R_C7B = 5'd19;
+    localparam [4:0] R_IN   = 5'd20;  // 1/N
+    localparam [4:0] R_KDN  = 5'd21;  // Kd/N
+    localparam [4:0] R_ATD  = 5'd22;  // a*Td = (Kd/N)/Kp
+    localparam [4:0] R_DEN  = 5'd23;  // Ts + a*Td
+    localparam [4:0] R_R    = 5'd24;  // 1/den
+    localparam [4:0] R_NR   = 5'd25;  // -1/den
+    localparam [4:0] R_TSKI = 5'd26;  // Ts*Ki
+    localparam [4:0] R_KDC  = 5'd27;  // Kd*c
+    localparam [4:0] R_U    = 5'd28,  R_KPB = 5'd29, R_V = 5'd30, R_W = 5'd31;
+
+    localparam [5:0] N_OPS = 6'd38;
+
+    // Xilinx FP FMA core: 0x00 (a*b + c), 0x01 (a*b - c)
+    localparam OP_FMA = 8'h00;
+    localparam OP_SUB = 8'h01;
+    localparam COND_GT = 8'h04;
+
+    localparam [31:0] FP_ZERO = 32'h00000000;
+    localparam [31:0] FP_ONE  = 32'h3F800000;
+    localparam [31:0] FP_TWO  = 32'h40000000;
+
+    // --- ROM: {kind, dst, a, b, c} ---
+    function [21:0] rom;
+        input [5:0] pc;
+        case (pc)
+            6'd0:  rom = {K_CHK, R_ZERO, R_KP,   R_ZERO, R_ZERO};
+            6'd1:  rom = {K_CHK, R_ZERO, R_N,    R_ZERO, R_ZERO};
+            6'd2:  rom = {K_CHK, R_ZERO, R_TS,   R_ZERO, R_ZERO};
+            // 공통 항
+            6'd3:  rom = {K_DIV, R_IN,   R_ONE,  R_N,    R_ZERO};   // 1/N
+            6'd4:  rom = {K_FMA, R_KDN,  R_KD,   R_IN,   R_ZERO};   // Kd/N
+            6'd5:  rom = {K_DIV, R_ATD,  R_KDN,  R_KP,   R_ZERO};   // aTd
+            6'd6:  rom = {K_FMA, R_DEN,  R_ATD,  R_ONE,  R_TS  };   // Ts + aTd
+            6'd7:  rom = {K_DIV, R_R,    R_ONE,  R_DEN,  R_ZERO};   // r
+            6'd8:  rom = {K_FMS, R_NR,   R_ZERO, R_ZERO, R_R   };   // -r
+            6'd9:  rom = {K_FMA, R_TSKI, R_TS,   R_KI,   R_ZERO};
+            6'd10: rom = {K_FMA, R_KDC,  R_KD,   R_C,    R_ZERO};
+            // c0 = aTd*r
+            6'd11: rom = {K_FMA, R_C0,   R_ATD,  R_R,    R_ZERO};
+            // c1 = Kp*b + (Kd*c*r + Ts*Ki)
+            6'd12: rom = {K_FMA, R_U,    R_KDC,  R_R,    R_TSKI};
+            6'd13: rom = {K_FMA, R_C1,   R_KP,   R_B,    R_U   };
+            // c2 = -(Kp*b*(Ts + 2aTd) + aTd*Ts*Ki + 2*Kd*c)*r
+            6'd14: rom = {K_FMA, R_U,    R_ATD,  R_TWO,  R_TS  };
+            6'd15: rom = {K_FMA, R_KPB,  R_KP,   R_B,    R_ZERO};
+            6'd16: rom = {K_FMA, R_V,    R_KPB,  R_U,    R_ZERO};
+            6'd17: rom = {K_FMA, R_V,    R_ATD,  R_TSKI, R_V   };
+            6'd18: rom = {K_FMA, R_V,    R_KDC,  R_TWO,  R_V   };
+            6'd19: rom = {K_FMA, R_C2,   R_V,    R_NR,   R_ZERO};
+            // c3 = Kd*(b/N + c)*r
+            6'd20: rom = {K_FMA, R_U,    R_B,    R_IN,   R_C   };
+            6'd21: rom = {K_FMA, R_U,    R_KD,   R_U,    R_ZERO};
+            6'd22: rom = {K_FMA, R_C3,   R_U,    R_R,    R_ZERO};
+            // c4 = -(Kp + Ts*Ki + Kd*r)
+            6'd23: rom = {K_FMA, R_W,    R_KD,   R_R,    R_KP  };
+            6'd24: rom = {K_FMA, R_W,    R_ONE,  R_TSKI, R_W   };
+            6'd25: rom = {K_FMS, R_C4,   R_ZERO, R_ZERO, R_W   };
+            // c5 = (Kp*Ts + 2*Kd/N + aTd*Ts*Ki + 2*Kd)*r
+            6'd26: rom = {K_FMA, R_W,    R_KP,   R_TS,   R_ZERO};
+            6'd27: rom = {K_FMA, R_W,    R_KDN,  R_TWO,  R_W   };
+            6'd28: rom = {K_FMA, R_W,    R_ATD,  R_TSKI, R_W   };
+            6'd29: rom = {K_FMA, R_W,    R_KD,   R_TWO,  R_W   };
+            6'd30: rom = {K_FMA, R_C5,   R_W,    R_R,    R_ZERO};
+            // c6 = -Kd*(1/N + 1)*r
+            6'd31: rom = {K_FMA, R_W,    R_IN,   R_ONE,  R_ONE };
+            6'd32: rom = {K_FMA, R_W,    R_KD,   R_W,    R_ZERO};
+            6'd33: rom = {K_FMA, R_C6,   R_W,    R_NR,   R_ZERO};
+            // c7a = Ki*Kb*Ts, c7b = -c7a*c0
+            6'd34: rom = {K_FMA, R_W,    R_KI,   R_KB,   R_ZERO};
+            6'd35: rom = {K_FMA, R_C7A,  R_W,    R_TS,   R_ZERO};
+            6'd36: rom = {K_FMA, R_W,    R_C7A,  R_C0,   R_ZERO};
+            6'd37: rom = {K_FMS, R_C7B,  R_ZERO, R_ZERO, R_W   };
+            default: rom = {K_CHK, R_ZERO, R_ONE, R_ZERO, R_ZERO};
+        endcase
+    endfunction
+
+    // --- 레지스터 파일 / 현재 op ---
+    reg  [31:0] rf [0:31];
+    reg  [5:0]  pc;
+    reg         err;
+
+    wire [21:0] op      = rom(pc);
+    wire [1:0]  op_kind = op[21:20];
+    wire [4:0]  op_dst  = op[19:15];
+    wire [31:0] op_a    = rf[op[14:10]];
+    wire [31:0] op_b    = rf[op[9:5]];
+    wire [31:0] op_c    = rf[op[4:0]];
+    wire [21:0] op_next = rom(pc + 6'd1);
+
+    // --- AXI-Stream 신호 ---
+    wire s_fma_a_tready, s_fma_b_tready, s_fma_c_tready, s_fma_op_tready, m_fma_result_tvalid;
+    wire [31:0] m_fma_result_tdata;
+    reg  s_fma_a_tvalid, s_fma_b_tvalid, s_fma_c_tvalid, s_fma_op_tvalid, m_fma_result_tready;
+    reg  [7:0]  s_fma_op_tdata;
+
+    wire s_div_a_tready, s_div_b_tready, m_div_result_tvalid;
+    wire [31:0] m_div_result_tdata;
+    reg  s_div_a_tvalid, s_div_b_tvalid, m_div_result_tready;
+
+    wire s_comp_a_tready, s_comp_b_tready, m_comp_result_tvalid;
+    wire [7:0] m_comp_result_tdata;
+    reg  s_comp_a_tvalid, s_comp_b_tvalid, m_comp_result_tready;
+
+    // ============================================================
+    // 1) 순차 로직
+    // ============================================================
+    integer i;
+    always @(posedge aclk or negedge rst_n) begin
+        if (!rst_n) begin
+            state <= S_IDLE;
+            pc <= 6'd0; err <= 1'b0;
+            done_out <= 1'b0; err_out <= 1'b0;
+            for (i = 0; i < 32; i = i + 1) rf[i] <= FP_ZERO;
+            rf[R_ONE] <= FP_ONE;
+            rf[R_TWO] <= FP_TWO;
+            c0_out <= 32'h0; c1_out <= 32'h0; c2_out <= 32'h0; c3_out <= 32'h0;
+            c4_out <= 32'h0; c5_out <= 32'h0; c6_out <= 32'h0; c7a_out <= 32'h0; c7b_out <= 32'h0;
+        end else begin
+            state    <= next_state;
+            done_out <= 1'b0;
+
+            // 입력 래치 (합성 중 게인이 바뀌어도 이번 결과에는 영향 없음)
+            if (state == S_IDLE && start_in) begin
+                rf[R_KP] <= kp_in; rf[R_KI] <= ki_in; rf[R_KD] <= kd_in; rf[R_N]  <= n_in;
+                rf[R_B]  <= b_in;  rf[R_C]  <= c_in;  rf[R_KB] <= kb_in; rf[R_TS] <= ts_in;
+                pc  <= 6'd0;
+                err <= 1'b0;
+            end
+
+            // 결과 래치
+            if (state == S_FMA_WAIT && m_fma_result_tvalid) rf[op_dst] <= m_fma_result_tdata;
+            if (state == S_DIV_WAIT && m_div_result_tvalid) rf[op_dst] <= m_div_result_tdata;
+            if (state == S_CMP_WAIT && m_comp_result_tvalid && m_comp_result_tdata != COND_GT) err <= 1'b1;
+
+            if (state == S_NEXT) pc <= pc + 6'd1;
+
+            // 섀도 뱅크 갱신
+            if (state == S_DONE) begin
+                done_out <= 1'b1;
+                err_out  <= err;
+                if (!err) begin
+                    c0_out  <= rf[R_C0];
+                    c1_out  <= rf[R_C1];  c2_out <= rf[R_C2];  c3_out <= rf[R_C3];
+                    c4_out  <= rf[R_C4];  c5_out <= rf[R_C5];  c6_out <= rf[R_C6];
+                    c7a_out <= rf[R_C7A]; c7b_out <= rf[R_C7B];
+                end
+            end
+        end
+    end
+
+    // ============================================================
+    // 2) 조합 로직 (상태/핸드셰이크)
+    // ============================================================
+    always @* begin
+        next_state = state;
+
+        s_fma_a_tvalid=0; s_fma_b_tvalid=0; s_fma_c_tvalid=0; s_fma_op_tvalid=0; m_fma_result_tready=0;
+        s_div_a_tvalid=0; s_div_b_tvalid=0; m_div_result_tready=0;
+        s_comp_a_tvalid=0; s_comp_b_tvalid=0; m_comp_result_tready=0;
+        s_fma_op_tdata = (op_kind == K_FMS) ? OP_SUB : OP_FMA;
+
+        case (state)
+            S_IDLE: if (start_in) next_state = S_ISSUE;
+
+            S_ISSUE: begin
+                case (op_kind)
+                    K_FMA, K_FMS: begin
+                        s_fma_op_tvalid = 1'b1;
+                        s_fma_a_tvalid = 1'b1; s_fma_b_tvalid = 1'b1; s_fma_c_tvalid = 1'b1;
+                        if (s_fma_a_tready && s_fma_b_tready && s_fma_c_tready && s_fma_op_tready) next_state = S_FMA_WAIT;
+                    end
+                    K_DIV: begin
+                        s_div_a_tvalid = 1'b1; s_div_b_tvalid = 1'b1;
+                        if (s_div_a_tready && s_div_b_tready) next_state = S_DIV_WAIT;
+                    end
+                    default: begin
+                        s_comp_a_tvalid = 1'b1; s_comp_b_tvalid = 1'b1;
+                        if (s_comp_a_tready && s_comp_b_tready) next_state = S_CMP_WAIT;
+                    end
+                endcase
+            end
+
+            S_FMA_WAIT: begin
+                m_fma_result_tready = 1'b1;
+                if (m_fma_result_tvalid) next_state = S_NEXT;
+            end
+            S_DIV_WAIT: begin
+                m_div_result_tready = 1'b1;
+                if (m_div_result_tvalid) next_state = S_NEXT;
+            end
+            S_CMP_WAIT: begin
+                m_comp_result_tready = 1'b1;
+                if (m_comp_result_tvalid) next_state = S_NEXT;
+            end
+
+            // 마지막 op 이거나, 검사 실패 후 첫 계산 op 앞이면 종료
+            S_NEXT: begin
+                if (pc == N_OPS - 6'd1 || (err && op_next[21:20] != K_CHK)) next_state = S_DONE;
+                else next_state = S_ISSUE;
+            end
+
+            S_DONE: next_state = S_IDLE;
+
+            default: next_state = S_IDLE;
+        endcase
+    end
+
+    assign busy = (state != S_IDLE);
+
+    // --- IP Inst ---
+    floating_point_0 fma_ip (
+        .aclk(aclk),
+        .s_axis_a_tvalid(s_fma_a_tvalid), .s_axis_a_tready(s_fma_a_tready), .s_axis_a_tdata(op_a),
+        .s_axis_b_tvalid(s_fma_b_tvalid), .s_axis_b_tready(s_fma_b_tready), .s_axis_b_tdata(op_b),
+        .s_axis_c_tvalid(s_fma_c_tvalid), .s_axis_c_tready(s_fma_c_tready), .s_axis_c_tdata(op_c),
+        .s_axis_operation_tvalid(s_fma_op_tvalid), .s_axis_operation_tready(s_fma_op_tready), .s_axis_operation_tdata(s_fma_op_tdata),
+        .m_axis_result_tvalid(m_fma_result_tvalid), .m_axis_result_tready(m_fma_result_tready), .m_axis_result_tdata(m_fma_result_tdata)
+    );
+
+    // a / b (Floating-Point IP, Divide, RNE)
+    floating_point_5 div_ip (
+        .aclk(aclk),
+        .s_axis_a_tvalid(s_div_a_tvalid), .s_axis_a_tready(s_div_a_tready), .s_axis_a_tdata(op_a),
+        .s_axis_b_tvalid(s_div_b_tvalid), .s_axis_b_tready(s_div_b_tready), .s_axis_b_tdata(op_b),
+        .m_axis_result_tvalid(m_div_result_tvalid), .m_axis_result_tready(m_div_result_tready), .m_axis_result_tdata(m_div_result_tdata)
+    );
+
+    // a > 0 (Kp, N, Ts 검사)
+    floating_point_1 comp_ip (
+        .aclk(aclk),
+        .s_axis_a_tvalid(s_comp_a_tvalid), .s_axis_a_tready(s_comp_a_tready), .s_axis_a_tdata(op_a),
+        .s_axis_b_tvalid(s_comp_b_tvalid), .s_axis_b_tready(s_comp_b_tready), .s_axis_b_tdata(FP_ZERO),
+        .m_axis_result_tvalid(m_comp_result_tvalid), .m_axis_result_tready(m_comp_result_tready), .m_axis_result_tdata(m_comp_result_tdata)
+    );
+
+endmodule
@@ -20,6 +20,26 @@ module pid_controller_axi #(
     // 포화 한계
     input  wire [31:0]  ysat_in,
 
+    // === 이력 읽기/프리로드 (warm restart) ===
+    //  freeze_in=1 이면 새 data_valid 를 받지 않음 (진행 중 계산은 마저 끝냄)
+    //  hist_wr_en_in 은 frozen(=freeze_in && IDLE) 일 때만 반영
+    //  순서는 C++ DeltaPidState 와 동일
+    //   0 dy[n-1]  1 w[n-1]  2 w[n-2]  3 x[n-1]  4 x[n-2]
+    //   5 y_unsat[n-1]  6 y_unsat[n-2]  7 y_sat[n-1]  8 y_sat[n-2]
+    input  wire         freeze_in,
+    input  wire         hist_wr_en_in,
+    input  wire [3:0]   hist_wr_idx_in,
+    input  wire [31:0]  hist_wr_data_in,
+    output wire [287:0] hist_out,        // {8, 7, ..., 0}
+    output wire         frozen,
+
+    // === 수동/자동 (bumpless) ===
+    //  manual_in=1 이면 출력 = clamp(y_man_in). Δy MAC 경로는 그대로 돌고
+    //  y[n-1], y_sat[n-1] 이력은 실제 출력을 추종 → 자동 복귀 시 y = y_man + Δy
+    //  두 값 모두 게이트 입력 래치에서 샘플 (계산 중 변경 무시)
+    input  wire         manual_in,
+    input  wire [31:0]  y_man_in,
+
     output wire [31:0]  y_out,
     output wire         busy,
     output wire         out_valid
@@ -75,6 +95,10 @@ module pid_controller_axi #(
     // 포화 출력 이력(2-tap AW용)
     reg  [31:0] y_sat_d1, y_sat_d2;
 
+    // 수동 모드 (게이트 단위 래치)
+    reg         man_reg;
+    reg  [31:0] y_man_reg;
+
     // Comparator(출력 포화 판단용)
     reg  [7:0]  comp_gt_code, comp_lt_code;
 
@@ -108,13 +132,16 @@ module pid_controller_axi #(
             sum_mac <= 32'h0; sub_result <= 32'h0; delta_y <= 32'h0; y_n <= 32'h0;
             comp_gt_code <= 8'h0; comp_lt_code <= 8'h0;
             x_spdcnt_reg <= 16'd0;
+            man_reg <= 1'b0; y_man_reg <= 32'h0;
         end else begin
             state <= next_state;
 
             // 입력 래치
-            if (state == S_IDLE && data_valid_in) begin
+            if (state == S_IDLE && data_valid_in && !freeze_in) begin
                 x_spdcnt_reg <= x_spdcnt_in;
                 w_n_fp       <= w_target_fp_in;
+                man_reg      <= manual_in;
+                y_man_reg    <= y_man_in;
             end
 
             // int->float 결과
@@ -165,13 +192,29 @@ module pid_controller_axi #(
                     y_out_reg <= y_n;
             end
 
+            // 이력 프리로드 (frozen 일 때만). y_sat[n-1] 은 출력 레지스터도 같이
+            if (state == S_IDLE && freeze_in && hist_wr_en_in) begin
+                case (hist_wr_idx_in)
+                    4'd0: delta_y_d1 <= hist_wr_data_in;
+                    4'd1: w_d1       <= hist_wr_data_in;
+                    4'd2: w_d2       <= hist_wr_data_in;
+                    4'd3: x_d1       <= hist_wr_data_in;
+                    4'd4: x_d2       <= hist_wr_data_in;
+                    4'd5: y_d1       <= hist_wr_data_in;
+                    4'd6: y_d2       <= hist_wr_data_in;
+                    4'd7: begin y_sat_d1 <= hist_wr_data_in; y_out_reg <= hist_wr_data_in; end
+                    4'd8: y_sat_d2   <= hist_wr_data_in;
+                    default: ;
+                endcase
+            end
+
             // 파이프/지연 레지스터 업데이트
             if (state == S_UPDATE) begin
                 delta_y_d1 <= delta_y;
                 w_d2 <= w_d1;       w_d1 <= w_n_fp;
                 x_d2 <= x_d1;       x_d1 <= x_n_fp;
                 y_d2 <= y_d1;      // ★ 추가: y[n-2] <= y[n-1]
-                y_d1 <= y_n;       // 비포화 y[n] 저장 (AW back-calc용)
+                y_d1 <= man_reg ? y_out_reg : y_n;   // 비포화 y[n] 저장 (AW back-calc용), 수동이면 실제 출력
                 y_sat_d2 <= y_sat_d1;             // 포화 출력 이력
                 y_sat_d1 <= y_out_reg;            // 포화 y[n]
             end
@@ -192,7 +235,7 @@ module pid_controller_axi #(
         s_i2f_tdata=0; s_fma_a_tdata=0; s_fma_b_tdata=0; s_fma_c_tdata=0; s_fma_op_tdata=0; s_comp_a_tdata=0; s_comp_b_tdata=0;
         
         case (state)
-            S_IDLE: if (data_valid_in) next_state = S_LATCH_INPUTS;
+            S_IDLE: if (data_valid_in && !freeze_in) next_state = S_LATCH_INPUTS;
 
             S_LATCH_INPUTS: next_state = S_X_CONV_SETUP;
 
@@ -362,12 +405,12 @@ module pid_controller_axi #(
                 if (m_fma_result_tvalid) next_state = S_ADD_Y_SETUP;
             end
 
-            // y_n = y[n-1] + delta_y
+            // y_n = y[n-1] + delta_y  (수동: y_n = y_man + 0, 포화 체크는 공용)
             S_ADD_Y_SETUP: begin
                 s_fma_op_tvalid = 1'b1; s_fma_op_tdata = OP_FMA;
                 s_fma_a_tvalid = 1'b1;  s_fma_a_tdata = FP_ONE;
-                s_fma_b_tvalid = 1'b1;  s_fma_b_tdata = y_d1;
-                s_fma_c_tvalid = 1'b1;  s_fma_c_tdata = delta_y;
+                s_fma_b_tvalid = 1'b1;  s_fma_b_tdata = man_reg ? y_man_reg : y_d1;
+                s_fma_c_tvalid = 1'b1;  s_fma_c_tdata = man_reg ? FP_ZERO   : delta_y;
                 if (s_fma_a_tready && s_fma_b_tready && s_fma_c_tready && s_fma_op_tready) next_state = S_ADD_Y_WAIT;
             end
             S_ADD_Y_WAIT: begin
@@ -411,6 +454,8 @@ module pid_controller_axi #(
     assign y_out     = y_out_reg;
     assign out_valid = (state == S_UPDATE) ? 1'b1 : 1'b0;
     assign busy      = (state != S_IDLE);
+    assign frozen    = freeze_in && (state == S_IDLE);
+    assign hist_out  = { y_sat_d2, y_sat_d1, y_d2, y_d1, x_d2, x_d1, w_d2, w_d1, delta_y_d1 };
 
     // --- IP Inst ---
     floating_point_0 fma_ip (
@@ -29,12 +29,47 @@ module motor_control_top #(
     //  (pwm_generator가 런타임 입력으로 역수 사용한다고 가정)
     input  wire [31:0] recip_ysat_in,        // 예: (1/12) = 0x3DAAAAAB
 
+    // === PS 소프트웨어 제어 경로 (REG_CTRL bit0, REG_Y_SW) ===
+    //  sw_mode_in=1 이면 PWM 입력을 PID 코어 대신 PS 가 쓴 전압으로
+    //  y_sw_valid_in : REG_Y_SW 쓰기 스트로브 (1사이클)
+    input  wire        sw_mode_in,
+    input  wire [31:0] y_sw_in,
+    input  wire        y_sw_valid_in,
+
+    // === 계수 합성 (coeff_synth): 물리 게인 → c0..c7b ===
+    //  synth_start_in : 1사이클 스트로브 (합성 중/커밋 대기 중에는 무시)
+    //  coef_src_in    : 0 = 위 a0_in..c8_in (기존), 1 = 합성 활성 뱅크
+    input  wire [31:0] kp_in, ki_in, kd_in, n_in,
+    input  wire [31:0] b_in,  c_in,  kb_in, ts_in,
+    input  wire        synth_start_in,
+    input  wire        coef_src_in,
+
+    // === 이력 읽기/프리로드 (warm restart, REG_CTRL bit2 / REG_HIST0..8) ===
+    input  wire        freeze_in,
+    input  wire        hist_wr_en_in,         // REG_HIST(i) 쓰기 스트로브
+    input  wire [3:0]  hist_wr_idx_in,
+    input  wire [31:0] hist_wr_data_in,
+
+    // === 수동/자동 (REG_CTRL bit3, REG_Y_MAN) ===
+    input  wire        manual_in,
+    input  wire [31:0] y_man_in,
+
     // 드라이버 인터페이스
     output wire rpwm,   // RPWM
     output wire lpwm,   // LPWM
     output wire r_en,   // R_EN (active-high)
     output wire l_en,    // L_EN (active-high)
-    output wire [31:0] spdcnt_32bit
+    output wire [31:0] spdcnt_32bit,         // {gate_seq[15:0], spdcnt[15:0]}
+
+    // {commit_cnt[15:0], 13'b0, err, pending, busy}
+    output wire [31:0] synth_status_out,
+    // 합성 활성 뱅크 읽기 {c7b, c7a, c6, ..., c1, c0}
+    output wire [287:0] synth_coef_out,
+
+    // {30'b0, frozen, busy}
+    output wire [31:0]  pid_status_out,
+    // 이력 읽기 {y_sat[n-2], y_sat[n-1], y_unsat[n-2], y_unsat[n-1], x[n-2], x[n-1], w[n-2], w[n-1], dy[n-1]}
+    output wire [287:0] pid_hist_out
 );
     // ---------------- Encoder ----------------
     
@@ -44,7 +79,14 @@ module motor_control_top #(
     wire enc_dir;
     wire [15:0] enc_err_illegal;
     
-    assign spdcnt_32bit = {{16{spdcnt[15]}},spdcnt };
+    // 상위 16비트 = 게이트 순번 (delta_valid 마다 +1)
+    //  PS 경로가 한 번의 읽기로 "새 샘플인지"와 spdcnt 를 함께 얻도록
+    reg [15:0] gate_seq;
+    always @(posedge aclk or negedge rst_n) begin
+        if (!rst_n)           gate_seq <= 16'd0;
+        else if (delta_valid) gate_seq <= gate_seq + 16'd1;
+    end
+    assign spdcnt_32bit = { gate_seq, spdcnt };
     
 
     enc_pulse #(
@@ -69,6 +111,52 @@ module motor_control_top #(
     wire [31:0] y_out;
     wire        out_valid;
     wire        busy;
+    wire        pid_frozen;
+
+    // ---------------- 계수 합성 ----------------
+    //  coeff_synth 결과(섀도 뱅크) → PID 코어가 쉬는(!busy) 사이클에 활성 뱅크로 9개 동시 교체
+    //  PID FSM 은 IDLE 이후 MAC 단계에서야 계수를 읽으므로 게이트 중간에 섞이지 않는다
+    wire [31:0] syn_c0, syn_c1, syn_c2, syn_c3, syn_c4, syn_c5, syn_c6, syn_c7a, syn_c7b;
+    wire        syn_busy, syn_done, syn_err;
+    reg  [31:0] act_c0, act_c1, act_c2, act_c3, act_c4, act_c5, act_c6, act_c7a, act_c7b;
+    reg         syn_pending;
+    reg  [15:0] syn_commit_cnt;
+
+    coeff_synth u_synth (
+        .aclk     (aclk),
+        .rst_n    (rst_n),
+        .start_in (synth_start_in && !syn_pending),
+        .kp_in(kp_in), .ki_in(ki_in), .kd_in(kd_in), .n_in(n_in),
+        .b_in(b_in),   .c_in(c_in),   .kb_in(kb_in), .ts_in(ts_in),
+        .c0_out(syn_c0),
+        .c1_out(syn_c1), .c2_out(syn_c2), .c3_out(syn_c3),
+        .c4_out(syn_c4), .c5_out(syn_c5), .c6_out(syn_c6),
+        .c7a_out(syn_c7a), .c7b_out(syn_c7b),
+        .busy     (syn_busy),
+        .done_out (syn_done),
+        .err_out  (syn_err)
+    );
+
+    always @(posedge aclk or negedge rst_n) begin
+        if (!rst_n) begin
+            syn_pending    <= 1'b0;
+            syn_commit_cnt <= 16'd0;
+            act_c0 <= 32'h0; act_c1 <= 32'h0; act_c2 <= 32'h0; act_c3 <= 32'h0; act_c4 <= 32'h0;
+            act_c5 <= 32'h0; act_c6 <= 32'h0; act_c7a <= 32'h0; act_c7b <= 32'h0;
+        end else if (syn_done) begin
+            syn_pending <= !syn_err;
+        end else if (syn_pending && !busy) begin
+            act_c0 <= syn_c0;
+            act_c1 <= syn_c1; act_c2 <= syn_c2; act_c3 <= syn_c3;
+            act_c4 <= syn_c4; act_c5 <= syn_c5; act_c6 <= syn_c6;
+            act_c7a <= syn_c7a; act_c7b <= syn_c7b;
+            syn_pending    <= 1'b0;
+            syn_commit_cnt <= syn_commit_cnt + 16'd1;
+        end
+    end
+
+    assign synth_status_out = { syn_commit_cnt, 13'd0, syn_err, syn_pending, syn_busy };
+    assign synth_coef_out   = { act_c7b, act_c7a, act_c6, act_c5, act_c4, act_c3, act_c2, act_c1, act_c0 };
 
     pid_controller_axi #(
         .INT_TO_RADS_FACTOR (INT_TO_RADS_FACTOR)
@@ -80,17 +168,35 @@ module motor_control_top #(
         .data_valid_in (delta_valid),
 
         // ★ 상위 입력 계수/포화 값 전달
-        .a0_in(a0_in),
-        .c1_in(c1_in), .c2_in(c2_in), .c3_in(c3_in),
-        .c4_in(c4_in), .c5_in(c5_in), .c6_in(c6_in), .c7a_in(c7_in), .c7b_in(c8_in),
+        .a0_in (coef_src_in ? act_c0  : a0_in),
+        .c1_in (coef_src_in ? act_c1  : c1_in),
+        .c2_in (coef_src_in ? act_c2  : c2_in),
+        .c3_in (coef_src_in ? act_c3  : c3_in),
+        .c4_in (coef_src_in ? act_c4  : c4_in),
+        .c5_in (coef_src_in ? act_c5  : c5_in),
+        .c6_in (coef_src_in ? act_c6  : c6_in),
+        .c7a_in(coef_src_in ? act_c7a : c7_in),
+        .c7b_in(coef_src_in ? act_c7b : c8_in),
         .ysat_in(ysat_in),
 
+        .freeze_in      (freeze_in),
+        .hist_wr_en_in  (hist_wr_en_in),
+        .hist_wr_idx_in (hist_wr_idx_in),
+        .hist_wr_data_in(hist_wr_data_in),
+        .hist_out       (pid_hist_out),
+        .frozen         (pid_frozen),
+        .manual_in      (manual_in),
+        .y_man_in       (y_man_in),
+
         .y_out   (y_out),
         .busy    (busy),
         .out_valid(out_valid)
     );
 
 
+    assign pid_status_out = { 30'd0, pid_frozen, busy };
+
+
     // ---------------- PWM ----------------
     // 주의: pwm_generator가 런타임 입력으로 역수(rec 1/YSAT)를 받는 개정형이라고 가정
     
@@ -102,8 +208,8 @@ module motor_control_top #(
     ) u_pwm (
         .aclk                 (aclk),
         .rst_n                (rst_n),
-        .voltage_in           (y_out),          // FP32, ±YSAT
-        .voltage_valid        (out_valid),      // PID 결과 갱신 시 반영
+        .voltage_in           (sw_mode_in ? y_sw_in       : y_out),      // FP32, ±YSAT
+        .voltage_valid        (sw_mode_in ? y_sw_valid_in : out_valid),  // 결과 갱신 시 반영
         .recip_max_voltage_fp (recip_ysat_in),  // = 1/YSAT
         .pwm_out              (pwm_core),
         .dir_out              (dir_core)